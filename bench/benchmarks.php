@@ -0,0 +1,144 @@
+<?php
+/*
+ * Benchmarks run by bench/run.php.
+ *
+ * Every entry is a setup function that receives the screen size and
+ * returns the function to time. That function does $n operations and is
+ * called with growing $n until the time budget is used up. Anything left
+ * to clean up goes into the optional 'teardown' closure.
+ */
+
+return array(
+	/* one string per call, cycling over the rows of a full screen window */
+	'mvwaddstr' => function ($rows, $cols) {
+		$win  = ncurses_newwin($rows, $cols, 0, 0);
+		$text = str_repeat('x', $cols - 1);
+
+		return array(
+			'run' => function ($n) use ($win, $rows, $text) {
+				for ($i = 0; $i < $n; $i++) {
+					ncurses_mvwaddstr($win, $i % $rows, 0, $text);
+				}
+			},
+			'teardown' => function () use ($win) {
+				ncurses_delwin($win);
+			},
+		);
+	},
+
+	/* one character per call, restarting at the origin once the window is full */
+	'waddch' => function ($rows, $cols) {
+		$win  = ncurses_newwin($rows, $cols, 0, 0);
+		$size = $rows * $cols - 1;
+
+		return array(
+			'run' => function ($n) use ($win, $size) {
+				for ($i = 0; $i < $n; $i++) {
+					if ($i % $size == 0) {
+						ncurses_wmove($win, 0, 0);
+					}
+					ncurses_waddch($win, 0x41 + $i % 26);
+				}
+			},
+			'teardown' => function () use ($win) {
+				ncurses_delwin($win);
+			},
+		);
+	},
+
+	/* refresh with a single changed line, the common case of a status update */
+	'wrefresh' => function ($rows, $cols) {
+		$win   = ncurses_newwin($rows, $cols, 0, 0);
+		$lines = array(str_repeat('a', $cols - 1), str_repeat('b', $cols - 1));
+
+		return array(
+			'run' => function ($n) use ($win, $rows, $lines) {
+				for ($i = 0; $i < $n; $i++) {
+					ncurses_mvwaddstr($win, $i % $rows, 0, $lines[$i & 1]);
+					ncurses_wrefresh($win);
+				}
+			},
+			'teardown' => function () use ($win) {
+				ncurses_delwin($win);
+			},
+		);
+	},
+
+	/* refresh after every line of the window changed, one op is one frame */
+	'wrefresh_full' => function ($rows, $cols) {
+		$win   = ncurses_newwin($rows, $cols, 0, 0);
+		$lines = array(str_repeat('a', $cols - 1), str_repeat('b', $cols - 1));
+
+		return array(
+			'run' => function ($n) use ($win, $rows, $lines) {
+				for ($i = 0; $i < $n; $i++) {
+					$line = $lines[$i & 1];
+					for ($y = 0; $y < $rows; $y++) {
+						ncurses_mvwaddstr($win, $y, 0, $line);
+					}
+					ncurses_wrefresh($win);
+				}
+			},
+			'teardown' => function () use ($win) {
+				ncurses_delwin($win);
+			},
+		);
+	},
+
+	/* eight overlapping panels, the top one moves on every update */
+	'update_panels' => function ($rows, $cols) {
+		if (!function_exists('ncurses_update_panels')) {
+			return null;
+		}
+
+		$h = max(2, (int)($rows / 2));
+		$w = max(2, (int)($cols / 2));
+		$windows = $panels = array();
+		for ($i = 0; $i < 8; $i++) {
+			$win = ncurses_newwin($h, $w, $i % ($rows - $h + 1), ($i * 3) % ($cols - $w + 1));
+			ncurses_wborder($win, 0, 0, 0, 0, 0, 0, 0, 0);
+			$windows[] = $win;
+			$panels[]  = ncurses_new_panel($win);
+		}
+		$top = end($panels);
+
+		return array(
+			'run' => function ($n) use ($top, $rows, $cols, $h, $w) {
+				for ($i = 0; $i < $n; $i++) {
+					ncurses_move_panel($top, $i % ($rows - $h + 1), $i % ($cols - $w + 1));
+					ncurses_update_panels();
+					ncurses_doupdate();
+				}
+			},
+			'teardown' => function () use (&$panels, &$windows) {
+				foreach ($panels as $panel) {
+					ncurses_del_panel($panel);
+				}
+				foreach ($windows as $win) {
+					ncurses_delwin($win);
+				}
+				$panels = $windows = array();
+			},
+		);
+	},
+
+	/* scroll a pad four times the screen height through the screen */
+	'prefresh' => function ($rows, $cols) {
+		$pad = ncurses_newpad($rows * 4, $cols);
+		for ($y = 0; $y < $rows * 4; $y++) {
+			ncurses_mvwaddstr($pad, $y, 0, str_pad("line $y", $cols - 1, '.'));
+		}
+		$range = $rows * 3 + 1;
+
+		return array(
+			'run' => function ($n) use ($pad, $rows, $cols, $range) {
+				for ($i = 0; $i < $n; $i++) {
+					ncurses_prefresh($pad, $i % $range, 0, 0, 0, $rows - 1, $cols - 1);
+				}
+			},
+			'teardown' => function () use ($pad) {
+				ncurses_delwin($pad);
+			},
+		);
+	},
+);
@@ -0,0 +1,56 @@
+<?php
+/*
+ * Compares two result files of bench/run.php.
+ *
+ * Usage: php bench/compare.php BASE.json NEW.json [THRESHOLD]
+ *
+ * Prints the change of ops/sec for every benchmark found in both files and
+ * exits with status 1 if any of them got slower by more than THRESHOLD
+ * percent (default 10).
+ */
+
+if ($argc < 3) {
+	fwrite(STDERR, "Usage: php {$argv[0]} BASE.json NEW.json [THRESHOLD]\n");
+	exit(2);
+}
+
+function bench_load($file)
+{
+	$data = json_decode((string)@file_get_contents($file), true);
+	if (!is_array($data) || !isset($data['results'])) {
+		fwrite(STDERR, "$file is not a result file of bench/run.php\n");
+		exit(2);
+	}
+
+	$results = array();
+	foreach ($data['results'] as $r) {
+		$results["{$r['name']} {$r['rows']}x{$r['cols']}"] = $r;
+	}
+	return $results;
+}
+
+$base      = bench_load($argv[1]);
+$new       = bench_load($argv[2]);
+$threshold = isset($argv[3]) ? (float)$argv[3] : 10.0;
+$failed    = 0;
+
+printf("%-28s %14s %14s %9s\n", 'benchmark', 'base ops/s', 'new ops/s', 'change');
+foreach ($base as $key => $b) {
+	if (!isset($new[$key])) {
+		continue;
+	}
+	if ($b['ops_per_sec'] > 0) {
+		$change = ($new[$key]['ops_per_sec'] - $b['ops_per_sec']) / $b['ops_per_sec'] * 100;
+	} else {
+		/* nothing to compare against, a baseline that never ran is no regression */
+		$change = 0.0;
+	}
+	$slower = $change < -$threshold;
+	if ($slower) {
+		$failed++;
+	}
+
+	printf("%-28s %14.1f %14.1f %+8.1f%%%s\n", $key, $b['ops_per_sec'], $new[$key]['ops_per_sec'], $change, $slower ? ' !' : '');
+}
+
+exit($failed ? 1 : 0);
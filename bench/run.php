@@ -0,0 +1,114 @@
+<?php
+/*
+ * Runs the benchmarks of bench/benchmarks.php on a headless terminal and
+ * prints the results as JSON.
+ *
+ * Usage: php bench/run.php [--time=SECONDS] [--sizes=ROWSxCOLS,...]
+ *                          [--filter=REGEX] [--output=FILE]
+ *
+ * --filter takes a PCRE pattern without delimiters, matched against the
+ * benchmark names; "/" needs no escaping.
+ *
+ * Compare two result files with bench/compare.php.
+ */
+
+if (!extension_loaded('ncurses')) {
+	fwrite(STDERR, "The ncurses extension is not loaded\n");
+	exit(1);
+}
+if (!function_exists('ncurses_headless_init')) {
+	fwrite(STDERR, "This build of the ncurses extension has no headless terminal\n");
+	exit(1);
+}
+
+$opts   = getopt('', array('time:', 'sizes:', 'filter:', 'output:'));
+$budget = isset($opts['time']) ? (float)$opts['time'] : 0.5;
+$sizes  = isset($opts['sizes']) ? $opts['sizes'] : '24x80,50x132,100x240';
+$filter = isset($opts['filter']) ? '/' . str_replace('/', '\/', $opts['filter']) . '/' : null;
+
+if ($filter !== null && @preg_match($filter, '') === false) {
+	fwrite(STDERR, "Invalid --filter pattern '{$opts['filter']}'\n");
+	exit(1);
+}
+
+function bench_now()
+{
+	return function_exists('hrtime') ? hrtime(true) / 1e9 : microtime(true);
+}
+
+$benchmarks = require __DIR__ . '/benchmarks.php';
+$results = array();
+
+foreach (explode(',', $sizes) as $size) {
+	if (!preg_match('/^(\d+)x(\d+)$/', trim($size), $m)) {
+		fwrite(STDERR, "Invalid size '$size', expected ROWSxCOLS\n");
+		exit(1);
+	}
+	$rows = (int)$m[1];
+	$cols = (int)$m[2];
+
+	if (!ncurses_headless_init($rows, $cols)) {
+		exit(1);
+	}
+
+	foreach ($benchmarks as $name => $setup) {
+		if ($filter !== null && !preg_match($filter, $name)) {
+			continue;
+		}
+		if (($bench = $setup($rows, $cols)) === null) {
+			continue;
+		}
+		$run = $bench['run'];
+
+		/* warm up, then grow the batch until it takes a tenth of the budget */
+		$run(1);
+		ncurses_headless_output();
+
+		$n = 1;
+		$ops = $bytes = 0;
+		$elapsed = 0.0;
+		while ($elapsed < $budget) {
+			$start = bench_now();
+			$run($n);
+			$time = bench_now() - $start;
+
+			$bytes   += strlen(ncurses_headless_output());
+			$ops     += $n;
+			$elapsed += $time;
+			if ($time < $budget / 10) {
+				$n *= 2;
+			}
+		}
+
+		if (isset($bench['teardown'])) {
+			$bench['teardown']();
+		}
+		ncurses_headless_output();
+
+		$results[] = array(
+			'name'         => $name,
+			'rows'         => $rows,
+			'cols'         => $cols,
+			'ops'          => $ops,
+			'seconds'      => round($elapsed, 6),
+			'ops_per_sec'  => round($ops / $elapsed, 1),
+			'bytes_per_op' => round($bytes / $ops, 1),
+		);
+	}
+
+	ncurses_end();
+}
+
+$json = json_encode(array(
+	'php'       => PHP_VERSION,
+	'extension' => phpversion('ncurses'),
+	'date'      => gmdate('c'),
+	'time'      => $budget,
+	'results'   => $results,
+), JSON_PRETTY_PRINT) . "\n";
+
+if (isset($opts['output'])) {
+	file_put_contents($opts['output'], $json);
+} else {
+	echo $json;
+}
@@ -80,8 +80,14 @@ if test "$PHP_NCURSES" != "no"; then
    AC_CHECK_LIB($LIBNAME, assume_default_colors,   [AC_DEFINE(HAVE_NCURSES_ASSUME_DEFAULT_COLORS,  1, [ ])])
    AC_CHECK_LIB($LIBNAME, use_extended_names,   [AC_DEFINE(HAVE_NCURSES_USE_EXTENDED_NAMES,  1, [ ])])
    AC_CHECK_LIB($LIBNAME, define_key,   [AC_DEFINE(HAVE_NCURSES_DEFINE_KEY,  1, [ ])])
+   AC_CHECK_LIB($LIBNAME, wgetdelay,   [AC_DEFINE(HAVE_NCURSES_WGETDELAY,  1, [ ])])
+   AC_CHECK_FUNCS(open_memstream fmemopen)
 
-   PHP_NEW_EXTENSION(ncurses, ncurses.c ncurses_fe.c ncurses_functions.c, $ext_shared, cli)
+   if test "$PHP_NCURSESW" != "no"; then
+     AC_CHECK_LIB($LIBNAME, waddnwstr,   [AC_DEFINE(HAVE_NCURSESW,  1, [ ])])
+   fi
+
+   PHP_NEW_EXTENSION(ncurses, ncurses.c ncurses_fe.c ncurses_functions.c ncurses_cellbuffer.c ncurses_window.c ncurses_stats.c ncurses_headless.c ncurses_table.c ncurses_listview.c ncurses_logtail.c ncurses_colors.c ncurses_scene.c ncurses_screen.c ncurses_record.c ncurses_inject.c ncurses_mouse.c ncurses_terminfo.c, $ext_shared, cli)
    PHP_SUBST(NCURSES_SHARED_LIBADD)
 
 fi
@@ -7,7 +7,7 @@ errmsg () {
 }
 
 usage () {
-	echo "Usage: $0 [clean|pack|test [php-version]]"
+	echo "Usage: $0 [clean|pack|test [php-version]|bench php-version [-- bench-options]]"
 	exit 1
 }
 
@@ -109,6 +109,27 @@ case "${mode}" in
 		EOL
 		make test PHP_EXECUTABLE=${PHPBIN} <<< n
 		;;
+	bench)
+		PHPBIN=/opt/php-qa/php${2}/bin/php
+		PHPIZE=/opt/php-qa/php${2}/bin/phpize
+		PHP_OPT="-n"
+
+		if [[ ! -f modules/${mod_name}.so ]]; then
+			echo "${PHPIZE} && ./configure --enable-ncursesw"
+			${PHPIZE} && ./configure --enable-ncursesw && make -j8 || exit 1
+		fi
+
+		if (( $2 > 71 )); then
+			PHP_OPT+=" -d 'extension_dir=./modules/' -d 'extension=${mod_name}'"
+		else
+			PHP_OPT+=" -d 'extension_dir=./modules/' -d 'extension=${mod_name}.so'"
+		fi
+
+		# options after -- go to bench/run.php, e.g. --time=1 --output=base.json
+		shift 2
+		eval "${PHPBIN} ${PHP_OPT} bench/run.php $*"
+		exit $?
+		;;
 	stub)
 		# stub tagging
 		# /** @generate-function-entries **/ build with function entries
@@ -43,10 +43,9 @@ static void ncurses_destruct_window(zend_resource *rsrc)
 static void ncurses_destruct_window(zend_rsrc_list_entry *rsrc TSRMLS_DC)
 #endif
 {
-	WINDOW **pwin = (WINDOW **)rsrc->ptr;
-
-	delwin(*pwin);
-	efree(pwin);
+	if (rsrc->ptr) {
+		delwin((WINDOW *)rsrc->ptr);
+	}
 }
 
 #if HAVE_NCURSES_PANEL
@@ -56,10 +55,24 @@ static void ncurses_destruct_panel(zend_resource *rsrc)
 static void ncurses_destruct_panel(zend_rsrc_list_entry *rsrc TSRMLS_DC)
 #endif
 {
-	PANEL **ppanel = (PANEL **)rsrc->ptr;
+#if PHP_MAJOR_VERSION == 7
+	PANEL *panel = (PANEL *)rsrc->ptr;
+	php_ncurses_panel_res *res;
 
-	del_panel(*ppanel);
-	efree(ppanel);
+	if (!panel) {
+		/* deleted together with the headless terminal */
+		return;
+	}
+	res = (php_ncurses_panel_res *)panel_userptr(panel);
+	php_ncurses_window_panel_del(panel_window(panel), rsrc);
+	del_panel(panel);
+	if (res) {
+		zval_ptr_dtor(&res->window);
+		efree(res);
+	}
+#else
+	del_panel((PANEL *)rsrc->ptr);
+#endif
 }
 #endif
 
@@ -72,7 +85,7 @@ zend_module_entry ncurses_module_entry = {
 	PHP_MINIT(ncurses),
 	PHP_MSHUTDOWN(ncurses),
 	NULL,
-	NULL,
+	PHP_RSHUTDOWN(ncurses),
 	PHP_MINFO(ncurses),
 	PHP_NCURSES_VERSION,
 	STANDARD_MODULE_PROPERTIES
@@ -86,6 +99,14 @@ ZEND_GET_MODULE(ncurses)
 #define PHP_NCURSES_CONST(x)  REGISTER_LONG_CONSTANT("NCURSES_"#x, x, CONST_CS | CONST_PERSISTENT)
 #define PHP_NCURSES_FKEY_CONST(x)  REGISTER_LONG_CONSTANT("NCURSES_KEY_F"#x, KEY_F0 + x, CONST_CS | CONST_PERSISTENT)
 
+/* {{{ PHP_INI
+ */
+PHP_INI_BEGIN()
+	STD_PHP_INI_BOOLEAN("ncurses.stats", "0", PHP_INI_SYSTEM, OnUpdateBool, stats, zend_ncurses_globals, ncurses_globals)
+	STD_PHP_INI_ENTRY("ncurses.terminfo_cache", "", PHP_INI_ALL, OnUpdateString, terminfo_cache, zend_ncurses_globals, ncurses_globals)
+PHP_INI_END()
+/* }}} */
+
 static void php_ncurses_init_globals(zend_ncurses_globals *ncurses_globals)
 {
 	memset(ncurses_globals, 0, sizeof(*ncurses_globals));
@@ -255,12 +276,24 @@ PHP_MINIT_FUNCTION(ncurses)
 	PHP_NCURSES_CONST(REPORT_MOUSE_POSITION);
 
 	ZEND_INIT_MODULE_GLOBALS(ncurses, php_ncurses_init_globals, NULL);
+	REGISTER_INI_ENTRIES();
+	PHP_MINIT(ncurses_stats)(INIT_FUNC_ARGS_PASSTHRU);
 
 	le_ncurses_windows = zend_register_list_destructors_ex(ncurses_destruct_window, NULL, "ncurses_window", module_number);
 #if HAVE_NCURSES_PANEL
 	le_ncurses_panels = zend_register_list_destructors_ex(ncurses_destruct_panel, NULL, "ncurses_panel", module_number);
 #endif
 
+#if PHP_VERSION_ID >= 80000
+	PHP_MINIT(ncurses_window)(INIT_FUNC_ARGS_PASSTHRU);
+	PHP_MINIT(ncurses_cellbuffer)(INIT_FUNC_ARGS_PASSTHRU);
+	PHP_MINIT(ncurses_listview)(INIT_FUNC_ARGS_PASSTHRU);
+	PHP_MINIT(ncurses_logtail)(INIT_FUNC_ARGS_PASSTHRU);
+	PHP_MINIT(ncurses_scene)(INIT_FUNC_ARGS_PASSTHRU);
+	PHP_MINIT(ncurses_screen)(INIT_FUNC_ARGS_PASSTHRU);
+	PHP_MINIT(ncurses_mouse)(INIT_FUNC_ARGS_PASSTHRU);
+#endif
+
 	return SUCCESS;
 }
 /* }}} */
@@ -272,6 +305,41 @@ PHP_MSHUTDOWN_FUNCTION(ncurses)
 	if (NCURSES_G(registered_constants)) {
 		endwin();
 	}
+	php_ncurses_headless_shutdown();
+	php_ncurses_pairs_reset();
+	php_ncurses_palette_reset();
+#if PHP_MAJOR_VERSION == 7
+	if (NCURSES_G(window_panels)) {
+		zend_hash_destroy(NCURSES_G(window_panels));
+		pefree(NCURSES_G(window_panels), 1);
+		NCURSES_G(window_panels) = NULL;
+	}
+#endif
+
+	PHP_MSHUTDOWN(ncurses_stats)(SHUTDOWN_FUNC_ARGS_PASSTHRU);
+	UNREGISTER_INI_ENTRIES();
+
+	return SUCCESS;
+}
+/* }}} */
+
+/* {{{ PHP_RSHUTDOWN_FUNCTION
+ */
+PHP_RSHUTDOWN_FUNCTION(ncurses)
+{
+#if PHP_MAJOR_VERSION >= 7
+	zval_ptr_dtor(&NCURSES_G(input_waiter));
+	ZVAL_UNDEF(&NCURSES_G(input_waiter));
+#endif
+	php_ncurses_record_shutdown();
+	php_ncurses_inject_reset();
+	/* the terminal lives in request memory, as do the windows made on it */
+	php_ncurses_headless_shutdown();
+	NCURSES_G(mouse_sgr) = 0;
+	NCURSES_G(mouse_pending) = 0;
+	NCURSES_G(unread_len) = 0;
+	NCURSES_G(lazy) = 0;
+	NCURSES_G(lazy_stdscr) = NULL;
 
 	return SUCCESS;
 }
@@ -299,11 +367,15 @@ PHP_MINFO_FUNCTION(ncurses)
 #else
 		php_info_print_table_row(2, "color support", "no");
 #endif
+#ifdef HAVE_NCURSESW
+		php_info_print_table_row(2, "wide character support", "yes");
+#else
+		php_info_print_table_row(2, "wide character support", "no");
+#endif
+	php_ncurses_stats_info();
 	php_info_print_table_end();
 
-	/* Remove comments if you have entries in php.ini
 	DISPLAY_INI_ENTRIES();
-	*/
 }
 /* }}} */
 
@@ -2,20 +2,20 @@
 /** @generate-function-entries **/
 
 function ncurses_addch(int $ch): int { }
-function ncurses_waddch(resource $window, int $ch): int { }
+function ncurses_waddch(NcursesWindow $window, int $ch): int { }
 function ncurses_color_set(int $pair): int { }
-function ncurses_delwin(resource $window): bool { }
+function ncurses_delwin(NcursesWindow $window): bool { }
 function ncurses_end(): int { }
 function ncurses_getch(): int { }
 function ncurses_has_colors(): bool { }
-function ncurses_init(): int { }
+function ncurses_init(bool $lazy = false): int { }
 function ncurses_init_pair(int $pair, int $fg, int $bg): int { }
 function ncurses_color_pair(int $pair): int {}
 function ncurses_move(int $y, int $x): int { }
-function ncurses_newpad(int $rows, int $cols): resource { }
-function ncurses_prefresh(resource $pad, int $pminrow, int $pmincol, int $sminrow, int $smincol, int $smaxrow, int $smaxcol): int { }
-function ncurses_pnoutrefresh(resource $pad, int $pminrow, int $pmincol, int $sminrow, int $smincol, int $smaxrow, int $smaxcol): int { }
-function ncurses_newwin(int $rows, int $cols, int $y, int $x): int { }
+function ncurses_newpad(int $rows, int $cols): NcursesWindow|false { }
+function ncurses_prefresh(NcursesWindow $pad, int $pminrow, int $pmincol, int $sminrow, int $smincol, int $smaxrow, int $smaxcol): int { }
+function ncurses_pnoutrefresh(NcursesWindow $pad, int $pminrow, int $pmincol, int $sminrow, int $smincol, int $smaxrow, int $smaxcol): int { }
+function ncurses_newwin(int $rows, int $cols, int $y, int $x): NcursesWindow|false { }
 function ncurses_refresh(int $ch): int { }
 function ncurses_start_color(): int { }
 function ncurses_standout(): int { }
@@ -51,8 +51,8 @@ function ncurses_noecho(): int { }
 function ncurses_nonl(): int { }
 function ncurses_noraw(): bool { }
 function ncurses_raw(): int { }
-function ncurses_meta(resource $window, bool $_8bit): int { }
-function ncurses_werase(resource $window): int { }
+function ncurses_meta(NcursesWindow $window, bool $_8bit): int { }
+function ncurses_werase(NcursesWindow $window): int { }
 function ncurses_resetty(): int { }
 function ncurses_savetty(): int { }
 function ncurses_termattrs(): int { }
@@ -68,7 +68,7 @@ function ncurses_attroff(int $attributes): int { }
 function ncurses_attron(int $attributes): int { }
 function ncurses_attrset(int $attributes): int { }
 function ncurses_bkgd(int $attrchar): int { }
-function ncurses_wbkgd(resource $handle, int $attrchar): int { }
+function ncurses_wbkgd(NcursesWindow $handle, int $attrchar): int { }
 function ncurses_curs_set(int $visibility): int { }
 function ncurses_delay_output(int $milliseconds): int { }
 function ncurses_echochar(int $character): int { }
@@ -89,7 +89,7 @@ function ncurses_ungetch(int $keycode): int { }
 function ncurses_vidattr(int $intarg): int { }
 function ncurses_use_extended_names(bool $flag): int { }
 function ncurses_bkgdset(int $attrchar): void { }
-function ncurses_wbkgdset(resource $handle, int $attrchar): void { }
+function ncurses_wbkgdset(NcursesWindow $handle, int $attrchar): void { }
 function ncurses_filter(): void { }
 function ncurses_noqiflush(): int { }
 function ncurses_qiflush(): void { }
@@ -121,51 +121,99 @@ function ncurses_init_color(int $color, int $r, int $g, int $b): int { }
 function ncurses_color_content(int $color, int &$r, int &$g, int &$b): int { }
 function ncurses_pair_content(int $pair, int &$f, int &$b): int { }
 function ncurses_border(int $left, int $right, int $top, int $bottom, int $tl_corner, int $tr_corner, int $bl_corner, int $br_corner): int { }
-function ncurses_wborder(resource $window, int $left, int $right, int $top, int $bottom, int $tl_corner, int $tr_corner, int $bl_corner, int $br_corner): int { }
+function ncurses_wborder(NcursesWindow $window, int $left, int $right, int $top, int $bottom, int $tl_corner, int $tr_corner, int $bl_corner, int $br_corner): int { }
 function ncurses_assume_default_colors(int $fg, int $bg): int { }
 function ncurses_define_key(string $definition, int $keycode): int { }
 function ncurses_hline(int $charattr, int $n): int { }
 function ncurses_vline(int $charattr, int $n): int { }
-function ncurses_whline(resource $window, int $charattr, int $n): int { }
-function ncurses_wvline(resource $window, int $charattr, int $n): int { }
+function ncurses_whline(NcursesWindow $window, int $charattr, int $n): int { }
+function ncurses_wvline(NcursesWindow $window, int $charattr, int $n): int { }
 function ncurses_keyok(int $keycode, int $enable): int { }
-function ncurses_mvwaddstr(resource $window, int $y, int $x, string $text): int { }
-function ncurses_wrefresh(resource $window): int { }
-function ncurses_wscrl(resource $window, int $count): int { }
-function ncurses_wsetscrreg(resource $window, int $top, int $bot): int { }
-function ncurses_scrollok(resource $window, bool $bf): int { }
+function ncurses_mvwaddstr(NcursesWindow $window, int $y, int $x, string $text): int { }
+function ncurses_wrefresh(NcursesWindow $window): int { }
+function ncurses_wscrl(NcursesWindow $window, int $count): int { }
+function ncurses_wsetscrreg(NcursesWindow $window, int $top, int $bot): int { }
+function ncurses_scrollok(NcursesWindow $window, bool $bf): int { }
 function ncurses_termname(): string { }
 function ncurses_longname(): string { }
 function ncurses_mousemask(int $newmask, int &$oldmask): int { }
-function ncurses_getmouse(array &$mevent): bool { }
+function ncurses_getmouse(array|NcursesMouseEvent &$mevent): bool { }
 function ncurses_ungetmouse(array $mevent): int { }
 function ncurses_mouse_trafo(int &$y, int &$x, bool $toscreen): bool { }
-function ncurses_wmouse_trafo(resource $window, int &$y, int &$x, bool $toscreen): bool { }
-function ncurses_getyx(resource $window, int &$y, int &$x): void { }
-function ncurses_getmaxyx(resource $window, int &$y, int &$x): void { }
-function ncurses_wmove(resource $window, int $y, int $x): int { }
-function ncurses_keypad(resource $window, bool $bf): int { }
-function ncurses_wcolor_set(resource $window, int $color_pair): int { }
-function ncurses_wclear(resource $window): int { }
-function ncurses_wnoutrefresh(resource $window): int { }
-function ncurses_waddstr(resource $window, string $str, int $n = ""): int { }
-function ncurses_wgetch(resource $window): int { }
-function ncurses_wattroff(resource $window, int $attrs): int { }
-function ncurses_wattron(resource $window, int $attrs): int { }
-function ncurses_wattrset(resource $window, int $attrs): int { }
-function ncurses_wstandend(resource $window): int { }
-function ncurses_wstandout(resource $window): int { }
-function ncurses_new_panel(resource $window): resource { }
-function ncurses_del_panel(resource $panel): bool { }
-function ncurses_hide_panel(resource $panel): int { }
-function ncurses_show_panel(resource $panel): int { }
-function ncurses_top_panel(resource $panel): int { }
-function ncurses_bottom_panel(resource $panel): int { }
-function ncurses_move_panel(resource $panel, int $startx, int $starty): int { }
-function ncurses_replace_panel(resource $panel, resource $window): int { }
-function ncurses_panel_above(resource $panel): resource { }
-function ncurses_panel_below(resource $panel): resource { }
-function ncurses_panel_window(resource $panel): resource { }
+function ncurses_wmouse_trafo(NcursesWindow $window, int &$y, int &$x, bool $toscreen): bool { }
+function ncurses_getyx(NcursesWindow $window, int &$y, int &$x): void { }
+function ncurses_getmaxyx(NcursesWindow $window, int &$y, int &$x): void { }
+function ncurses_wmove(NcursesWindow $window, int $y, int $x): int { }
+function ncurses_keypad(NcursesWindow $window, bool $bf): int { }
+function ncurses_wcolor_set(NcursesWindow $window, int $color_pair): int { }
+function ncurses_wclear(NcursesWindow $window): int { }
+function ncurses_wnoutrefresh(NcursesWindow $window): int { }
+function ncurses_waddstr(NcursesWindow $window, string $str, int $n = ""): int { }
+function ncurses_wgetch(NcursesWindow $window): int { }
+function ncurses_wattroff(NcursesWindow $window, int $attrs): int { }
+function ncurses_wattron(NcursesWindow $window, int $attrs): int { }
+function ncurses_wattrset(NcursesWindow $window, int $attrs): int { }
+function ncurses_wstandend(NcursesWindow $window): int { }
+function ncurses_wstandout(NcursesWindow $window): int { }
+function ncurses_new_panel(NcursesWindow $window): NcursesPanel|false { }
+function ncurses_del_panel(NcursesPanel $panel): bool { }
+function ncurses_hide_panel(NcursesPanel $panel): int { }
+function ncurses_show_panel(NcursesPanel $panel): int { }
+function ncurses_top_panel(NcursesPanel $panel): int { }
+function ncurses_bottom_panel(NcursesPanel $panel): int { }
+function ncurses_move_panel(NcursesPanel $panel, int $startx, int $starty): int { }
+function ncurses_replace_panel(NcursesPanel $panel, NcursesWindow $window): int { }
+function ncurses_panel_above(?NcursesPanel $panel): NcursesPanel|false { }
+function ncurses_panel_below(?NcursesPanel $panel): NcursesPanel|false { }
+function ncurses_panel_window(NcursesPanel $panel): NcursesWindow|false { }
 function ncurses_update_panels(): void { }
+function ncurses_frame_begin(): void { }
+function ncurses_frame_end(bool $wait = true): bool { }
+function ncurses_set_max_fps(int $fps): int|false { }
+/** @return resource|false */
+function ncurses_input_stream() { }
+function ncurses_drain_keys(?NcursesWindow $window = null, int $max = 0): array { }
+function ncurses_wgetch_batch(NcursesWindow $window, int $max = 0, int $timeout_ms = 0): array { }
+function ncurses_stats(bool $reset = false): array { }
+function ncurses_headless_init(int $rows = 24, int $cols = 80, string $term = "xterm"): bool { }
+function ncurses_headless_screen(bool $cells = false): array|false { }
+function ncurses_headless_output(): string|false { }
+function ncurses_scr_dump_string(): string|false { }
+function ncurses_scr_restore_string(string $dump): int { }
+function ncurses_scr_init_string(string $dump): int { }
+function ncurses_scr_set_string(string $dump): int { }
+function ncurses_putwin(NcursesWindow $window): string|false { }
+function ncurses_getwin(string $dump): NcursesWindow|false { }
+function ncurses_wrestore(NcursesWindow $window, string $dump): int { }
+function ncurses_wdraw_table(NcursesWindow $window, array $rows, array $columns, array $options = []): int|false { }
+function ncurses_color_pair_for(int $fg, int $bg): int|false { }
+function ncurses_rgb_to_color(int|array $rgb): int|array|false { }
+function ncurses_touchwin(NcursesWindow $window): int { }
+function ncurses_untouchwin(NcursesWindow $window): int { }
+function ncurses_wtouchln(NcursesWindow $window, int $y, int $n, int $changed): int { }
+function ncurses_is_linetouched(NcursesWindow $window, int $line): bool { }
+function ncurses_is_wintouched(NcursesWindow $window): bool { }
+function ncurses_wredrawln(NcursesWindow $window, int $beg_line, int $num_lines): int { }
+function ncurses_wdirty_lines(NcursesWindow $window): array { }
+function ncurses_panels_apply(array $ops, bool $doupdate = false): int|false { }
+function ncurses_window_panel(NcursesWindow $window): NcursesPanel|false { }
+function ncurses_panel_stack(): array { }
+/**
+ * @param resource $output
+ * @param resource $input
+ */
+function ncurses_newterm(?string $type, $output, $input): NcursesScreen|false { }
+function ncurses_set_term(?NcursesScreen $screen): bool { }
+function ncurses_set_input_waiter(?callable $waiter): bool { }
+function ncurses_getch_async(?NcursesWindow $window = null): int { }
+/** @param resource $stream */
+function ncurses_record_start($stream, ?string $title = null): bool { }
+function ncurses_record_stop(): bool { }
+/** @param resource $stream */
+function ncurses_replay($stream): array|false { }
+
+function ncurses_inject(array $events, int $interval_ms = 0): int|false { }
+
+function ncurses_mouse_sgr(bool $enable = true): bool { }
 
 ?>
@@ -1,5 +1,5 @@
 /* This is a generated file, edit the .stub.php file instead.
- * Stub hash: 630859abe2cdb9b5b472f4b4addace007331b0a3 */
+ * Stub hash: 391159e563d4b353553aa3596978ce34a368a08b */
 
 #if PHP_VERSION_ID >= 80000
 
@@ -8,7 +8,7 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_addch, 0, 1, IS_LONG, 0)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_waddch, 0, 2, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(0, ch, IS_LONG, 0)
 ZEND_END_ARG_INFO()
 
@@ -17,7 +17,7 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_color_set, 0, 1, IS_LONG
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_delwin, 0, 1, _IS_BOOL, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_end, 0, 0, IS_LONG, 0)
@@ -28,7 +28,9 @@ ZEND_END_ARG_INFO()
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_has_colors, 0, 0, _IS_BOOL, 0)
 ZEND_END_ARG_INFO()
 
-#define arginfo_ncurses_init arginfo_ncurses_end
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_init, 0, 0, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, lazy, _IS_BOOL, 0, "false")
+ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_init_pair, 0, 3, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, pair, IS_LONG, 0)
@@ -41,13 +43,13 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_move, 0, 2, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, x, IS_LONG, 0)
 ZEND_END_ARG_INFO()
 
-ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_ncurses_newpad, 0, 2, resource, 0)
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_TYPE_MASK_EX(arginfo_ncurses_newpad, 0, 2, NcursesWindow, MAY_BE_FALSE)
 	ZEND_ARG_TYPE_INFO(0, rows, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, cols, IS_LONG, 0)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_prefresh, 0, 7, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, pad, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, pad, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(0, pminrow, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, pmincol, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, sminrow, IS_LONG, 0)
@@ -58,7 +60,7 @@ ZEND_END_ARG_INFO()
 
 #define arginfo_ncurses_pnoutrefresh arginfo_ncurses_prefresh
 
-ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_newwin, 0, 4, IS_LONG, 0)
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_TYPE_MASK_EX(arginfo_ncurses_newwin, 0, 4, NcursesWindow, MAY_BE_FALSE)
 	ZEND_ARG_TYPE_INFO(0, rows, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, cols, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, y, IS_LONG, 0)
@@ -137,12 +139,12 @@ ZEND_END_ARG_INFO()
 #define arginfo_ncurses_raw arginfo_ncurses_end
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_meta, 0, 2, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(0, _8bit, _IS_BOOL, 0)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_werase, 0, 1, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 ZEND_END_ARG_INFO()
 
 #define arginfo_ncurses_resetty arginfo_ncurses_end
@@ -184,7 +186,7 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_bkgd, 0, 1, IS_LONG, 0)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_wbkgd, 0, 2, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, handle, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, handle, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(0, attrchar, IS_LONG, 0)
 ZEND_END_ARG_INFO()
 
@@ -249,7 +251,7 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_bkgdset, 0, 1, IS_VOID,
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_wbkgdset, 0, 2, IS_VOID, 0)
-	ZEND_ARG_OBJ_INFO(0, handle, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, handle, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(0, attrchar, IS_LONG, 0)
 ZEND_END_ARG_INFO()
 
@@ -378,7 +380,7 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_border, 0, 8, IS_LONG, 0
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_wborder, 0, 9, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(0, left, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, right, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, top, IS_LONG, 0)
@@ -407,7 +409,7 @@ ZEND_END_ARG_INFO()
 #define arginfo_ncurses_vline arginfo_ncurses_hline
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_whline, 0, 3, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(0, charattr, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, n, IS_LONG, 0)
 ZEND_END_ARG_INFO()
@@ -420,7 +422,7 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_keyok, 0, 2, IS_LONG, 0)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_mvwaddstr, 0, 4, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(0, y, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, x, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, text, IS_STRING, 0)
@@ -429,18 +431,18 @@ ZEND_END_ARG_INFO()
 #define arginfo_ncurses_wrefresh arginfo_ncurses_werase
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_wscrl, 0, 2, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(0, count, IS_LONG, 0)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_wsetscrreg, 0, 3, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(0, top, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, bot, IS_LONG, 0)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_scrollok, 0, 2, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(0, bf, _IS_BOOL, 0)
 ZEND_END_ARG_INFO()
 
@@ -454,7 +456,7 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_mousemask, 0, 2, IS_LONG
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_getmouse, 0, 1, _IS_BOOL, 0)
-	ZEND_ARG_TYPE_INFO(1, mevent, IS_ARRAY, 0)
+	ZEND_ARG_OBJ_TYPE_MASK(1, mevent, NcursesMouseEvent, MAY_BE_ARRAY, NULL)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_ungetmouse, 0, 1, IS_LONG, 0)
@@ -468,14 +470,14 @@ ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_mouse_trafo, 0, 3, _IS_B
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_wmouse_trafo, 0, 4, _IS_BOOL, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(1, y, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(1, x, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, toscreen, _IS_BOOL, 0)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_getyx, 0, 3, IS_VOID, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(1, y, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(1, x, IS_LONG, 0)
 ZEND_END_ARG_INFO()
@@ -483,7 +485,7 @@ ZEND_END_ARG_INFO()
 #define arginfo_ncurses_getmaxyx arginfo_ncurses_getyx
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_wmove, 0, 3, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(0, y, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, x, IS_LONG, 0)
 ZEND_END_ARG_INFO()
@@ -491,7 +493,7 @@ ZEND_END_ARG_INFO()
 #define arginfo_ncurses_keypad arginfo_ncurses_scrollok
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_wcolor_set, 0, 2, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(0, color_pair, IS_LONG, 0)
 ZEND_END_ARG_INFO()
 
@@ -500,7 +502,7 @@ ZEND_END_ARG_INFO()
 #define arginfo_ncurses_wnoutrefresh arginfo_ncurses_werase
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_waddstr, 0, 2, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(0, str, IS_STRING, 0)
 	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, n, IS_LONG, 0, "\"\"")
 ZEND_END_ARG_INFO()
@@ -508,7 +510,7 @@ ZEND_END_ARG_INFO()
 #define arginfo_ncurses_wgetch arginfo_ncurses_werase
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_wattroff, 0, 2, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 	ZEND_ARG_TYPE_INFO(0, attrs, IS_LONG, 0)
 ZEND_END_ARG_INFO()
 
@@ -520,16 +522,16 @@ ZEND_END_ARG_INFO()
 
 #define arginfo_ncurses_wstandout arginfo_ncurses_werase
 
-ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_ncurses_new_panel, 0, 1, resource, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_TYPE_MASK_EX(arginfo_ncurses_new_panel, 0, 1, NcursesPanel, MAY_BE_FALSE)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_del_panel, 0, 1, _IS_BOOL, 0)
-	ZEND_ARG_OBJ_INFO(0, panel, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, panel, NcursesPanel, 0)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_hide_panel, 0, 1, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, panel, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, panel, NcursesPanel, 0)
 ZEND_END_ARG_INFO()
 
 #define arginfo_ncurses_show_panel arginfo_ncurses_hide_panel
@@ -539,26 +541,187 @@ ZEND_END_ARG_INFO()
 #define arginfo_ncurses_bottom_panel arginfo_ncurses_hide_panel
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_move_panel, 0, 3, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, panel, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, panel, NcursesPanel, 0)
 	ZEND_ARG_TYPE_INFO(0, startx, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO(0, starty, IS_LONG, 0)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_replace_panel, 0, 2, IS_LONG, 0)
-	ZEND_ARG_OBJ_INFO(0, panel, resource, 0)
-	ZEND_ARG_OBJ_INFO(0, window, resource, 0)
+	ZEND_ARG_OBJ_INFO(0, panel, NcursesPanel, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
 ZEND_END_ARG_INFO()
 
-ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_ncurses_panel_above, 0, 1, resource, 0)
-	ZEND_ARG_OBJ_INFO(0, panel, resource, 0)
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_TYPE_MASK_EX(arginfo_ncurses_panel_above, 0, 1, NcursesPanel, MAY_BE_FALSE)
+	ZEND_ARG_OBJ_INFO(0, panel, NcursesPanel, 1)
 ZEND_END_ARG_INFO()
 
 #define arginfo_ncurses_panel_below arginfo_ncurses_panel_above
 
-#define arginfo_ncurses_panel_window arginfo_ncurses_panel_above
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_TYPE_MASK_EX(arginfo_ncurses_panel_window, 0, 1, NcursesWindow, MAY_BE_FALSE)
+	ZEND_ARG_OBJ_INFO(0, panel, NcursesPanel, 0)
+ZEND_END_ARG_INFO()
 
 #define arginfo_ncurses_update_panels arginfo_ncurses_filter
 
+#define arginfo_ncurses_frame_begin arginfo_ncurses_filter
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_frame_end, 0, 0, _IS_BOOL, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, wait, _IS_BOOL, 0, "true")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_ncurses_set_max_fps, 0, 1, MAY_BE_LONG|MAY_BE_FALSE)
+	ZEND_ARG_TYPE_INFO(0, fps, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_ncurses_input_stream, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_drain_keys, 0, 0, IS_ARRAY, 0)
+	ZEND_ARG_OBJ_INFO_WITH_DEFAULT_VALUE(0, window, NcursesWindow, 1, "null")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, max, IS_LONG, 0, "0")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_wgetch_batch, 0, 1, IS_ARRAY, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, max, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, timeout_ms, IS_LONG, 0, "0")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_stats, 0, 0, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, reset, _IS_BOOL, 0, "false")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_headless_init, 0, 0, _IS_BOOL, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, rows, IS_LONG, 0, "24")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, cols, IS_LONG, 0, "80")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, term, IS_STRING, 0, "\"xterm\"")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_ncurses_headless_screen, 0, 0, MAY_BE_ARRAY|MAY_BE_FALSE)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, cells, _IS_BOOL, 0, "false")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_ncurses_headless_output, 0, 0, MAY_BE_STRING|MAY_BE_FALSE)
+ZEND_END_ARG_INFO()
+
+#define arginfo_ncurses_scr_dump_string arginfo_ncurses_headless_output
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_scr_restore_string, 0, 1, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, dump, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
+#define arginfo_ncurses_scr_init_string arginfo_ncurses_scr_restore_string
+
+#define arginfo_ncurses_scr_set_string arginfo_ncurses_scr_restore_string
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_ncurses_putwin, 0, 1, MAY_BE_STRING|MAY_BE_FALSE)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_TYPE_MASK_EX(arginfo_ncurses_getwin, 0, 1, NcursesWindow, MAY_BE_FALSE)
+	ZEND_ARG_TYPE_INFO(0, dump, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_wrestore, 0, 2, IS_LONG, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
+	ZEND_ARG_TYPE_INFO(0, dump, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_ncurses_wdraw_table, 0, 3, MAY_BE_LONG|MAY_BE_FALSE)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
+	ZEND_ARG_TYPE_INFO(0, rows, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO(0, columns, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, options, IS_ARRAY, 0, "[]")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_ncurses_color_pair_for, 0, 2, MAY_BE_LONG|MAY_BE_FALSE)
+	ZEND_ARG_TYPE_INFO(0, fg, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, bg, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_ncurses_rgb_to_color, 0, 1, MAY_BE_LONG|MAY_BE_ARRAY|MAY_BE_FALSE)
+	ZEND_ARG_TYPE_MASK(0, rgb, MAY_BE_LONG|MAY_BE_ARRAY, NULL)
+ZEND_END_ARG_INFO()
+
+#define arginfo_ncurses_touchwin arginfo_ncurses_werase
+
+#define arginfo_ncurses_untouchwin arginfo_ncurses_werase
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_wtouchln, 0, 4, IS_LONG, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
+	ZEND_ARG_TYPE_INFO(0, y, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, n, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, changed, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_is_linetouched, 0, 2, _IS_BOOL, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
+	ZEND_ARG_TYPE_INFO(0, line, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+#define arginfo_ncurses_is_wintouched arginfo_ncurses_delwin
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_wredrawln, 0, 3, IS_LONG, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
+	ZEND_ARG_TYPE_INFO(0, beg_line, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, num_lines, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_wdirty_lines, 0, 1, IS_ARRAY, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_ncurses_panels_apply, 0, 1, MAY_BE_LONG|MAY_BE_FALSE)
+	ZEND_ARG_TYPE_INFO(0, ops, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, doupdate, _IS_BOOL, 0, "false")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_TYPE_MASK_EX(arginfo_ncurses_window_panel, 0, 1, NcursesPanel, MAY_BE_FALSE)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_panel_stack, 0, 0, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_TYPE_MASK_EX(arginfo_ncurses_newterm, 0, 3, NcursesScreen, MAY_BE_FALSE)
+	ZEND_ARG_TYPE_INFO(0, type, IS_STRING, 1)
+	ZEND_ARG_INFO(0, output)
+	ZEND_ARG_INFO(0, input)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_set_term, 0, 1, _IS_BOOL, 0)
+	ZEND_ARG_OBJ_INFO(0, screen, NcursesScreen, 1)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_set_input_waiter, 0, 1, _IS_BOOL, 0)
+	ZEND_ARG_TYPE_INFO(0, waiter, IS_CALLABLE, 1)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_getch_async, 0, 0, IS_LONG, 0)
+	ZEND_ARG_OBJ_INFO_WITH_DEFAULT_VALUE(0, window, NcursesWindow, 1, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_record_start, 0, 1, _IS_BOOL, 0)
+	ZEND_ARG_INFO(0, stream)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, title, IS_STRING, 1, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_record_stop, 0, 0, _IS_BOOL, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_ncurses_replay, 0, 1, MAY_BE_ARRAY|MAY_BE_FALSE)
+	ZEND_ARG_INFO(0, stream)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_ncurses_inject, 0, 1, MAY_BE_LONG|MAY_BE_FALSE)
+	ZEND_ARG_TYPE_INFO(0, events, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, interval_ms, IS_LONG, 0, "0")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_ncurses_mouse_sgr, 0, 0, _IS_BOOL, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, enable, _IS_BOOL, 0, "true")
+ZEND_END_ARG_INFO()
+
 static const zend_function_entry ncurses_functions[] = {
 	ZEND_FE(ncurses_addch, arginfo_ncurses_addch)
 	ZEND_FE(ncurses_waddch, arginfo_ncurses_waddch)
@@ -742,6 +905,51 @@ static const zend_function_entry ncurses_functions[] = {
 	ZEND_FE(ncurses_panel_window, arginfo_ncurses_panel_window)
 	ZEND_FE(ncurses_update_panels, arginfo_ncurses_update_panels)
 #endif
+	ZEND_FE(ncurses_frame_begin, arginfo_ncurses_frame_begin)
+	ZEND_FE(ncurses_frame_end, arginfo_ncurses_frame_end)
+	ZEND_FE(ncurses_set_max_fps, arginfo_ncurses_set_max_fps)
+	ZEND_FE(ncurses_input_stream, arginfo_ncurses_input_stream)
+	ZEND_FE(ncurses_drain_keys, arginfo_ncurses_drain_keys)
+	ZEND_FE(ncurses_wgetch_batch, arginfo_ncurses_wgetch_batch)
+	ZEND_FE(ncurses_stats, arginfo_ncurses_stats)
+#ifndef PHP_WIN32
+	ZEND_FE(ncurses_headless_init, arginfo_ncurses_headless_init)
+	ZEND_FE(ncurses_headless_screen, arginfo_ncurses_headless_screen)
+	ZEND_FE(ncurses_headless_output, arginfo_ncurses_headless_output)
+#endif
+#ifndef HAVE_PDCURSESLIB
+	ZEND_FE(ncurses_scr_dump_string, arginfo_ncurses_scr_dump_string)
+	ZEND_FE(ncurses_scr_restore_string, arginfo_ncurses_scr_restore_string)
+	ZEND_FE(ncurses_scr_init_string, arginfo_ncurses_scr_init_string)
+	ZEND_FE(ncurses_scr_set_string, arginfo_ncurses_scr_set_string)
+#endif
+	ZEND_FE(ncurses_putwin, arginfo_ncurses_putwin)
+	ZEND_FE(ncurses_getwin, arginfo_ncurses_getwin)
+	ZEND_FE(ncurses_wrestore, arginfo_ncurses_wrestore)
+	ZEND_FE(ncurses_wdraw_table, arginfo_ncurses_wdraw_table)
+	ZEND_FE(ncurses_color_pair_for, arginfo_ncurses_color_pair_for)
+	ZEND_FE(ncurses_rgb_to_color, arginfo_ncurses_rgb_to_color)
+	ZEND_FE(ncurses_touchwin, arginfo_ncurses_touchwin)
+	ZEND_FE(ncurses_untouchwin, arginfo_ncurses_untouchwin)
+	ZEND_FE(ncurses_wtouchln, arginfo_ncurses_wtouchln)
+	ZEND_FE(ncurses_is_linetouched, arginfo_ncurses_is_linetouched)
+	ZEND_FE(ncurses_is_wintouched, arginfo_ncurses_is_wintouched)
+	ZEND_FE(ncurses_wredrawln, arginfo_ncurses_wredrawln)
+	ZEND_FE(ncurses_wdirty_lines, arginfo_ncurses_wdirty_lines)
+#if HAVE_NCURSES_PANEL
+	ZEND_FE(ncurses_panels_apply, arginfo_ncurses_panels_apply)
+	ZEND_FE(ncurses_window_panel, arginfo_ncurses_window_panel)
+	ZEND_FE(ncurses_panel_stack, arginfo_ncurses_panel_stack)
+#endif
+	ZEND_FE(ncurses_newterm, arginfo_ncurses_newterm)
+	ZEND_FE(ncurses_set_term, arginfo_ncurses_set_term)
+	ZEND_FE(ncurses_set_input_waiter, arginfo_ncurses_set_input_waiter)
+	ZEND_FE(ncurses_getch_async, arginfo_ncurses_getch_async)
+	ZEND_FE(ncurses_record_start, arginfo_ncurses_record_start)
+	ZEND_FE(ncurses_record_stop, arginfo_ncurses_record_stop)
+	ZEND_FE(ncurses_replay, arginfo_ncurses_replay)
+	ZEND_FE(ncurses_inject, arginfo_ncurses_inject)
+	ZEND_FE(ncurses_mouse_sgr, arginfo_ncurses_mouse_sgr)
 	ZEND_FE_END
 };
 
@@ -0,0 +1,477 @@
+/*
+   +----------------------------------------------------------------------+
+   | PHP Version 5                                                        |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1997-2006 The PHP Group                                |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_ini.h"
+#include "php_ncurses.h"
+
+#if PHP_VERSION_ID >= 80000
+#include "ncurses_cellbuffer_arginfo.h"
+
+PHP_NCURSES_API zend_class_entry *php_ncurses_cellbuffer_ce;
+static zend_object_handlers php_ncurses_cellbuffer_handlers;
+
+#define Z_CELLBUFFER_P(zv) php_ncurses_cellbuffer_from_obj(Z_OBJ_P(zv))
+
+/* {{{ php_ncurses_cell_to_chtype */
+static zend_always_inline chtype php_ncurses_cell_to_chtype(const php_ncurses_cell *cell)
+{
+	chtype ch = cell->ch;
+
+	if (ch < 0x20 || (ch >= 0x7f && ch < 0xa0)) {
+		/* never hand control characters, C1 ones included, to the terminal */
+		ch = ' ';
+	} else if (ch > 0xff) {
+		/* only reached without wide character support, see blit() */
+		ch = '?';
+	}
+
+	return ch | ((chtype)cell->attr << PHP_NCURSES_CELL_ATTR_SHIFT) | COLOR_PAIR(cell->pair);
+}
+/* }}} */
+
+#ifdef HAVE_NCURSESW
+/* {{{ php_ncurses_cell_to_cchar
+   Wide counterpart of php_ncurses_cell_to_chtype() for rows with non-ASCII text */
+static zend_always_inline void php_ncurses_cell_to_cchar(const php_ncurses_cell *cell, cchar_t *cc)
+{
+	wchar_t wch[2];
+	uint32_t ch = cell->ch;
+
+	if (ch < 0x20 || (ch >= 0x7f && ch < 0xa0) || (sizeof(wchar_t) == 2 && ch > 0xFFFF)) {
+		ch = ' ';
+	}
+	wch[0] = (wchar_t)ch;
+	wch[1] = L'\0';
+
+	setcchar(cc, wch, (attr_t)cell->attr << PHP_NCURSES_CELL_ATTR_SHIFT, (short)cell->pair, NULL);
+}
+/* }}} */
+#endif
+
+/* {{{ php_ncurses_cells_put
+   Writes n cells into win at y, x without moving the cursor. Runs with
+   non-ASCII text go through the wide functions */
+PHP_NCURSES_API void php_ncurses_cells_put(WINDOW *win, int y, int x, const php_ncurses_cell *cell, int n)
+{
+	chtype line[PHP_NCURSES_CELLS_CHUNK + 1];
+#ifdef HAVE_NCURSESW
+	cchar_t wline[PHP_NCURSES_CELLS_CHUNK + 1];
+#endif
+	int c, len;
+
+	while (n > 0) {
+		len = n < PHP_NCURSES_CELLS_CHUNK ? n : PHP_NCURSES_CELLS_CHUNK;
+#ifdef HAVE_NCURSESW
+		for (c = 0; c < len && cell[c].ch < 0x80; c++);
+		if (c < len) {
+			for (c = 0; c < len; c++) {
+				php_ncurses_cell_to_cchar(&cell[c], &wline[c]);
+			}
+			memset(&wline[len], 0, sizeof(cchar_t));
+			mvwadd_wchnstr(win, y, x, wline, len);
+		} else
+#endif
+		{
+			for (c = 0; c < len; c++) {
+				line[c] = php_ncurses_cell_to_chtype(&cell[c]);
+			}
+			line[len] = 0;
+			mvwaddchnstr(win, y, x, line, len);
+		}
+		cell += len;
+		x += len;
+		n -= len;
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_cell_set_zval
+   Packs an int|string character argument into a cell: a string is UTF-8
+   text whose first code point is taken, an int is a chtype */
+PHP_NCURSES_API void php_ncurses_cell_set_zval(php_ncurses_cell *cell, zval *zch, zend_long attr, zend_long pair)
+{
+	uint32_t cp = ' ';
+
+	if (Z_TYPE_P(zch) == IS_STRING) {
+		if (Z_STRLEN_P(zch) > 0) {
+			php_ncurses_utf8_decode((unsigned char *)Z_STRVAL_P(zch), Z_STRLEN_P(zch), &cp);
+		}
+		php_ncurses_cell_set(cell, cp, attr, pair);
+		return;
+	}
+
+	php_ncurses_cell_set_chtype(cell, (chtype)zval_get_long(zch), attr, pair);
+}
+/* }}} */
+
+static void php_ncurses_cellbuffer_clear(php_ncurses_cellbuffer *buf)
+{
+	size_t i, n = (size_t)buf->rows * buf->cols;
+
+	for (i = 0; i < n; i++) {
+		buf->cells[i].ch = ' ';
+		buf->cells[i].attr = 0;
+		buf->cells[i].pair = 0;
+	}
+}
+
+static zend_object *php_ncurses_cellbuffer_new(zend_class_entry *ce)
+{
+	php_ncurses_cellbuffer *buf = zend_object_alloc(sizeof(php_ncurses_cellbuffer), ce);
+
+	buf->rows = 0;
+	buf->cols = 0;
+	buf->cells = NULL;
+
+	zend_object_std_init(&buf->std, ce);
+	object_properties_init(&buf->std, ce);
+	buf->std.handlers = &php_ncurses_cellbuffer_handlers;
+
+	return &buf->std;
+}
+
+static zend_object *php_ncurses_cellbuffer_clone(zend_object *old_object)
+{
+	php_ncurses_cellbuffer *old_buf = php_ncurses_cellbuffer_from_obj(old_object);
+	zend_object *new_object = php_ncurses_cellbuffer_new(old_object->ce);
+	php_ncurses_cellbuffer *new_buf = php_ncurses_cellbuffer_from_obj(new_object);
+
+	zend_objects_clone_members(new_object, old_object);
+
+	if (old_buf->cells) {
+		size_t n = (size_t)old_buf->rows * old_buf->cols;
+
+		new_buf->rows = old_buf->rows;
+		new_buf->cols = old_buf->cols;
+		new_buf->cells = safe_emalloc(n, sizeof(php_ncurses_cell), 0);
+		memcpy(new_buf->cells, old_buf->cells, n * sizeof(php_ncurses_cell));
+	}
+
+	return new_object;
+}
+
+static void php_ncurses_cellbuffer_free(zend_object *object)
+{
+	php_ncurses_cellbuffer *buf = php_ncurses_cellbuffer_from_obj(object);
+
+	if (buf->cells) {
+		efree(buf->cells);
+	}
+
+	zend_object_std_dtor(&buf->std);
+}
+
+/* {{{ proto NcursesCellBuffer::__construct(int rows, int cols)
+   Creates a buffer of rows x cols blank cells */
+ZEND_METHOD(NcursesCellBuffer, __construct)
+{
+	zend_long rows, cols;
+	php_ncurses_cellbuffer *buf = Z_CELLBUFFER_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "ll", &rows, &cols) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	if (rows < 1 || rows > 0xffff) {
+		zend_argument_value_error(1, "must be between 1 and 65535");
+		RETURN_THROWS();
+	}
+	if (cols < 1 || cols > 0xffff) {
+		zend_argument_value_error(2, "must be between 1 and 65535");
+		RETURN_THROWS();
+	}
+
+	if (buf->cells) {
+		efree(buf->cells);
+	}
+
+	buf->rows = (int)rows;
+	buf->cols = (int)cols;
+	buf->cells = safe_emalloc((size_t)rows, cols * sizeof(php_ncurses_cell), 0);
+	php_ncurses_cellbuffer_clear(buf);
+}
+/* }}} */
+
+/* {{{ proto int NcursesCellBuffer::getRows(void)
+   Returns the number of rows */
+ZEND_METHOD(NcursesCellBuffer, getRows)
+{
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	RETURN_LONG(Z_CELLBUFFER_P(ZEND_THIS)->rows);
+}
+/* }}} */
+
+/* {{{ proto int NcursesCellBuffer::getCols(void)
+   Returns the number of columns */
+ZEND_METHOD(NcursesCellBuffer, getCols)
+{
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	RETURN_LONG(Z_CELLBUFFER_P(ZEND_THIS)->cols);
+}
+/* }}} */
+
+/* {{{ proto bool NcursesCellBuffer::set(int y, int x, int|string ch [, int attr [, int pair]])
+   Sets a single cell to a chtype or to the first UTF-8 character of a string */
+ZEND_METHOD(NcursesCellBuffer, set)
+{
+	zend_long y, x, attr = 0, pair = 0;
+	zval *zch;
+	php_ncurses_cellbuffer *buf = Z_CELLBUFFER_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "llz|ll", &y, &x, &zch, &attr, &pair) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	if (y < 0 || y >= buf->rows || x < 0 || x >= buf->cols) {
+		RETURN_FALSE;
+	}
+
+	php_ncurses_cell_set_zval(&buf->cells[y * buf->cols + x], zch, attr, pair);
+	RETURN_TRUE;
+}
+/* }}} */
+
+/* {{{ proto array|false NcursesCellBuffer::get(int y, int x)
+   Returns a cell as array with the keys ch, attr and pair */
+ZEND_METHOD(NcursesCellBuffer, get)
+{
+	zend_long y, x;
+	php_ncurses_cell *cell;
+	php_ncurses_cellbuffer *buf = Z_CELLBUFFER_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "ll", &y, &x) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	if (y < 0 || y >= buf->rows || x < 0 || x >= buf->cols) {
+		RETURN_FALSE;
+	}
+
+	cell = &buf->cells[y * buf->cols + x];
+
+	array_init_size(return_value, 3);
+	add_assoc_long(return_value, "ch", cell->ch);
+	add_assoc_long(return_value, "attr", (zend_long)cell->attr << PHP_NCURSES_CELL_ATTR_SHIFT);
+	add_assoc_long(return_value, "pair", cell->pair);
+}
+/* }}} */
+
+/* {{{ proto int NcursesCellBuffer::fill(int y, int x, int n, int|string ch [, int attr [, int pair]])
+   Fills n cells of a row starting at y, x (n < 0 fills up to the end of the row) */
+ZEND_METHOD(NcursesCellBuffer, fill)
+{
+	zend_long y, x, n, attr = 0, pair = 0, i;
+	zval *zch;
+	php_ncurses_cell proto, *cell;
+	php_ncurses_cellbuffer *buf = Z_CELLBUFFER_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "lllz|ll", &y, &x, &n, &zch, &attr, &pair) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	if (y < 0 || y >= buf->rows || x >= buf->cols) {
+		RETURN_LONG(0);
+	}
+	if (x < 0) {
+		if (n >= 0) {
+			n += x;
+		}
+		x = 0;
+	}
+	if (n < 0 || n > buf->cols - x) {
+		n = buf->cols - x;
+	}
+
+	php_ncurses_cell_set_zval(&proto, zch, attr, pair);
+
+	cell = &buf->cells[y * buf->cols + x];
+	for (i = 0; i < n; i++) {
+		cell[i] = proto;
+	}
+
+	RETURN_LONG(n);
+}
+/* }}} */
+
+/* {{{ proto int NcursesCellBuffer::write(int y, int x, string text [, int attr [, int pair]])
+   Writes UTF-8 text into a row, one code point per cell, clipped at the end of the row */
+ZEND_METHOD(NcursesCellBuffer, write)
+{
+	zend_long y, x, attr = 0, pair = 0;
+	char *str;
+	size_t str_len, pos = 0;
+	uint32_t cp;
+	int written = 0;
+	php_ncurses_cell *cell;
+	php_ncurses_cellbuffer *buf = Z_CELLBUFFER_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "lls|ll", &y, &x, &str, &str_len, &attr, &pair) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	if (y < 0 || y >= buf->rows) {
+		RETURN_LONG(0);
+	}
+
+	cell = &buf->cells[y * buf->cols];
+	while (pos < str_len && x < buf->cols) {
+		pos += php_ncurses_utf8_decode((unsigned char *)str + pos, str_len - pos, &cp);
+		if (x >= 0) {
+			php_ncurses_cell_set(&cell[x], cp, attr, pair);
+			written++;
+		}
+		x++;
+	}
+
+	RETURN_LONG(written);
+}
+/* }}} */
+
+/* {{{ proto void NcursesCellBuffer::clear(void)
+   Resets all cells to blanks without attributes */
+ZEND_METHOD(NcursesCellBuffer, clear)
+{
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	php_ncurses_cellbuffer_clear(Z_CELLBUFFER_P(ZEND_THIS));
+}
+/* }}} */
+
+/* {{{ proto string NcursesCellBuffer::export(void)
+   Returns the packed cell data */
+ZEND_METHOD(NcursesCellBuffer, export)
+{
+	php_ncurses_cellbuffer *buf = Z_CELLBUFFER_P(ZEND_THIS);
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	RETURN_STRINGL((char *)buf->cells, (size_t)buf->rows * buf->cols * sizeof(php_ncurses_cell));
+}
+/* }}} */
+
+/* {{{ proto bool NcursesCellBuffer::import(string data)
+   Replaces all cells with packed cell data of exactly the same size */
+ZEND_METHOD(NcursesCellBuffer, import)
+{
+	char *data;
+	size_t data_len, size;
+	php_ncurses_cellbuffer *buf = Z_CELLBUFFER_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "s", &data, &data_len) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	size = (size_t)buf->rows * buf->cols * sizeof(php_ncurses_cell);
+	if (data_len != size) {
+		php_error_docref(NULL, E_WARNING, "Expected %zu bytes of cell data, %zu given", size, data_len);
+		RETURN_FALSE;
+	}
+
+	memcpy(buf->cells, data, size);
+	RETURN_TRUE;
+}
+/* }}} */
+
+/* {{{ proto int NcursesCellBuffer::blit(NcursesWindow window [, int y [, int x [, int src_y [, int src_x [, int rows [, int cols]]]]]])
+   Copies a rectangle of cells into window at y, x and returns the number of cells written.
+   The rectangle is clipped to both the buffer and the window, the cursor is not moved */
+ZEND_METHOD(NcursesCellBuffer, blit)
+{
+	zval *handle;
+	zend_long y = 0, x = 0, src_y = 0, src_x = 0, rows = -1, cols = -1;
+	int maxy, maxx, r;
+	WINDOW *win;
+	php_ncurses_cellbuffer *buf = Z_CELLBUFFER_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "O|llllll", &handle, php_ncurses_window_ce, &y, &x, &src_y, &src_x, &rows, &cols) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	FETCH_WINRES(win, &handle);
+
+	if (src_y < 0 || src_y >= buf->rows || src_x < 0 || src_x >= buf->cols) {
+		RETURN_LONG(0);
+	}
+	if (rows < 0 || rows > buf->rows - src_y) {
+		rows = buf->rows - src_y;
+	}
+	if (cols < 0 || cols > buf->cols - src_x) {
+		cols = buf->cols - src_x;
+	}
+
+	/* clip against the window */
+	if (y < 0) {
+		src_y -= y;
+		rows += y;
+		y = 0;
+	}
+	if (x < 0) {
+		src_x -= x;
+		cols += x;
+		x = 0;
+	}
+	getmaxyx(win, maxy, maxx);
+	if (rows > maxy - y) {
+		rows = maxy - y;
+	}
+	if (cols > maxx - x) {
+		cols = maxx - x;
+	}
+	if (rows <= 0 || cols <= 0) {
+		RETURN_LONG(0);
+	}
+
+	for (r = 0; r < rows; r++) {
+		php_ncurses_cells_put(win, (int)(y + r), (int)x, &buf->cells[(src_y + r) * buf->cols + src_x], (int)cols);
+	}
+
+	RETURN_LONG(rows * cols);
+}
+/* }}} */
+
+/* {{{ PHP_MINIT_FUNCTION
+ */
+PHP_MINIT_FUNCTION(ncurses_cellbuffer)
+{
+	php_ncurses_cellbuffer_ce = register_class_NcursesCellBuffer();
+	php_ncurses_cellbuffer_ce->create_object = php_ncurses_cellbuffer_new;
+
+	memcpy(&php_ncurses_cellbuffer_handlers, &std_object_handlers, sizeof(zend_object_handlers));
+	php_ncurses_cellbuffer_handlers.offset = XtOffsetOf(php_ncurses_cellbuffer, std);
+	php_ncurses_cellbuffer_handlers.free_obj = php_ncurses_cellbuffer_free;
+	php_ncurses_cellbuffer_handlers.clone_obj = php_ncurses_cellbuffer_clone;
+
+	return SUCCESS;
+}
+/* }}} */
+
+#endif /* PHP_VERSION_ID >= 80000 */
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
@@ -0,0 +1,31 @@
+<?php
+
+/** @generate-class-entries */
+
+/** @strict-properties */
+final class NcursesCellBuffer
+{
+	public function __construct(int $rows, int $cols) {}
+
+	public function getRows(): int {}
+
+	public function getCols(): int {}
+
+	public function set(int $y, int $x, int|string $ch, int $attr = 0, int $pair = 0): bool {}
+
+	public function get(int $y, int $x): array|false {}
+
+	public function fill(int $y, int $x, int $n, int|string $ch, int $attr = 0, int $pair = 0): int {}
+
+	public function write(int $y, int $x, string $text, int $attr = 0, int $pair = 0): int {}
+
+	public function clear(): void {}
+
+	public function export(): string {}
+
+	public function import(string $data): bool {}
+
+	public function blit(NcursesWindow $window, int $y = 0, int $x = 0, int $src_y = 0, int $src_x = 0, int $rows = -1, int $cols = -1): int {}
+}
+
+?>
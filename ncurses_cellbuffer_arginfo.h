@@ -0,0 +1,102 @@
+/* This is a generated file, edit the .stub.php file instead.
+ * Stub hash: eadce12ee46296c653e22e5f9014069ac2f6c53e */
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_class_NcursesCellBuffer___construct, 0, 0, 2)
+	ZEND_ARG_TYPE_INFO(0, rows, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, cols, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesCellBuffer_getRows, 0, 0, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+#define arginfo_class_NcursesCellBuffer_getCols arginfo_class_NcursesCellBuffer_getRows
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesCellBuffer_set, 0, 3, _IS_BOOL, 0)
+	ZEND_ARG_TYPE_INFO(0, y, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, x, IS_LONG, 0)
+	ZEND_ARG_TYPE_MASK(0, ch, MAY_BE_LONG|MAY_BE_STRING, NULL)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, attr, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, pair, IS_LONG, 0, "0")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_class_NcursesCellBuffer_get, 0, 2, MAY_BE_ARRAY|MAY_BE_FALSE)
+	ZEND_ARG_TYPE_INFO(0, y, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, x, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesCellBuffer_fill, 0, 4, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, y, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, x, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, n, IS_LONG, 0)
+	ZEND_ARG_TYPE_MASK(0, ch, MAY_BE_LONG|MAY_BE_STRING, NULL)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, attr, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, pair, IS_LONG, 0, "0")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesCellBuffer_write, 0, 3, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, y, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, x, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, text, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, attr, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, pair, IS_LONG, 0, "0")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesCellBuffer_clear, 0, 0, IS_VOID, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesCellBuffer_export, 0, 0, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesCellBuffer_import, 0, 1, _IS_BOOL, 0)
+	ZEND_ARG_TYPE_INFO(0, data, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesCellBuffer_blit, 0, 1, IS_LONG, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, y, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, x, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, src_y, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, src_x, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, rows, IS_LONG, 0, "-1")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, cols, IS_LONG, 0, "-1")
+ZEND_END_ARG_INFO()
+
+
+ZEND_METHOD(NcursesCellBuffer, __construct);
+ZEND_METHOD(NcursesCellBuffer, getRows);
+ZEND_METHOD(NcursesCellBuffer, getCols);
+ZEND_METHOD(NcursesCellBuffer, set);
+ZEND_METHOD(NcursesCellBuffer, get);
+ZEND_METHOD(NcursesCellBuffer, fill);
+ZEND_METHOD(NcursesCellBuffer, write);
+ZEND_METHOD(NcursesCellBuffer, clear);
+ZEND_METHOD(NcursesCellBuffer, export);
+ZEND_METHOD(NcursesCellBuffer, import);
+ZEND_METHOD(NcursesCellBuffer, blit);
+
+
+static const zend_function_entry class_NcursesCellBuffer_methods[] = {
+	ZEND_ME(NcursesCellBuffer, __construct, arginfo_class_NcursesCellBuffer___construct, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesCellBuffer, getRows, arginfo_class_NcursesCellBuffer_getRows, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesCellBuffer, getCols, arginfo_class_NcursesCellBuffer_getCols, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesCellBuffer, set, arginfo_class_NcursesCellBuffer_set, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesCellBuffer, get, arginfo_class_NcursesCellBuffer_get, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesCellBuffer, fill, arginfo_class_NcursesCellBuffer_fill, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesCellBuffer, write, arginfo_class_NcursesCellBuffer_write, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesCellBuffer, clear, arginfo_class_NcursesCellBuffer_clear, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesCellBuffer, export, arginfo_class_NcursesCellBuffer_export, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesCellBuffer, import, arginfo_class_NcursesCellBuffer_import, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesCellBuffer, blit, arginfo_class_NcursesCellBuffer_blit, ZEND_ACC_PUBLIC)
+	ZEND_FE_END
+};
+
+static zend_class_entry *register_class_NcursesCellBuffer(void)
+{
+	zend_class_entry ce, *class_entry;
+
+	INIT_CLASS_ENTRY(ce, "NcursesCellBuffer", class_NcursesCellBuffer_methods);
+	class_entry = zend_register_internal_class_ex(&ce, NULL);
+	class_entry->ce_flags |= ZEND_ACC_FINAL|ZEND_ACC_NO_DYNAMIC_PROPERTIES;
+
+	return class_entry;
+}
@@ -0,0 +1,532 @@
+/*
+   +----------------------------------------------------------------------+
+   | PHP Version 5                                                        |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1997-2006 The PHP Group                                |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_ini.h"
+#include "php_ncurses.h"
+
+#include <limits.h>
+
+/* Color pair allocator behind ncurses_color_pair_for().
+ *
+ * Pairs are handed out from 255 downwards, so that pairs an application
+ * sets up by hand with ncurses_init_pair() from 1 upwards rarely collide
+ * with it; when they do, ncurses_init_pair() reserves the pair and the
+ * allocator never touches it again. Higher pairs are left alone even on
+ * terminals with more, as COLOR_PAIR() only encodes 8 bits of a pair in
+ * a chtype. Every (fg, bg) combination is looked up in a chained hash and
+ * kept on a list ordered by last use. Once all pairs are taken the least
+ * recently used one is redefined, which also recolors cells still drawn
+ * with it. */
+
+#define PHP_NCURSES_PAIR_NONE INT_MIN
+#define PHP_NCURSES_PAIR_MAX  255
+
+typedef struct _php_ncurses_pair_slot {
+	int fg;
+	int bg;
+	int hnext;  /* next slot in the same bucket, -1 at the end */
+	int prev;   /* neighbours on the LRU list, -1 at the ends */
+	int next;
+	int reserved;  /* defined by ncurses_init_pair(), neither hashed nor listed */
+} php_ncurses_pair_slot;
+
+struct _php_ncurses_pairs {
+	int                    capacity;  /* slot i is pair capacity - i */
+	int                    used;
+	unsigned int           mask;
+	int                   *buckets;
+	php_ncurses_pair_slot *slots;
+	int                    head;      /* most recently used */
+	int                    tail;
+};
+
+static inline unsigned int php_ncurses_pair_hash(int fg, int bg)
+{
+	return ((unsigned int)(fg + 1) * 0x9E3779B1U) ^ (unsigned int)(bg + 1);
+}
+
+/* {{{ php_ncurses_pairs_create */
+static struct _php_ncurses_pairs *php_ncurses_pairs_create(int capacity)
+{
+	struct _php_ncurses_pairs *p = pemalloc(sizeof(*p), 1);
+	unsigned int buckets = 16;
+
+	while (buckets < (unsigned int)capacity) {
+		buckets <<= 1;
+	}
+
+	p->capacity = capacity;
+	p->used = 0;
+	p->mask = buckets - 1;
+	p->buckets = pemalloc(buckets * sizeof(int), 1);
+	memset(p->buckets, -1, buckets * sizeof(int));
+	p->slots = pecalloc(capacity, sizeof(php_ncurses_pair_slot), 1);
+	p->head = p->tail = -1;
+
+	return p;
+}
+/* }}} */
+
+static void php_ncurses_pairs_lru_unlink(struct _php_ncurses_pairs *p, int i)
+{
+	php_ncurses_pair_slot *s = &p->slots[i];
+
+	if (s->prev >= 0) {
+		p->slots[s->prev].next = s->next;
+	} else {
+		p->head = s->next;
+	}
+	if (s->next >= 0) {
+		p->slots[s->next].prev = s->prev;
+	} else {
+		p->tail = s->prev;
+	}
+}
+
+static void php_ncurses_pairs_lru_push(struct _php_ncurses_pairs *p, int i, int front)
+{
+	php_ncurses_pair_slot *s = &p->slots[i];
+
+	if (front) {
+		s->prev = -1;
+		s->next = p->head;
+		if (p->head >= 0) {
+			p->slots[p->head].prev = i;
+		}
+		p->head = i;
+		if (p->tail < 0) {
+			p->tail = i;
+		}
+	} else {
+		s->next = -1;
+		s->prev = p->tail;
+		if (p->tail >= 0) {
+			p->slots[p->tail].next = i;
+		}
+		p->tail = i;
+		if (p->head < 0) {
+			p->head = i;
+		}
+	}
+}
+
+/* {{{ php_ncurses_pairs_hash_unlink
+   Removes slot i from its bucket, if it is in one */
+static void php_ncurses_pairs_hash_unlink(struct _php_ncurses_pairs *p, int i)
+{
+	php_ncurses_pair_slot *s = &p->slots[i];
+	int *link;
+
+	if (s->fg == PHP_NCURSES_PAIR_NONE) {
+		return;
+	}
+
+	link = &p->buckets[php_ncurses_pair_hash(s->fg, s->bg) & p->mask];
+	while (*link >= 0) {
+		if (*link == i) {
+			*link = s->hnext;
+			break;
+		}
+		link = &p->slots[*link].hnext;
+	}
+	s->fg = s->bg = PHP_NCURSES_PAIR_NONE;
+}
+/* }}} */
+
+/* {{{ php_ncurses_pairs_reset
+   Forgets all pairs, they are meaningless on a new screen */
+PHP_NCURSES_API void php_ncurses_pairs_reset(void)
+{
+	struct _php_ncurses_pairs *p = NCURSES_G(pairs);
+
+	if (p) {
+		pefree(p->buckets, 1);
+		pefree(p->slots, 1);
+		pefree(p, 1);
+		NCURSES_G(pairs) = NULL;
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_pairs_get
+   Returns the allocator of the current screen, NULL if there are no pairs */
+static struct _php_ncurses_pairs *php_ncurses_pairs_get(void)
+{
+	int capacity;
+
+	if (NCURSES_G(pairs) == NULL) {
+		capacity = MIN(COLOR_PAIRS - 1, PHP_NCURSES_PAIR_MAX);
+		if (capacity < 1) {
+			return NULL;
+		}
+		NCURSES_G(pairs) = php_ncurses_pairs_create(capacity);
+	}
+	return NCURSES_G(pairs);
+}
+/* }}} */
+
+/* {{{ php_ncurses_pairs_forget
+   Takes pair away from the allocator for good after it was defined by hand */
+PHP_NCURSES_API void php_ncurses_pairs_forget(int pair)
+{
+	struct _php_ncurses_pairs *p = php_ncurses_pairs_get();
+	int i;
+
+	if (p == NULL || pair < 1 || pair > p->capacity) {
+		return;
+	}
+
+	i = p->capacity - pair;
+	if (p->slots[i].reserved) {
+		return;
+	}
+	if (i < p->used) {
+		php_ncurses_pairs_hash_unlink(p, i);
+		php_ncurses_pairs_lru_unlink(p, i);
+	}
+	p->slots[i].reserved = 1;
+}
+/* }}} */
+
+/* {{{ php_ncurses_pair_for
+   Returns the pair showing fg on bg, defining one if needed, -1 on failure */
+PHP_NCURSES_API int php_ncurses_pair_for(int fg, int bg)
+{
+	struct _php_ncurses_pairs *p = php_ncurses_pairs_get();
+	php_ncurses_pair_slot *s;
+	unsigned int bucket;
+	int i;
+
+	if (p == NULL) {
+		return -1;
+	}
+
+	bucket = php_ncurses_pair_hash(fg, bg) & p->mask;
+	for (i = p->buckets[bucket]; i >= 0; i = p->slots[i].hnext) {
+		if (p->slots[i].fg == fg && p->slots[i].bg == bg) {
+			if (p->head != i) {
+				php_ncurses_pairs_lru_unlink(p, i);
+				php_ncurses_pairs_lru_push(p, i, 1);
+			}
+			return p->capacity - i;
+		}
+	}
+
+	while (p->used < p->capacity && p->slots[p->used].reserved) {
+		p->used++;
+	}
+	if (p->used < p->capacity) {
+		i = p->used++;
+		p->slots[i].fg = p->slots[i].bg = PHP_NCURSES_PAIR_NONE;
+	} else if (p->tail < 0) {
+		/* every pair was defined by hand */
+		return -1;
+	} else {
+		i = p->tail;
+		php_ncurses_pairs_hash_unlink(p, i);
+		php_ncurses_pairs_lru_unlink(p, i);
+	}
+
+	if (init_pair((short)(p->capacity - i), (short)fg, (short)bg) == ERR) {
+		/* keep the slot, but as the first one to be reused */
+		php_ncurses_pairs_lru_push(p, i, 0);
+		return -1;
+	}
+
+	s = &p->slots[i];
+	s->fg = fg;
+	s->bg = bg;
+	s->hnext = p->buckets[bucket];
+	p->buckets[bucket] = i;
+	php_ncurses_pairs_lru_push(p, i, 1);
+
+	return p->capacity - i;
+}
+/* }}} */
+
+/* {{{ proto int ncurses_color_pair_for(int fg, int bg)
+   Returns a color pair showing fg on bg, allocated on first use */
+PHP_FUNCTION(ncurses_color_pair_for)
+{
+	zend_long fg, bg;
+	int pair;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "ll", &fg, &bg) == FAILURE) {
+		return;
+	}
+	IS_NCURSES_INITIALIZED();
+
+	if (COLOR_PAIRS < 2) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Colors are not available, call ncurses_start_color() first");
+		RETURN_FALSE;
+	}
+	if (fg < -1 || fg >= COLORS || bg < -1 || bg >= COLORS) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Colors must be between -1 and %d", COLORS - 1);
+		RETURN_FALSE;
+	}
+
+	if ((pair = php_ncurses_pair_for((int)fg, (int)bg)) < 0) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Unable to define a color pair for %d on %d", (int)fg, (int)bg);
+		RETURN_FALSE;
+	}
+
+	RETURN_LONG(pair);
+}
+/* }}} */
+
+/* Quantizer behind ncurses_rgb_to_color().
+ *
+ * The palette holds the colors quantization may pick from, 0..255 per
+ * channel. With 256 or 88 colors it is the xterm color cube and gray ramp;
+ * the 16 system colors are left out because terminal themes change them.
+ * With fewer colors the values reported by color_content() are used.
+ * Colors redefined with ncurses_init_color() replace their entry. Every
+ * RGB value is mapped through a table of the nearest color for each
+ * 5 bit per channel cell, built on first use. */
+
+#define PHP_NCURSES_LUT_BITS 5
+#define PHP_NCURSES_LUT_SIZE (1 << (3 * PHP_NCURSES_LUT_BITS))
+
+struct _php_ncurses_palette {
+	int            first;           /* lowest color quantization picks */
+	int            count;           /* colors in rgb */
+	unsigned char  rgb[256][3];
+	unsigned char *lut;             /* nearest color per cell, NULL until needed */
+};
+
+static void php_ncurses_palette_xterm(struct _php_ncurses_palette *pal, const unsigned char *levels, int n, const unsigned char *grays, int ngrays)
+{
+	int r, g, b, i = 16;
+
+	for (r = 0; r < n; r++) {
+		for (g = 0; g < n; g++) {
+			for (b = 0; b < n; b++, i++) {
+				pal->rgb[i][0] = levels[r];
+				pal->rgb[i][1] = levels[g];
+				pal->rgb[i][2] = levels[b];
+			}
+		}
+	}
+	for (r = 0; r < ngrays; r++, i++) {
+		pal->rgb[i][0] = pal->rgb[i][1] = pal->rgb[i][2] = grays[r];
+	}
+}
+
+/* {{{ php_ncurses_palette_get
+   Returns the palette of the current screen, NULL before start_color() */
+static struct _php_ncurses_palette *php_ncurses_palette_get(void)
+{
+	static const unsigned char cube256[] = { 0, 95, 135, 175, 215, 255 };
+	static const unsigned char cube88[] = { 0, 139, 205, 255 };
+	static const unsigned char grays88[] = { 46, 92, 115, 139, 162, 185, 208, 231 };
+	struct _php_ncurses_palette *pal = NCURSES_G(palette);
+	short r, g, b;
+	int i;
+
+	if (pal || COLORS < 2) {
+		return pal;
+	}
+
+	pal = pemalloc(sizeof(*pal), 1);
+	memset(pal, 0, sizeof(*pal));
+
+	if (COLORS >= 256) {
+		unsigned char grays[24];
+
+		for (i = 0; i < 24; i++) {
+			grays[i] = 8 + 10 * i;
+		}
+		pal->first = 16;
+		pal->count = 256;
+		php_ncurses_palette_xterm(pal, cube256, 6, grays, 24);
+	} else if (COLORS == 88) {
+		pal->first = 16;
+		pal->count = 88;
+		php_ncurses_palette_xterm(pal, cube88, 4, grays88, 8);
+	} else {
+		pal->first = 0;
+		pal->count = COLORS;
+		for (i = 0; i < pal->count; i++) {
+			if (color_content((short)i, &r, &g, &b) == ERR) {
+				r = g = b = 0;
+			}
+			pal->rgb[i][0] = (unsigned char)(r * 255 / 1000);
+			pal->rgb[i][1] = (unsigned char)(g * 255 / 1000);
+			pal->rgb[i][2] = (unsigned char)(b * 255 / 1000);
+		}
+	}
+
+	NCURSES_G(palette) = pal;
+	return pal;
+}
+/* }}} */
+
+/* {{{ php_ncurses_palette_nearest */
+static int php_ncurses_palette_nearest(const struct _php_ncurses_palette *pal, int r, int g, int b)
+{
+	int i, best = pal->first, dr, dg, db;
+	long d, best_d = LONG_MAX;
+
+	for (i = pal->first; i < pal->count; i++) {
+		dr = r - pal->rgb[i][0];
+		dg = g - pal->rgb[i][1];
+		db = b - pal->rgb[i][2];
+		/* the eye is most sensitive to green and least to blue */
+		d = 3L * dr * dr + 4L * dg * dg + 2L * db * db;
+		if (d < best_d) {
+			best_d = d;
+			best = i;
+		}
+	}
+
+	return best;
+}
+/* }}} */
+
+/* {{{ php_ncurses_palette_lut */
+static const unsigned char *php_ncurses_palette_lut(struct _php_ncurses_palette *pal)
+{
+	int cell, shift = 8 - PHP_NCURSES_LUT_BITS, mask = (1 << PHP_NCURSES_LUT_BITS) - 1, half = 1 << (shift - 1);
+
+	if (pal->lut == NULL) {
+		pal->lut = pemalloc(PHP_NCURSES_LUT_SIZE, 1);
+		for (cell = 0; cell < PHP_NCURSES_LUT_SIZE; cell++) {
+			pal->lut[cell] = (unsigned char)php_ncurses_palette_nearest(pal,
+				((cell >> (2 * PHP_NCURSES_LUT_BITS)) << shift) + half,
+				(((cell >> PHP_NCURSES_LUT_BITS) & mask) << shift) + half,
+				((cell & mask) << shift) + half);
+		}
+	}
+
+	return pal->lut;
+}
+/* }}} */
+
+static inline int php_ncurses_lut_lookup(const unsigned char *lut, zend_long rgb)
+{
+	int shift = 8 - PHP_NCURSES_LUT_BITS;
+
+	return lut[((((rgb >> 16) & 0xff) >> shift) << (2 * PHP_NCURSES_LUT_BITS))
+		| ((((rgb >> 8) & 0xff) >> shift) << PHP_NCURSES_LUT_BITS)
+		| ((rgb & 0xff) >> shift)];
+}
+
+/* {{{ php_ncurses_palette_set
+   Records that color was redefined, r, g and b range from 0 to 1000 */
+PHP_NCURSES_API void php_ncurses_palette_set(int color, int r, int g, int b)
+{
+	struct _php_ncurses_palette *pal = php_ncurses_palette_get();
+
+	if (pal == NULL || color < pal->first || color >= pal->count) {
+		return;
+	}
+
+	pal->rgb[color][0] = (unsigned char)(r * 255 / 1000);
+	pal->rgb[color][1] = (unsigned char)(g * 255 / 1000);
+	pal->rgb[color][2] = (unsigned char)(b * 255 / 1000);
+	if (pal->lut) {
+		pefree(pal->lut, 1);
+		pal->lut = NULL;
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_palette_reset */
+PHP_NCURSES_API void php_ncurses_palette_reset(void)
+{
+	struct _php_ncurses_palette *pal = NCURSES_G(palette);
+
+	if (pal) {
+		if (pal->lut) {
+			pefree(pal->lut, 1);
+		}
+		pefree(pal, 1);
+		NCURSES_G(palette) = NULL;
+	}
+}
+/* }}} */
+
+#if PHP_MAJOR_VERSION >= 7
+/* {{{ proto int|array ncurses_rgb_to_color(int|array rgb)
+   Returns the terminal color nearest to 0xRRGGBB, or an array of them for
+   an array of values with the same keys */
+PHP_FUNCTION(ncurses_rgb_to_color)
+{
+	zval *zrgb, *entry;
+	zend_string *key;
+	zend_ulong index;
+	struct _php_ncurses_palette *pal;
+	const unsigned char *lut = NULL;
+	int direct;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "z", &zrgb) == FAILURE) {
+		return;
+	}
+	IS_NCURSES_INITIALIZED();
+
+	if (Z_TYPE_P(zrgb) != IS_ARRAY && Z_TYPE_P(zrgb) != IS_LONG) {
+#if PHP_VERSION_ID >= 80000
+		zend_argument_type_error(1, "must be of type array|int, %s given", zend_zval_type_name(zrgb));
+		return;
+#else
+		convert_to_long(zrgb);
+#endif
+	}
+
+	if ((pal = php_ncurses_palette_get()) == NULL) {
+		php_error_docref(NULL, E_WARNING, "Colors are not available, call ncurses_start_color() first");
+		RETURN_FALSE;
+	}
+
+	/* direct color terminals take the RGB value as color number */
+	direct = COLORS >= 0x1000000;
+	if (!direct) {
+		lut = php_ncurses_palette_lut(pal);
+	}
+
+	if (Z_TYPE_P(zrgb) == IS_LONG) {
+		RETURN_LONG(direct ? (Z_LVAL_P(zrgb) & 0xffffff) : php_ncurses_lut_lookup(lut, Z_LVAL_P(zrgb)));
+	}
+
+	array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL_P(zrgb)));
+	ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(zrgb), index, key, entry) {
+		zval color;
+		zend_long rgb = zval_get_long(entry);
+
+		ZVAL_LONG(&color, direct ? (rgb & 0xffffff) : php_ncurses_lut_lookup(lut, rgb));
+		if (key) {
+			zend_hash_add_new(Z_ARRVAL_P(return_value), key, &color);
+		} else {
+			zend_hash_index_add_new(Z_ARRVAL_P(return_value), index, &color);
+		}
+	} ZEND_HASH_FOREACH_END();
+}
+/* }}} */
+#endif
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
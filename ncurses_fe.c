@@ -258,6 +258,67 @@ zend_function_entry ncurses_functions[] = {
 	PHP_FE(ncurses_new_panel,	NULL)
 #endif
 
+	PHP_FE(ncurses_frame_begin,	NULL)
+	PHP_FE(ncurses_frame_end,	NULL)
+	PHP_FE(ncurses_set_max_fps,	NULL)
+
+	PHP_FE(ncurses_input_stream,	NULL)
+	PHP_FE(ncurses_drain_keys,	NULL)
+	PHP_FE(ncurses_wgetch_batch,	NULL)
+
+	PHP_FE(ncurses_stats,	NULL)
+
+#if PHP_MAJOR_VERSION >= 7 && !defined(PHP_WIN32)
+	PHP_FE(ncurses_headless_init,	NULL)
+	PHP_FE(ncurses_headless_screen,	NULL)
+	PHP_FE(ncurses_headless_output,	NULL)
+#endif
+
+#ifndef HAVE_PDCURSESLIB
+	PHP_FE(ncurses_scr_dump_string,	NULL)
+	PHP_FE(ncurses_scr_restore_string,	NULL)
+	PHP_FE(ncurses_scr_init_string,	NULL)
+	PHP_FE(ncurses_scr_set_string,	NULL)
+#endif
+	PHP_FE(ncurses_putwin,	NULL)
+	PHP_FE(ncurses_getwin,	NULL)
+	PHP_FE(ncurses_wrestore,	NULL)
+
+#if PHP_MAJOR_VERSION >= 7
+	PHP_FE(ncurses_wdraw_table,	NULL)
+#endif
+
+	PHP_FE(ncurses_color_pair_for,	NULL)
+#if PHP_MAJOR_VERSION >= 7
+	PHP_FE(ncurses_rgb_to_color,	NULL)
+#endif
+
+	PHP_FE(ncurses_touchwin,	NULL)
+	PHP_FE(ncurses_untouchwin,	NULL)
+	PHP_FE(ncurses_wtouchln,	NULL)
+	PHP_FE(ncurses_is_linetouched,	NULL)
+	PHP_FE(ncurses_is_wintouched,	NULL)
+	PHP_FE(ncurses_wredrawln,	NULL)
+	PHP_FE(ncurses_wdirty_lines,	NULL)
+
+#if HAVE_NCURSES_PANEL && PHP_MAJOR_VERSION >= 7
+	PHP_FE(ncurses_panels_apply,	NULL)
+	PHP_FE(ncurses_window_panel,	NULL)
+	PHP_FE(ncurses_panel_stack,	NULL)
+#endif
+
+#if PHP_MAJOR_VERSION >= 7
+	PHP_FE(ncurses_set_input_waiter,	NULL)
+	PHP_FE(ncurses_getch_async,	NULL)
+
+	PHP_FE(ncurses_record_start,	NULL)
+	PHP_FE(ncurses_record_stop,	NULL)
+	PHP_FE(ncurses_replay,	NULL)
+	PHP_FE(ncurses_inject,	NULL)
+#endif
+
+	PHP_FE(ncurses_mouse_sgr,	NULL)
+
   {NULL, NULL, NULL}  /* Must be the last line in ncurses_functions[] */
 };
 
@@ -24,32 +24,443 @@
 #include "php.h"
 #include "php_ini.h"
 #include "php_ncurses.h"
+#if PHP_VERSION_ID >= 80100
+# include "zend_interfaces.h"
+# include "zend_fibers.h"
+#endif
 
-#if PHP_MAJOR_VERSION >= 7
-#define FETCH_WINRES(r, z) \
-	if (NULL == ((r) = (WINDOW **)zend_fetch_resource(Z_RES_P(*(z)), "ncurses_window", le_ncurses_windows))) { \
-		RETURN_FALSE; \
+#include <errno.h>
+#include <locale.h>
+
+#ifdef PHP_WIN32
+# include "win32/time.h"
+#else
+# include <sys/time.h>
+# include <unistd.h>
+#endif
+
+/* {{{ php_ncurses_now */
+PHP_NCURSES_API double php_ncurses_now(void)
+{
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0;
+}
+/* }}} */
+
+/* {{{ php_ncurses_input_fd
+   Returns the descriptor curses reads keys from */
+PHP_NCURSES_API int php_ncurses_input_fd(void)
+{
+	return NCURSES_G(input_fd);
+}
+/* }}} */
+
+/* {{{ php_ncurses_utf8_decode
+   Decodes one UTF-8 sequence, invalid bytes are taken as their byte value */
+PHP_NCURSES_API size_t php_ncurses_utf8_decode(const unsigned char *s, size_t len, uint32_t *cp)
+{
+	size_t n, i;
+	uint32_t c = s[0];
+
+	if (c < 0x80) {
+		*cp = c;
+		return 1;
+	} else if ((c & 0xE0) == 0xC0) {
+		n = 2;
+		c &= 0x1F;
+	} else if ((c & 0xF0) == 0xE0) {
+		n = 3;
+		c &= 0x0F;
+	} else if ((c & 0xF8) == 0xF0) {
+		n = 4;
+		c &= 0x07;
+	} else {
+		*cp = s[0];
+		return 1;
 	}
-#if HAVE_NCURSES_PANEL
-# define FETCH_PANEL(r, z) \
-	if (NULL == ((r) = (PANEL **)zend_fetch_resource(Z_RES_P(*(z)), "ncurses_panel", le_ncurses_panels))) { \
-		RETURN_FALSE; \
+
+	if (n > len) {
+		*cp = s[0];
+		return 1;
+	}
+	for (i = 1; i < n; i++) {
+		if ((s[i] & 0xC0) != 0x80) {
+			*cp = s[0];
+			return 1;
+		}
+		c = (c << 6) | (s[i] & 0x3F);
+	}
+
+	*cp = c;
+	return n;
+}
+/* }}} */
+
+/* {{{ php_ncurses_setup_locale
+   Makes sure LC_CTYPE is set before curses starts, the wide character
+   library picks its output encoding from it. PHP 8 no longer inherits the
+   locale from the environment, so "C" is replaced by the environment locale,
+   or by C.UTF-8 with force_utf8 when the environment has none either */
+PHP_NCURSES_API void php_ncurses_setup_locale(int force_utf8)
+{
+#ifdef HAVE_NCURSESW
+	const char *current = setlocale(LC_CTYPE, NULL);
+
+	if (current && strcmp(current, "C") && strcmp(current, "POSIX")) {
+		return;
+	}
+
+	current = setlocale(LC_CTYPE, "");
+	if (force_utf8 && (!current || !strcmp(current, "C") || !strcmp(current, "POSIX"))) {
+		setlocale(LC_CTYPE, "C.UTF-8");
+	}
+# if PHP_VERSION_ID >= 80000
+	zend_update_current_locale();
+# endif
+#endif
+}
+/* }}} */
+
+/* {{{ php_ncurses_is_ascii
+   Checks a word at a time whether str contains only 7 bit characters */
+static zend_always_inline int php_ncurses_is_ascii(const char *str, size_t len)
+{
+	const unsigned char *p = (const unsigned char *)str, *end = p + len;
+	const zend_ulong high = (~(zend_ulong)0 / 0xff) * 0x80;
+	zend_ulong word;
+
+	while ((size_t)(end - p) >= sizeof(word)) {
+		memcpy(&word, p, sizeof(word));
+		if (word & high) {
+			return 0;
+		}
+		p += sizeof(word);
+	}
+	while (p < end) {
+		if (*p++ & 0x80) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+/* }}} */
+
+/* {{{ php_ncurses_put_piece
+   Adds or inserts len bytes without NUL, at most *left characters unless
+   *left is negative. ASCII goes through the byte functions, everything else
+   is converted from UTF-8 once and goes through the wide ones */
+static int php_ncurses_put_piece(WINDOW *win, const char *str, size_t len, zend_long *left, int insert)
+{
+#ifdef HAVE_NCURSESW
+	wchar_t stack[256], *wstr;
+	size_t pos = 0, wlen = 0;
+	uint32_t cp;
+	int ret;
+
+	if (!php_ncurses_is_ascii(str, len)) {
+		wstr = len < sizeof(stack) / sizeof(wchar_t) ? stack : safe_emalloc(len + 1, sizeof(wchar_t), 0);
+
+		while (pos < len && (*left < 0 || (zend_long)wlen < *left)) {
+			pos += php_ncurses_utf8_decode((const unsigned char *)str + pos, len - pos, &cp);
+			if (sizeof(wchar_t) == 2 && cp > 0xFFFF) {
+				cp = 0xFFFD;
+			}
+			wstr[wlen++] = (wchar_t)cp;
+		}
+		wstr[wlen] = L'\0';
+
+		ret = insert ? wins_nwstr(win, wstr, (int)wlen) : waddnwstr(win, wstr, (int)wlen);
+		if (*left >= 0) {
+			*left -= wlen;
+		}
+		if (wstr != stack) {
+			efree(wstr);
+		}
+		return ret;
+	}
+#endif
+
+	if (*left >= 0) {
+		if ((size_t)*left < len) {
+			len = (size_t)*left;
+		}
+		*left -= len;
+	}
+	return insert ? winsnstr(win, str, (int)len) : waddnstr(win, str, (int)len);
+}
+/* }}} */
+
+/* {{{ php_ncurses_waddnstr
+   Adds len bytes of UTF-8 text at the cursor of win, at most n characters
+   unless n is negative. Unlike waddstr() the length is known up front and
+   embedded NUL bytes are shown as ^@ instead of ending the text */
+PHP_NCURSES_API int php_ncurses_waddnstr(WINDOW *win, const char *str, size_t len, zend_long n)
+{
+	const char *nul;
+	size_t piece;
+	int ret = OK;
+
+	for (;;) {
+		nul = memchr(str, '\0', len);
+		piece = nul ? (size_t)(nul - str) : len;
+
+		if (piece && (ret = php_ncurses_put_piece(win, str, piece, &n, 0)) == ERR) {
+			return ERR;
+		}
+		if (!nul || n == 0) {
+			return ret;
+		}
+		if ((ret = waddch(win, 0)) == ERR) {
+			return ERR;
+		}
+		if (n > 0) {
+			n--;
+		}
+		str = nul + 1;
+		len -= piece + 1;
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_winsnstr
+   Inserts len bytes of UTF-8 text at the cursor of win, see php_ncurses_waddnstr() */
+PHP_NCURSES_API int php_ncurses_winsnstr(WINDOW *win, const char *str, size_t len)
+{
+	zend_long all = -1;
+	size_t end = len, i = len;
+
+	/* insertion does not move the cursor, so go from the last piece to the first */
+	while (i-- > 0) {
+		if (str[i] != '\0') {
+			continue;
+		}
+		if (end > i + 1 && php_ncurses_put_piece(win, str + i + 1, end - i - 1, &all, 1) == ERR) {
+			return ERR;
+		}
+		if (winsch(win, 0) == ERR) {
+			return ERR;
+		}
+		end = i;
 	}
+
+	return end ? php_ncurses_put_piece(win, str, end, &all, 1) : OK;
+}
+/* }}} */
+
+/* {{{ php_ncurses_mevent_to_zval
+   Fills arr with the fields of a mouse event, as returned by ncurses_getmouse() */
+static void php_ncurses_mevent_to_zval(zval *arr, MEVENT *mevent)
+{
+	add_assoc_long(arr, "id", mevent->id);
+	add_assoc_long(arr, "x", mevent->x);
+	add_assoc_long(arr, "y", mevent->y);
+	add_assoc_long(arr, "z", mevent->z);
+	add_assoc_long(arr, "mmask", mevent->bstate);
+}
+/* }}} */
+
+#if PHP_MAJOR_VERSION >= 7
+/* {{{ php_ncurses_mevent_field
+   Sets the field of mevent named like the ncurses_getmouse() key name to val.
+   Returns 0 if name is no such key */
+PHP_NCURSES_API int php_ncurses_mevent_field(MEVENT *mevent, zend_string *name, zval *val)
+{
+	if (zend_string_equals_literal(name, "id")) {
+		mevent->id = (short)zval_get_long(val);
+	} else if (zend_string_equals_literal(name, "x")) {
+		mevent->x = (int)zval_get_long(val);
+	} else if (zend_string_equals_literal(name, "y")) {
+		mevent->y = (int)zval_get_long(val);
+	} else if (zend_string_equals_literal(name, "z")) {
+		mevent->z = (int)zval_get_long(val);
+	} else if (zend_string_equals_literal(name, "mmask")) {
+		mevent->bstate = (mmask_t)zval_get_long(val);
+	} else {
+		return 0;
+	}
+	return 1;
+}
+/* }}} */
 #endif
+
+/* {{{ php_ncurses_wgetch
+   wgetch() for all reads of the extension: returns what the SGR decoder put
+   back, hands the events of ncurses_inject() to curses and decodes SGR mouse
+   reports after ncurses_mouse_sgr() */
+PHP_NCURSES_API int php_ncurses_wgetch(WINDOW *win)
+{
+	int ch;
+
+	if (NCURSES_G(unread_len) > 0) {
+		ch = NCURSES_G(unread)[--NCURSES_G(unread_len)];
+	} else {
+		php_ncurses_inject_pump(win);
+		ch = wgetch(win);
+	}
+	if (ch == 27 && NCURSES_G(mouse_sgr)) {
+		ch = php_ncurses_mouse_read_sgr(win);
+	}
+	return ch;
+}
+/* }}} */
+
+/* {{{ php_ncurses_read_keys
+   Appends the keys read from win to keys, waiting at most timeout milliseconds
+   for the first one (0 takes only pending input, -1 blocks) and taking only
+   what is already pending after that. max limits the number of keys, 0 means
+   no limit. With mouse set, KEY_MOUSE is replaced by the decoded event.
+   The delay mode of the window is restored afterwards */
+static int php_ncurses_read_keys(WINDOW *win, zend_long max, int timeout, int mouse, zval *keys)
+{
+	int ch, n = 0;
+	MEVENT mevent;
+#if PHP_MAJOR_VERSION >= 7
+	zval event;
 #else
-#define FETCH_WINRES(r, z)  ZEND_FETCH_RESOURCE(r, WINDOW **, z, -1, "ncurses_window", le_ncurses_windows)
-#if HAVE_NCURSES_PANEL
-# define FETCH_PANEL(r, z)  ZEND_FETCH_RESOURCE(r, PANEL **, z, -1, "ncurses_panel", le_ncurses_panels)
+	zval *event;
 #endif
-#define Z_RES_P  Z_LVAL_P
-typedef long zend_long;
+#ifdef HAVE_NCURSES_WGETDELAY
+	int delay = wgetdelay(win);
+#else
+	int delay = -1;
 #endif
 
-#define IS_NCURSES_INITIALIZED() \
-		if (!NCURSES_G(registered_constants)) { \
-			php_error_docref(NULL TSRMLS_CC, E_WARNING, "You must initialize ncurses via ncurses_init(), before calling any ncurses functions."); \
-			RETURN_FALSE; \
+	wtimeout(win, timeout);
+	while ((max <= 0 || n < max) && (ch = php_ncurses_wgetch(win)) != ERR) {
+		if (mouse && ch == KEY_MOUSE && php_ncurses_getmouse(&mevent) == OK) {
+#if PHP_MAJOR_VERSION >= 7
+			array_init_size(&event, 5);
+			php_ncurses_mevent_to_zval(&event, &mevent);
+			add_next_index_zval(keys, &event);
+#else
+			MAKE_STD_ZVAL(event);
+			array_init_size(event, 5);
+			php_ncurses_mevent_to_zval(event, &mevent);
+			add_next_index_zval(keys, event);
+#endif
+		} else {
+			add_next_index_long(keys, ch);
+		}
+		if (n++ == 0 && timeout != 0) {
+			wtimeout(win, 0);
 		}
+	}
+	wtimeout(win, delay);
+
+	return n;
+}
+/* }}} */
+
+/* {{{ php_ncurses_update_begin, php_ncurses_update_end
+   Bracket a physical update of the terminal, which ncurses.stats measures
+   and ncurses_record_start() records */
+typedef struct _php_ncurses_update {
+	double start;
+	int    saved_fd;
+} php_ncurses_update;
+
+static void php_ncurses_update_begin(php_ncurses_update *u)
+{
+	u->start = NCURSES_G(stats) ? php_ncurses_now() : 0;
+	u->saved_fd = NCURSES_G(recorder) ? php_ncurses_record_begin() : -1;
+}
+
+static void php_ncurses_update_end(php_ncurses_update *u)
+{
+	/* before the recorder passes the output on, copying it is no part of the update */
+	if (NCURSES_G(stats)) {
+		php_ncurses_stats_update(u->start);
+	}
+	if (u->saved_fd >= 0) {
+		php_ncurses_record_end(u->saved_fd);
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_frame_touch
+   Notes a change of the virtual screen, which the current frame has to send */
+PHP_NCURSES_API void php_ncurses_frame_touch(void)
+{
+	if (NCURSES_G(frame_depth)) {
+		NCURSES_G(frame_dirty) = 1;
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_wrefresh
+   Refreshes a window, inside a frame it is only copied to the virtual screen */
+PHP_NCURSES_API int php_ncurses_wrefresh(WINDOW *win)
+{
+	if (NCURSES_G(frame_depth)) {
+		NCURSES_G(frame_dirty) = 1;
+		return wnoutrefresh(win);
+	}
+	if (NCURSES_G(stats) || NCURSES_G(recorder)) {
+		php_ncurses_update u;
+		int ret;
+
+		php_ncurses_update_begin(&u);
+		ret = wrefresh(win);
+		php_ncurses_update_end(&u);
+		return ret;
+	}
+	return wrefresh(win);
+}
+/* }}} */
+
+/* {{{ php_ncurses_wnoutrefresh
+   Copies a window to the virtual screen, part of the current frame if any */
+PHP_NCURSES_API int php_ncurses_wnoutrefresh(WINDOW *win)
+{
+	php_ncurses_frame_touch();
+	return wnoutrefresh(win);
+}
+/* }}} */
+
+/* {{{ php_ncurses_prefresh
+   Refreshes a region of a pad, inside a frame it is only copied to the virtual screen */
+PHP_NCURSES_API int php_ncurses_prefresh(WINDOW *pad, int pminrow, int pmincol, int sminrow, int smincol, int smaxrow, int smaxcol)
+{
+	if (NCURSES_G(frame_depth)) {
+		NCURSES_G(frame_dirty) = 1;
+		return pnoutrefresh(pad, pminrow, pmincol, sminrow, smincol, smaxrow, smaxcol);
+	}
+	if (NCURSES_G(stats) || NCURSES_G(recorder)) {
+		php_ncurses_update u;
+		int ret;
+
+		php_ncurses_update_begin(&u);
+		ret = prefresh(pad, pminrow, pmincol, sminrow, smincol, smaxrow, smaxcol);
+		php_ncurses_update_end(&u);
+		return ret;
+	}
+	return prefresh(pad, pminrow, pmincol, sminrow, smincol, smaxrow, smaxcol);
+}
+/* }}} */
+
+/* {{{ php_ncurses_doupdate
+   Updates the terminal, inside a frame this is deferred to ncurses_frame_end() */
+PHP_NCURSES_API int php_ncurses_doupdate(void)
+{
+	if (NCURSES_G(frame_depth)) {
+		NCURSES_G(frame_dirty) = 1;
+		return OK;
+	}
+	if (NCURSES_G(stats) || NCURSES_G(recorder)) {
+		php_ncurses_update u;
+		int ret;
+
+		php_ncurses_update_begin(&u);
+		ret = doupdate();
+		php_ncurses_update_end(&u);
+		return ret;
+	}
+	return doupdate();
+}
+/* }}} */
 
 /* {{{ proto int ncurses_addch(int ch)
    Adds character at current position and advance cursor */
@@ -72,15 +483,15 @@ PHP_FUNCTION(ncurses_waddch)
 {
 	zend_long ch;
 	zval *handle;
-	WINDOW **win;
+	WINDOW *win;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rl", &handle, &ch) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "l", &handle, &ch) == FAILURE) {
 	        return;
 	}
 
 	FETCH_WINRES(win, &handle);
 
-	RETURN_LONG(waddch(*win, ch));
+	RETURN_LONG(waddch(win, ch));
 }
 /* }}} */
 
@@ -104,15 +515,32 @@ PHP_FUNCTION(ncurses_color_set)
 PHP_FUNCTION(ncurses_delwin)
 {
 	zval *handle;
-	WINDOW **w;
+	WINDOW *w;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r", &handle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN, &handle) == FAILURE) {
 		return;
 	}
 
 	FETCH_WINRES(w, &handle);
 
-	zend_list_delete(Z_RES_P(handle));
+#if PHP_VERSION_ID >= 80000
+	php_ncurses_window_delete(php_ncurses_window_from_obj(Z_OBJ_P(handle)));
+#else
+# if HAVE_NCURSES_PANEL
+	{
+		zend_resource *panel;
+
+		/* the panel must not outlive the window it shows; closing it drops
+		   the reference it holds to the window */
+		if (NCURSES_G(window_panels)
+				&& (panel = zend_hash_index_find_ptr(NCURSES_G(window_panels), (zend_ulong)(uintptr_t)w)) != NULL) {
+			zend_list_close(panel);
+		}
+	}
+# endif
+	/* the resource stays with its other holders, only the window goes */
+	zend_list_close(Z_RES_P(handle));
+#endif
 	RETURN_TRUE;
 }
 /* }}} */
@@ -121,7 +549,13 @@ PHP_FUNCTION(ncurses_delwin)
    Stops using ncurses, clean up the screen */
 PHP_FUNCTION(ncurses_end)
 {
+	if (NCURSES_G(lazy)) {
+		/* curses never ran, the terminal is as it was */
+		RETURN_LONG(OK);
+	}
 	IS_NCURSES_INITIALIZED();
+	NCURSES_G(frame_depth) = 0;
+	NCURSES_G(frame_dirty) = 0;
 	RETURN_LONG(endwin());             /* endialize the curses library */
 }
 /* }}} */
@@ -131,9 +565,237 @@ PHP_FUNCTION(ncurses_end)
 PHP_FUNCTION(ncurses_getch)
 {
 	IS_NCURSES_INITIALIZED();
-	RETURN_LONG(getch());
+	RETURN_LONG(php_ncurses_wgetch(stdscr));
+}
+/* }}} */
+
+#ifndef HAVE_PDCURSESLIB
+/* {{{ php_ncurses_open_input
+   Opens a stream on the terminal input. The stream gets a descriptor of its
+   own, closing it leaves the terminal alone */
+static php_stream *php_ncurses_open_input(TSRMLS_D)
+{
+	php_stream *stream;
+	int fd = dup(php_ncurses_input_fd());
+
+	if (fd < 0) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Unable to duplicate the terminal input descriptor: %s", strerror(errno));
+		return NULL;
+	}
+
+	stream = php_stream_fopen_from_fd(fd, "r", NULL);
+	if (!stream) {
+		close(fd);
+	}
+
+	return stream;
+}
+/* }}} */
+#endif
+
+/* {{{ proto resource ncurses_input_stream(void)
+   Returns a stream on the terminal input, to be used with stream_select() only.
+   Keys must still be read with ncurses_getch() or ncurses_drain_keys() */
+PHP_FUNCTION(ncurses_input_stream)
+{
+#ifdef HAVE_PDCURSESLIB
+	php_error_docref(NULL TSRMLS_CC, E_WARNING, "The terminal input can not be selected on this platform");
+	RETURN_FALSE;
+#else
+	php_stream *stream;
+
+	IS_NCURSES_INITIALIZED();
+
+	if ((stream = php_ncurses_open_input(TSRMLS_C)) == NULL) {
+		RETURN_FALSE;
+	}
+
+	php_stream_to_zval(stream, return_value);
+#endif
+}
+/* }}} */
+
+/* {{{ proto array ncurses_drain_keys([resource window [, int max]])
+   Returns all keys that are pending without blocking, max limits their number */
+PHP_FUNCTION(ncurses_drain_keys)
+{
+	zval *handle = NULL;
+	zend_long max = 0;
+	WINDOW *win = NULL;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|" PHP_NCURSES_WIN "!l", &handle, &max) == FAILURE) {
+		return;
+	}
+	IS_NCURSES_INITIALIZED();
+
+	if (handle) {
+		FETCH_WINRES(win, &handle);
+	} else {
+		win = stdscr;
+	}
+
+	array_init(return_value);
+	php_ncurses_read_keys(win, max, 0, 0, return_value);
+}
+/* }}} */
+
+/* {{{ proto array ncurses_wgetch_batch(resource window [, int max [, int timeout_ms]])
+   Waits up to timeout_ms for input (-1 blocks) and returns all keys that arrived,
+   mouse events are returned as arrays like the ones of ncurses_getmouse() */
+PHP_FUNCTION(ncurses_wgetch_batch)
+{
+	zval *handle;
+	zend_long max = 0, timeout = 0;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "|ll", &handle, &max, &timeout) == FAILURE) {
+		return;
+	}
+
+	FETCH_WINRES(win, &handle);
+
+	if (timeout < 0) {
+		timeout = -1;
+	}
+
+	array_init(return_value);
+	php_ncurses_read_keys(win, max, (int)timeout, 1, return_value);
+}
+/* }}} */
+
+#if PHP_MAJOR_VERSION >= 7
+/* {{{ proto bool ncurses_set_input_waiter(?callable waiter)
+   Sets the function ncurses_getch_async() calls with a stream on the terminal
+   input when no key is pending. It must return once the stream is readable,
+   typically by suspending the current Fiber until the event loop sees it so */
+PHP_FUNCTION(ncurses_set_input_waiter)
+{
+	zval *waiter = NULL;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "z!", &waiter) == FAILURE) {
+		return;
+	}
+
+	if (waiter && !zend_is_callable(waiter, 0, NULL)) {
+#if PHP_VERSION_ID >= 80000
+		zend_argument_type_error(1, "must be a valid callback or null");
+		RETURN_THROWS();
+#else
+		php_error_docref(NULL, E_WARNING, "The waiter must be a valid callback or null");
+		RETURN_FALSE;
+#endif
+	}
+
+	zval_ptr_dtor(&NCURSES_G(input_waiter));
+	if (waiter) {
+		ZVAL_COPY(&NCURSES_G(input_waiter), waiter);
+	} else {
+		ZVAL_UNDEF(&NCURSES_G(input_waiter));
+	}
+
+	RETURN_TRUE;
+}
+/* }}} */
+
+/* {{{ php_ncurses_wait_input
+   Returns once the terminal input is likely readable without blocking the
+   process, FAILURE if there is no way to do so or an exception was thrown */
+static int php_ncurses_wait_input(void)
+{
+#ifdef HAVE_PDCURSESLIB
+	return FAILURE;
+#else
+	php_stream *stream;
+	zval zstream, retval;
+	int ret = SUCCESS;
+
+	if (Z_TYPE(NCURSES_G(input_waiter)) == IS_UNDEF
+#if PHP_VERSION_ID >= 80100
+		&& !EG(active_fiber)
+#endif
+	) {
+		return FAILURE;
+	}
+	if ((stream = php_ncurses_open_input()) == NULL) {
+		return FAILURE;
+	}
+	php_stream_to_zval(stream, &zstream);
+
+	ZVAL_UNDEF(&retval);
+	if (Z_TYPE(NCURSES_G(input_waiter)) != IS_UNDEF) {
+		if (call_user_function(NULL, NULL, &NCURSES_G(input_waiter), &retval, 1, &zstream) == FAILURE) {
+			ret = FAILURE;
+		}
+#if PHP_VERSION_ID >= 80100
+	} else {
+		/* no waiter, the scheduler resuming the Fiber gets the stream to watch */
+		zend_call_method_with_1_params(NULL, zend_ce_fiber, NULL, "suspend", &retval, &zstream);
+#endif
+	}
+	zval_ptr_dtor(&retval);
+	zval_ptr_dtor(&zstream);
+
+	return EG(exception) ? FAILURE : ret;
+#endif
+}
+/* }}} */
+
+/* {{{ proto int ncurses_getch_async([resource window])
+   Reads a key without blocking the process: while none is pending the
+   input waiter is called, or inside a Fiber without a waiter the Fiber is
+   suspended with the input stream as value. Blocks like ncurses_wgetch()
+   when neither is possible */
+PHP_FUNCTION(ncurses_getch_async)
+{
+	zval *handle = NULL;
+	WINDOW *win;
+	int ch, delay;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "|" PHP_NCURSES_WIN "!", &handle) == FAILURE) {
+		return;
+	}
+	IS_NCURSES_INITIALIZED();
+
+	if (handle) {
+		FETCH_WINRES(win, &handle);
+	} else {
+		win = stdscr;
+	}
+
+#ifdef HAVE_NCURSES_WGETDELAY
+	delay = wgetdelay(win);
+#else
+	delay = -1;
+#endif
+	for (;;) {
+		/* without a delay only the injected events that are due are read */
+		wtimeout(win, 0);
+		ch = php_ncurses_wgetch(win);
+		wtimeout(win, delay);
+		if (ch != ERR) {
+			break;
+		}
+		if (php_ncurses_wait_input() == FAILURE) {
+			if (EG(exception)) {
+#if PHP_VERSION_ID >= 80000
+				RETURN_THROWS();
+#else
+				return;
+#endif
+			}
+			ch = php_ncurses_wgetch(win);
+			break;
+		}
+		/* the window may have been deleted while the waiter ran */
+		if (handle) {
+			FETCH_WINRES(win, &handle);
+		}
+	}
+
+	RETURN_LONG(ch);
 }
 /* }}} */
+#endif
 
 /* {{{ proto bool ncurses_has_colors(void)
    Checks if terminal has colors */
@@ -144,43 +806,117 @@ PHP_FUNCTION(ncurses_has_colors)
 }
 /* }}} */
 
-/* {{{ proto int ncurses_init(void)
-   Initializes ncurses */
+/* {{{ php_ncurses_start
+   Starts curses on the terminal of the process, with the description from
+   the terminfo cache if ncurses.terminfo_cache is set */
+PHP_NCURSES_API int php_ncurses_start(TSRMLS_D)
+{
+	char *term = getenv("TERM"), *saved;
+	zend_bool cached;
+
+	php_ncurses_stats_open();
+	php_ncurses_setup_locale(0);
+#if PHP_VERSION_ID >= 80000
+	php_ncurses_screen_main();
+#endif
+	/* initscr(), but keeping the screen for ncurses_set_term() */
+	saved = php_ncurses_terminfo_begin(term, &cached);
+	NCURSES_G(main_term).screen = newterm(term, stdout, stdin);
+	php_ncurses_terminfo_end(saved, cached);
+	if (!NCURSES_G(main_term).screen) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Error opening terminal: %s", term ? term : "unknown");
+		return FAILURE;
+	}
+	def_prog_mode();
+	NCURSES_G(input_fd) = fileno(stdin);
+	NCURSES_G(output_fd) = fileno(stdout);
+	php_ncurses_setup_screen(TSRMLS_C);
+	php_ncurses_acs_store(term);
+
+	return SUCCESS;
+}
+/* }}} */
+
+/* {{{ proto int ncurses_init([bool lazy])
+   Initializes ncurses. With lazy set and the ACS table of $TERM in the
+   terminfo cache, curses is only started by the first function using it */
 PHP_FUNCTION(ncurses_init)
 {
-	initscr();             /* initialize the curses library */
+	zend_bool lazy = 0;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|b", &lazy) == FAILURE) {
+		return;
+	}
+
+	if (lazy && php_ncurses_lazy_register(getenv("TERM")) == SUCCESS) {
+		return;
+	}
+	if (php_ncurses_start(TSRMLS_C) == FAILURE) {
+		RETURN_FALSE;
+	}
+}
+/* }}} */
+
+#if PHP_MAJOR_VERSION >= 7
+/* {{{ php_ncurses_register_stdscr
+   Registers the STDSCR constant for win, which is NULL while a lazy start
+   is pending. Returns the window object or resource behind it */
+PHP_NCURSES_API void *php_ncurses_register_stdscr(WINDOW *win)
+{
+	zend_constant c;
+	void *handle;
+
+#if PHP_VERSION_ID >= 80000
+	/* stdscr is owned by curses, the object must never delwin() it */
+	php_ncurses_window_wrap(&c.value, win, 0);
+	handle = Z_OBJ(c.value);
+#else
+	ZVAL_RES(&c.value, zend_register_resource(win, le_ncurses_windows));
+	handle = Z_RES(c.value);
+#endif
+#if PHP_VERSION_ID >= 70300
+	ZEND_CONSTANT_SET_FLAGS(&c, CONST_CS, ncurses_module_entry.module_number);
+#else
+	c.module_number = ncurses_module_entry.module_number;
+	c.flags = CONST_CS;
+#endif
+	c.name = zend_string_init("STDSCR", sizeof("STDSCR")-1, 0);
+	zend_register_constant(&c);
+
+	return handle;
+}
+/* }}} */
+#endif
+
+/* {{{ php_ncurses_setup_screen
+   Sets the input modes of a fresh screen and registers the constants that
+   only have a value once curses is initialized */
+PHP_NCURSES_API void php_ncurses_setup_screen(TSRMLS_D)
+{
 	keypad(stdscr, TRUE);  /* enable keyboard mapping */
 	(void) nonl();         /* tell curses not to do NL->CR/NL on output */
 	(void) cbreak();       /* take input chars one at a time, no wait for \n */
+	php_ncurses_pairs_reset();
+	php_ncurses_palette_reset();
+
+	if (!NCURSES_G(screen)) {
+		/* the STDSCR of ncurses_init(true) waited for this screen */
+		php_ncurses_lazy_resolve();
+	}
 
 	if (!NCURSES_G(registered_constants)) {
-		zend_constant c;
-		
-		WINDOW **pscr = (WINDOW**)emalloc(sizeof(WINDOW *));
 #if PHP_MAJOR_VERSION >= 7
-		zend_resource *zscr;
-		int module_number;
+		int module_number = ncurses_module_entry.module_number;
 
-		*pscr = stdscr;
-		zscr = zend_register_resource(pscr, le_ncurses_windows);
-		ZVAL_RES(&c.value, zscr);
-#if PHP_VERSION_ID >= 70300
-		module_number = ZEND_CONSTANT_MODULE_NUMBER(&c);
-		ZEND_CONSTANT_SET_FLAGS(&c, CONST_CS, module_number);
-#else
-		c.module_number = module_number = NCURSES_G(module_number);
-		c.flags = CONST_CS;
-#endif
-		c.name = zend_string_init("STDSCR", sizeof("STDSCR")-1, 0);
-		zend_register_constant(&c);
+		php_ncurses_register_stdscr(stdscr);
 
 #define PHP_NCURSES_DEF_CONST(x)  REGISTER_LONG_CONSTANT("NCURSES_"#x, x, CONST_CS)
 #else
+		zend_constant c;
 		zval *zscr;
 
-		*pscr = stdscr;
 		MAKE_STD_ZVAL(zscr);
-		ZEND_REGISTER_RESOURCE(zscr, pscr, le_ncurses_windows);
+		ZEND_REGISTER_RESOURCE(zscr, stdscr, le_ncurses_windows);
 		c.value = *zscr;
 		zval_copy_ctor(&c.value);
 		c.flags = CONST_CS;
@@ -200,31 +936,8 @@ PHP_FUNCTION(ncurses_init)
 		c.name_len = sizeof("NCURSES_" #x);                           \
 		zend_register_constant(&c TSRMLS_CC)
 #endif
-		PHP_NCURSES_DEF_CONST(ACS_ULCORNER);
-		PHP_NCURSES_DEF_CONST(ACS_LLCORNER);
-		PHP_NCURSES_DEF_CONST(ACS_URCORNER);
-		PHP_NCURSES_DEF_CONST(ACS_LRCORNER);
-		PHP_NCURSES_DEF_CONST(ACS_LTEE);
-		PHP_NCURSES_DEF_CONST(ACS_RTEE);
-		PHP_NCURSES_DEF_CONST(ACS_BTEE);
-		PHP_NCURSES_DEF_CONST(ACS_TTEE);
-		PHP_NCURSES_DEF_CONST(ACS_HLINE);
-		PHP_NCURSES_DEF_CONST(ACS_VLINE);
-		PHP_NCURSES_DEF_CONST(ACS_PLUS);
-		PHP_NCURSES_DEF_CONST(ACS_S1);
-		PHP_NCURSES_DEF_CONST(ACS_S9);
-		PHP_NCURSES_DEF_CONST(ACS_DIAMOND);
-		PHP_NCURSES_DEF_CONST(ACS_CKBOARD);
-		PHP_NCURSES_DEF_CONST(ACS_DEGREE);
-		PHP_NCURSES_DEF_CONST(ACS_PLMINUS);
-		PHP_NCURSES_DEF_CONST(ACS_BULLET);
-		PHP_NCURSES_DEF_CONST(ACS_LARROW);
-		PHP_NCURSES_DEF_CONST(ACS_RARROW);
-		PHP_NCURSES_DEF_CONST(ACS_DARROW);
-		PHP_NCURSES_DEF_CONST(ACS_UARROW);
-		PHP_NCURSES_DEF_CONST(ACS_BOARD);
-		PHP_NCURSES_DEF_CONST(ACS_LANTERN);
-		PHP_NCURSES_DEF_CONST(ACS_BLOCK);
+#define PHP_NCURSES_DEF_ACS(x)  PHP_NCURSES_DEF_CONST(x);
+		PHP_NCURSES_ACS_LIST(PHP_NCURSES_DEF_ACS)
 		
 #if PHP_MAJOR_VERSION < 7
 		FREE_ZVAL(zscr);
@@ -244,6 +957,7 @@ PHP_FUNCTION(ncurses_init_pair)
 		return;
 	}
 	IS_NCURSES_INITIALIZED();
+	php_ncurses_pairs_forget((int)pair);
 	RETURN_LONG(init_pair(pair,fg,bg));
 }
 /* }}} */
@@ -266,25 +980,25 @@ PHP_FUNCTION(ncurses_move)
 PHP_FUNCTION(ncurses_newpad)
 {
 	zend_long rows,cols;
-	WINDOW **pwin;
+	WINDOW *win;
 
 	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "ll", &rows, &cols) == FAILURE) {
 		return;
 	}
 	IS_NCURSES_INITIALIZED();
 	
-	pwin = (WINDOW **)emalloc(sizeof(WINDOW *));
-	*pwin = newpad(rows,cols);
+	win = newpad(rows,cols);
 
-	if(!*pwin) {
-		efree(pwin);
+	if(!win) {
 		RETURN_FALSE;
 	}
 
-#if PHP_MAJOR_VERSION >= 7
-	ZVAL_RES(return_value, zend_register_resource(pwin, le_ncurses_windows));
+#if PHP_VERSION_ID >= 80000
+	php_ncurses_window_wrap(return_value, win, 1);
+#elif PHP_MAJOR_VERSION >= 7
+	ZVAL_RES(return_value, zend_register_resource(win, le_ncurses_windows));
 #else
-	ZEND_REGISTER_RESOURCE(return_value, pwin, le_ncurses_windows);
+	ZEND_REGISTER_RESOURCE(return_value, win, le_ncurses_windows);
 #endif
 }
 /* }}} */
@@ -293,18 +1007,18 @@ PHP_FUNCTION(ncurses_newpad)
    Copys a region from a pad into the virtual screen */
 PHP_FUNCTION(ncurses_prefresh)
 {
-	WINDOW **pwin;
+	WINDOW *pwin;
 	zval *phandle;
 	zend_long pminrow, pmincol, sminrow, smincol, smaxrow, smaxcol;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rllllll", &phandle, &pminrow,
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "llllll", &phandle, &pminrow,
 				&pmincol, &sminrow, &smincol, &smaxrow, &smaxcol) == FAILURE) {
 		return;
 	}
 
 	FETCH_WINRES(pwin, &phandle);
 
-	RETURN_LONG(prefresh(*pwin, pminrow, pmincol, sminrow, smincol, smaxrow, smaxcol));
+	RETURN_LONG(php_ncurses_prefresh(pwin, pminrow, pmincol, sminrow, smincol, smaxrow, smaxcol));
 }
 /* }}} */
 
@@ -312,18 +1026,19 @@ PHP_FUNCTION(ncurses_prefresh)
    Copys a region from a pad into the virtual screen */
 PHP_FUNCTION(ncurses_pnoutrefresh)
 {
-	WINDOW **pwin;
+	WINDOW *pwin;
 	zval *phandle;
 	zend_long pminrow, pmincol, sminrow, smincol, smaxrow, smaxcol;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rllllll", &phandle, &pminrow,
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "llllll", &phandle, &pminrow,
 				&pmincol, &sminrow, &smincol, &smaxrow, &smaxcol) == FAILURE) {
 		return;
 	}
 
 	FETCH_WINRES(pwin, &phandle);
 
-	RETURN_LONG(pnoutrefresh(*pwin, pminrow, pmincol, sminrow, smincol, smaxrow, smaxcol));
+	php_ncurses_frame_touch();
+	RETURN_LONG(pnoutrefresh(pwin, pminrow, pmincol, sminrow, smincol, smaxrow, smaxcol));
 }
 /* }}} */
 
@@ -334,25 +1049,25 @@ PHP_FUNCTION(ncurses_pnoutrefresh)
 PHP_FUNCTION(ncurses_newwin)
 {
 	zend_long rows,cols,y,x;
-	WINDOW **pwin; 
+	WINDOW *win; 
 
 	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "llll", &rows, &cols, &y, &x) == FAILURE) {
 		return;
 	}
 
 	IS_NCURSES_INITIALIZED();
-	pwin = (WINDOW **)emalloc(sizeof(WINDOW *));
-	*pwin=newwin(rows,cols,y,x);
+	win=newwin(rows,cols,y,x);
 
-	if(!*pwin) {
-		efree(pwin);
+	if(!win) {
 		RETURN_FALSE;
 	}
 
-#if PHP_MAJOR_VERSION >= 7
-	ZVAL_RES(return_value, zend_register_resource(pwin, le_ncurses_windows));
+#if PHP_VERSION_ID >= 80000
+	php_ncurses_window_wrap(return_value, win, 1);
+#elif PHP_MAJOR_VERSION >= 7
+	ZVAL_RES(return_value, zend_register_resource(win, le_ncurses_windows));
 #else
-	ZEND_REGISTER_RESOURCE(return_value, pwin, le_ncurses_windows);
+	ZEND_REGISTER_RESOURCE(return_value, win, le_ncurses_windows);
 #endif
 }
 /* }}} */
@@ -362,7 +1077,7 @@ PHP_FUNCTION(ncurses_newwin)
 PHP_FUNCTION(ncurses_refresh)
 {
 	IS_NCURSES_INITIALIZED();
-	RETURN_LONG(refresh());
+	RETURN_LONG(php_ncurses_wrefresh(stdscr));
 }
 /* }}} */
 
@@ -515,7 +1230,80 @@ PHP_FUNCTION(ncurses_deleteln)
 PHP_FUNCTION(ncurses_doupdate)
 {
 	IS_NCURSES_INITIALIZED();
-	RETURN_LONG(doupdate());
+	RETURN_LONG(php_ncurses_doupdate());
+}
+/* }}} */
+
+/* {{{ proto void ncurses_frame_begin(void)
+   Starts a frame, refreshes only update the virtual screen until ncurses_frame_end() */
+PHP_FUNCTION(ncurses_frame_begin)
+{
+	IS_NCURSES_INITIALIZED();
+	NCURSES_G(frame_depth)++;
+}
+/* }}} */
+
+/* {{{ proto bool ncurses_frame_end([bool wait])
+   Ends a frame and sends all its refreshes to the terminal with a single doupdate().
+   With a frame rate limit the update waits for the next frame slot, or is kept
+   for the next frame if wait is false. Returns true if the terminal was updated */
+PHP_FUNCTION(ncurses_frame_end)
+{
+	zend_bool wait = 1;
+	double now, next;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|b", &wait) == FAILURE) {
+		return;
+	}
+	IS_NCURSES_INITIALIZED();
+
+	if (NCURSES_G(frame_depth) == 0) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "No frame was started with ncurses_frame_begin()");
+		RETURN_FALSE;
+	}
+	if (--NCURSES_G(frame_depth) > 0 || !NCURSES_G(frame_dirty)) {
+		RETURN_FALSE;
+	}
+
+	now = php_ncurses_now();
+	if (NCURSES_G(max_fps) > 0) {
+		next = NCURSES_G(last_update) + 1.0 / (double)NCURSES_G(max_fps);
+		if (now < next) {
+			if (!wait) {
+				RETURN_FALSE;
+			}
+			usleep((unsigned int)((next - now) * 1000000.0));
+			now = php_ncurses_now();
+		}
+	}
+
+	php_ncurses_doupdate();
+	NCURSES_G(frame_dirty) = 0;
+	NCURSES_G(last_update) = now;
+	RETURN_TRUE;
+}
+/* }}} */
+
+/* {{{ proto int ncurses_set_max_fps(int fps)
+   Limits how often ncurses_frame_end() updates the terminal, 0 removes the limit.
+   Returns the previous limit */
+PHP_FUNCTION(ncurses_set_max_fps)
+{
+	zend_long fps;
+	long old;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "l", &fps) == FAILURE) {
+		return;
+	}
+
+	if (fps < 0) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Frame rate must not be negative");
+		RETURN_FALSE;
+	}
+
+	old = NCURSES_G(max_fps);
+	NCURSES_G(max_fps) = (long)fps;
+	RETURN_LONG(old);
 }
 /* }}} */
 
@@ -704,15 +1492,15 @@ PHP_FUNCTION(ncurses_meta)
 {
 	zend_bool enable;
 	zval *handle;
-	WINDOW **win;
+	WINDOW *win;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rb", &handle, &enable) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "b", &handle, &enable) == FAILURE) {
         	return;
 	}
 
 	FETCH_WINRES(win, &handle);
 
-	RETURN_LONG(meta(*win, enable));
+	RETURN_LONG(meta(win, enable));
 }
 /* }}} */
 
@@ -721,15 +1509,15 @@ PHP_FUNCTION(ncurses_meta)
 PHP_FUNCTION(ncurses_werase)
 {
 	zval *handle;
-	WINDOW **win;
+	WINDOW *win;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r", &handle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN, &handle) == FAILURE) {
 	        return;
 	}
 
 	FETCH_WINRES(win, &handle);
 
-	RETURN_LONG(werase(*win));
+	RETURN_LONG(werase(win));
 }
 /* }}} */
 
@@ -909,16 +1697,16 @@ PHP_FUNCTION(ncurses_bkgd)
 PHP_FUNCTION(ncurses_wbkgd)
 {
 	zend_long intarg;
-	WINDOW **win;
+	WINDOW *win;
 	zval *handle;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rl", &handle, &intarg) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "l", &handle, &intarg) == FAILURE) {
 		return;
 	}
 	IS_NCURSES_INITIALIZED();
 	FETCH_WINRES(win, &handle);
 
-	RETURN_LONG(wbkgd(*win, COLOR_PAIR(intarg)));
+	RETURN_LONG(wbkgd(win, COLOR_PAIR(intarg)));
 }
 /* }}} */
 
@@ -1211,16 +1999,16 @@ PHP_FUNCTION(ncurses_bkgdset)
 PHP_FUNCTION(ncurses_wbkgdset)
 {
 	zend_long intarg;
-	WINDOW **win;
+	WINDOW *win;
 	zval *handle;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rl", &handle, &intarg) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "l", &handle, &intarg) == FAILURE) {
 		return;
 	}
 	IS_NCURSES_INITIALIZED();
 	FETCH_WINRES(win, &handle);
 
-	wbkgdset(*win, COLOR_PAIR(intarg));
+	wbkgdset(win, COLOR_PAIR(intarg));
 }
 /* }}} */
 
@@ -1293,7 +2081,7 @@ PHP_FUNCTION(ncurses_addstr)
 		return;
 	}
 	IS_NCURSES_INITIALIZED();
-	RETURN_LONG(addstr(str));
+	RETURN_LONG(php_ncurses_waddnstr(stdscr, str, str_len, -1));
 }
 /* }}} */
 
@@ -1345,17 +2133,242 @@ PHP_FUNCTION(ncurses_scr_init)
 	int str_len;
 #endif
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "s", &str, &str_len) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "s", &str, &str_len) == FAILURE) {
+		return;
+	}
+	IS_NCURSES_INITIALIZED();
+	RETURN_LONG(scr_init(str));
+}
+/* }}} */
+
+/* {{{ proto int ncurses_scr_restore(string filename)
+   Restores screen from file dump */
+PHP_FUNCTION(ncurses_scr_restore)
+{
+	char *str;
+#if PHP_MAJOR_VERSION >= 7
+	size_t str_len;
+#else
+	int str_len;
+#endif
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "s", &str, &str_len) == FAILURE) {
+		return;
+	}
+	IS_NCURSES_INITIALIZED();
+	RETURN_LONG(scr_restore(str));
+}
+/* }}} */
+
+/* {{{ proto int ncurses_scr_set(string filename)
+   Inherits screen from file dump */
+PHP_FUNCTION(ncurses_scr_set)
+{
+	char *str;
+#if PHP_MAJOR_VERSION >= 7
+	size_t str_len;
+#else
+	int str_len;
+#endif
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "s", &str, &str_len) == FAILURE) {
+		return;
+	}
+	IS_NCURSES_INITIALIZED();
+	RETURN_LONG(scr_set(str));
+}
+/* }}} */
+
+/* {{{ php_ncurses_dump_write
+   Runs putwin() on win into memory and returns the dump in return_value */
+static void php_ncurses_dump_write(WINDOW *win, zval *return_value)
+{
+	FILE *fp;
+#ifdef HAVE_OPEN_MEMSTREAM
+	char *buf = NULL;
+	size_t len = 0;
+
+	if ((fp = open_memstream(&buf, &len)) == NULL) {
+		RETURN_FALSE;
+	}
+	if (putwin(win, fp) == ERR) {
+		fclose(fp);
+		free(buf);
+		RETURN_FALSE;
+	}
+	fclose(fp);
+#else
+	char *buf;
+	long len;
+
+	/* no memory streams, go through an unnamed temporary file */
+	if ((fp = tmpfile()) == NULL) {
+		RETURN_FALSE;
+	}
+	if (putwin(win, fp) == ERR || (len = ftell(fp)) < 0) {
+		fclose(fp);
+		RETURN_FALSE;
+	}
+	buf = malloc(len ? len : 1);
+	rewind(fp);
+	if (!buf || fread(buf, 1, len, fp) != (size_t)len) {
+		free(buf);
+		fclose(fp);
+		RETURN_FALSE;
+	}
+	fclose(fp);
+#endif
+
+#if PHP_MAJOR_VERSION >= 7
+	RETVAL_STRINGL(buf, len);
+#else
+	RETVAL_STRINGL(buf, len, 1);
+#endif
+	free(buf);
+}
+/* }}} */
+
+/* {{{ php_ncurses_dump_read
+   Runs getwin() on a dump made by php_ncurses_dump_write() */
+static WINDOW *php_ncurses_dump_read(char *str, size_t len)
+{
+	WINDOW *win;
+	FILE *fp;
+
+	if (len == 0) {
+		return NULL;
+	}
+#ifdef HAVE_FMEMOPEN
+	fp = fmemopen(str, len, "r");
+#else
+	if ((fp = tmpfile()) != NULL) {
+		if (fwrite(str, 1, len, fp) != len) {
+			fclose(fp);
+			return NULL;
+		}
+		rewind(fp);
+	}
+#endif
+	if (fp == NULL) {
+		return NULL;
+	}
+
+	win = getwin(fp);
+	fclose(fp);
+
+	return win;
+}
+/* }}} */
+
+/* {{{ php_ncurses_dump_copy
+   Copies the contents of a dump into dst, clipped to the smaller size */
+static int php_ncurses_dump_copy(WINDOW *dst, char *str, size_t len)
+{
+	WINDOW *src;
+	int ret;
+
+	if ((src = php_ncurses_dump_read(str, len)) == NULL) {
+		return ERR;
+	}
+	ret = copywin(src, dst, 0, 0, 0, 0,
+			MIN(getmaxy(src), getmaxy(dst)) - 1, MIN(getmaxx(src), getmaxx(dst)) - 1, FALSE);
+	delwin(src);
+
+	return ret;
+}
+/* }}} */
+
+#ifndef HAVE_PDCURSESLIB
+/* {{{ proto string ncurses_scr_dump_string(void)
+   Dumps screen content to a string, without touching the filesystem */
+PHP_FUNCTION(ncurses_scr_dump_string)
+{
+	IS_NCURSES_INITIALIZED();
+	php_ncurses_dump_write(newscr, return_value);
+}
+/* }}} */
+
+/* {{{ proto int ncurses_scr_restore_string(string dump)
+   Restores screen from a dump made by ncurses_scr_dump_string() */
+PHP_FUNCTION(ncurses_scr_restore_string)
+{
+	char *str;
+#if PHP_MAJOR_VERSION >= 7
+	size_t str_len;
+#else
+	int str_len;
+#endif
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "s", &str, &str_len) == FAILURE) {
+		return;
+	}
+	IS_NCURSES_INITIALIZED();
+	RETURN_LONG(php_ncurses_dump_copy(newscr, str, str_len));
+}
+/* }}} */
+
+/* {{{ proto int ncurses_scr_init_string(string dump)
+   Initializes screen from a dump made by ncurses_scr_dump_string() */
+PHP_FUNCTION(ncurses_scr_init_string)
+{
+	char *str;
+#if PHP_MAJOR_VERSION >= 7
+	size_t str_len;
+#else
+	int str_len;
+#endif
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "s", &str, &str_len) == FAILURE) {
+		return;
+	}
+	IS_NCURSES_INITIALIZED();
+	RETURN_LONG(php_ncurses_dump_copy(curscr, str, str_len));
+}
+/* }}} */
+
+/* {{{ proto int ncurses_scr_set_string(string dump)
+   Inherits screen from a dump made by ncurses_scr_dump_string() */
+PHP_FUNCTION(ncurses_scr_set_string)
+{
+	char *str;
+#if PHP_MAJOR_VERSION >= 7
+	size_t str_len;
+#else
+	int str_len;
+#endif
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "s", &str, &str_len) == FAILURE) {
+		return;
+	}
+	IS_NCURSES_INITIALIZED();
+	if (php_ncurses_dump_copy(curscr, str, str_len) == ERR) {
+		RETURN_LONG(ERR);
+	}
+	RETURN_LONG(php_ncurses_dump_copy(newscr, str, str_len));
+}
+/* }}} */
+#endif
+
+/* {{{ proto string ncurses_putwin(resource window)
+   Dumps the contents and attributes of a window to a string */
+PHP_FUNCTION(ncurses_putwin)
+{
+	zval *handle;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN, &handle) == FAILURE) {
 		return;
 	}
-	IS_NCURSES_INITIALIZED();
-	RETURN_LONG(scr_init(str));
+
+	FETCH_WINRES(win, &handle);
+
+	php_ncurses_dump_write(win, return_value);
 }
 /* }}} */
 
-/* {{{ proto int ncurses_scr_restore(string filename)
-   Restores screen from file dump */
-PHP_FUNCTION(ncurses_scr_restore)
+/* {{{ proto resource ncurses_getwin(string dump)
+   Creates a window from a dump made by ncurses_putwin() */
+PHP_FUNCTION(ncurses_getwin)
 {
 	char *str;
 #if PHP_MAJOR_VERSION >= 7
@@ -1363,19 +2376,35 @@ PHP_FUNCTION(ncurses_scr_restore)
 #else
 	int str_len;
 #endif
+	WINDOW *win;
 
 	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "s", &str, &str_len) == FAILURE) {
 		return;
 	}
+
 	IS_NCURSES_INITIALIZED();
-	RETURN_LONG(scr_restore(str));
+	win = php_ncurses_dump_read(str, str_len);
+
+	if (!win) {
+		RETURN_FALSE;
+	}
+
+#if PHP_VERSION_ID >= 80000
+	php_ncurses_window_wrap(return_value, win, 1);
+#elif PHP_MAJOR_VERSION >= 7
+	ZVAL_RES(return_value, zend_register_resource(win, le_ncurses_windows));
+#else
+	ZEND_REGISTER_RESOURCE(return_value, win, le_ncurses_windows);
+#endif
 }
 /* }}} */
 
-/* {{{ proto int ncurses_scr_set(string filename)
-   Inherits screen from file dump */
-PHP_FUNCTION(ncurses_scr_set)
+/* {{{ proto int ncurses_wrestore(resource window, string dump)
+   Copies a dump made by ncurses_putwin() back into an existing window */
+PHP_FUNCTION(ncurses_wrestore)
 {
+	zval *handle;
+	WINDOW *win;
 	char *str;
 #if PHP_MAJOR_VERSION >= 7
 	size_t str_len;
@@ -1383,11 +2412,13 @@ PHP_FUNCTION(ncurses_scr_set)
 	int str_len;
 #endif
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "s", &str, &str_len) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "s", &handle, &str, &str_len) == FAILURE) {
 		return;
 	}
-	IS_NCURSES_INITIALIZED();
-	RETURN_LONG(scr_set(str));
+
+	FETCH_WINRES(win, &handle);
+
+	RETURN_LONG(php_ncurses_dump_copy(win, str, str_len));
 }
 /* }}} */
 
@@ -1500,7 +2531,10 @@ PHP_FUNCTION(ncurses_mvaddnstr)
 	        return;
 	}
 	IS_NCURSES_INITIALIZED();	
-	RETURN_LONG(mvaddnstr(y,x,str,n));
+	if (move(y, x) == ERR) {
+		RETURN_LONG(ERR);
+	}
+	RETURN_LONG(php_ncurses_waddnstr(stdscr, str, str_len, n));
 }
 /* }}} */
 
@@ -1520,7 +2554,7 @@ PHP_FUNCTION(ncurses_addnstr)
 	        return;
 	}
 	IS_NCURSES_INITIALIZED();	
-	RETURN_LONG(addnstr(str,n));
+	RETURN_LONG(php_ncurses_waddnstr(stdscr, str, str_len, n));
 }
 /* }}} */
 
@@ -1540,7 +2574,10 @@ PHP_FUNCTION(ncurses_mvaddstr)
 	        return;
 	}
 	IS_NCURSES_INITIALIZED();
-	RETURN_LONG(mvaddstr(y,x,str));
+	if (move(y, x) == ERR) {
+		RETURN_LONG(ERR);
+	}
+	RETURN_LONG(php_ncurses_waddnstr(stdscr, str, str_len, -1));
 }
 /* }}} */
 
@@ -1569,7 +2606,10 @@ PHP_FUNCTION(ncurses_mvgetch)
 	        return;
 	}
 	IS_NCURSES_INITIALIZED();	
-	RETURN_LONG(mvgetch(y,x));
+	if (move(y, x) == ERR) {
+		RETURN_LONG(ERR);
+	}
+	RETURN_LONG(php_ncurses_wgetch(stdscr));
 }
 /* }}} */
 
@@ -1602,7 +2642,7 @@ PHP_FUNCTION(ncurses_insstr)
 		return;
 	}
 	IS_NCURSES_INITIALIZED();
-	RETURN_LONG(insstr(str));
+	RETURN_LONG(php_ncurses_winsnstr(stdscr, str, str_len));
 }
 /* }}} */
 
@@ -1686,12 +2726,17 @@ PHP_FUNCTION(ncurses_mvcur)
 PHP_FUNCTION(ncurses_init_color)
 {
 	zend_long i1,i2,i3,i4;
+	int ret;
 
 	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "llll", &i1, &i2, &i3, &i4) == FAILURE) {
 	        return;
 	}
 	IS_NCURSES_INITIALIZED();	
-	RETURN_LONG(init_color(i1,i2,i3,i4));
+	ret = init_color(i1,i2,i3,i4);
+	if (ret == OK) {
+		php_ncurses_palette_set((int)i1, (int)i2, (int)i3, (int)i4);
+	}
+	RETURN_LONG(ret);
 }
 /* }}} */
 
@@ -1774,15 +2819,15 @@ PHP_FUNCTION(ncurses_wborder)
 {
 	zend_long i1,i2,i3,i4,i5,i6,i7,i8;
 	zval *handle;
-	WINDOW **win;
+	WINDOW *win;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rllllllll", &handle, &i1, &i2, &i3, &i4, &i5, &i6, &i7, &i8) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "llllllll", &handle, &i1, &i2, &i3, &i4, &i5, &i6, &i7, &i8) == FAILURE) {
 	        return;
 	}
 
 	FETCH_WINRES(win, &handle);
 	
-	RETURN_LONG(wborder(*win,i1,i2,i3,i4,i5,i6,i7,i8));
+	RETURN_LONG(wborder(win,i1,i2,i3,i4,i5,i6,i7,i8));
 }
 /* }}} */
 
@@ -1869,15 +2914,15 @@ PHP_FUNCTION(ncurses_whline)
 {
 	zend_long i1,i2;
 	zval *handle;
-	WINDOW **win;
+	WINDOW *win;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rll", &handle, &i1, &i2) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "ll", &handle, &i1, &i2) == FAILURE) {
 	        return;
 	}
 
 	FETCH_WINRES(win, &handle);
 	
-	RETURN_LONG(whline(*win,i1,i2));
+	RETURN_LONG(whline(win,i1,i2));
 }
 /* }}} */
 
@@ -1887,14 +2932,14 @@ PHP_FUNCTION(ncurses_wvline)
 {
 	zend_long i1,i2;
 	zval *handle;
-	WINDOW **win;
+	WINDOW *win;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rll", &handle, &i1, &i2) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "ll", &handle, &i1, &i2) == FAILURE) {
 	        return;
 	}
 	FETCH_WINRES(win, &handle);
 
-	RETURN_LONG(wvline(*win,i1,i2));
+	RETURN_LONG(wvline(win,i1,i2));
 }
 /* }}} */
 
@@ -1924,15 +2969,18 @@ PHP_FUNCTION(ncurses_mvwaddstr)
 	int text_len;
 #endif
 	char *text;
-	WINDOW **w;
+	WINDOW *w;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rlls", &handle, &y, &x, &text, &text_len) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "lls", &handle, &y, &x, &text, &text_len) == FAILURE) {
 		return;
 	}
 	
 	FETCH_WINRES(w, &handle);
 
-	RETURN_LONG(mvwaddstr(*w,y,x,text));
+	if (wmove(w, y, x) == ERR) {
+		RETURN_LONG(ERR);
+	}
+	RETURN_LONG(php_ncurses_waddnstr(w, text, text_len, -1));
 }
 /* }}} */
 
@@ -1941,15 +2989,15 @@ PHP_FUNCTION(ncurses_mvwaddstr)
 PHP_FUNCTION(ncurses_wrefresh)
 {
 	zval *handle;
-	WINDOW **w;
+	WINDOW *w;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r", &handle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN, &handle) == FAILURE) {
 		return;
 	}
 
 	FETCH_WINRES(w, &handle);
 
-	RETURN_LONG(wrefresh(*w));
+	RETURN_LONG(php_ncurses_wrefresh(w));
 }
 /* }}} */
 
@@ -1959,9 +3007,9 @@ PHP_FUNCTION(ncurses_wscrl)
 {
 	zval *handle;
 	zend_long intarg;
-	WINDOW **w;
+	WINDOW *w;
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rl", &handle, &intarg) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "l", &handle, &intarg) == FAILURE) {
 		return;
 	}
 
@@ -1969,7 +3017,7 @@ PHP_FUNCTION(ncurses_wscrl)
 
 	FETCH_WINRES(w, &handle);
 
-	RETURN_LONG(wscrl(*w, intarg));
+	RETURN_LONG(wscrl(w, intarg));
 }
 /* }}} */
 
@@ -1979,9 +3027,9 @@ PHP_FUNCTION(ncurses_wsetscrreg)
 {
 	zval *handle;
 	zend_long top, bot;
-	WINDOW **w;
+	WINDOW *w;
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rll", &handle, &top, &bot) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "ll", &handle, &top, &bot) == FAILURE) {
 		return;
 	}
 
@@ -1989,7 +3037,7 @@ PHP_FUNCTION(ncurses_wsetscrreg)
 
 	FETCH_WINRES(w, &handle);
 
-	RETURN_LONG(wsetscrreg(*w, top, bot));
+	RETURN_LONG(wsetscrreg(w, top, bot));
 }
 /* }}} */
 
@@ -1999,9 +3047,9 @@ PHP_FUNCTION(ncurses_scrollok)
 {
 	zval *handle;
 	zend_bool bf;
-	WINDOW **w;
+	WINDOW *w;
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rb", &handle, &bf) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "b", &handle, &bf) == FAILURE) {
 		return;
 	}
 
@@ -2009,7 +3057,7 @@ PHP_FUNCTION(ncurses_scrollok)
 
 	FETCH_WINRES(w, &handle);
 
-	RETURN_LONG(scrollok(*w, bf));
+	RETURN_LONG(scrollok(w, bf));
 }
 /* }}} */
 
@@ -2077,8 +3125,9 @@ PHP_FUNCTION(ncurses_mousemask)
 }
 /* }}} */
 
-/* {{{ proto bool ncurses_getmouse(array &mevent)
-   Reads mouse event from queue. The content of mevent is cleared before new data is added. */
+/* {{{ proto bool ncurses_getmouse(array|NcursesMouseEvent &mevent)
+   Reads mouse event from queue. The content of mevent is cleared before new data is added,
+   an NcursesMouseEvent is filled in place. */
 PHP_FUNCTION(ncurses_getmouse)
 {
 	zval *arg;
@@ -2095,16 +3144,17 @@ PHP_FUNCTION(ncurses_getmouse)
 	}
 	IS_NCURSES_INITIALIZED();
 
+	retval = php_ncurses_getmouse(&mevent);
+
+#if PHP_VERSION_ID >= 80000
+	if (Z_TYPE_P(arg) == IS_OBJECT && Z_OBJCE_P(arg) == php_ncurses_mouse_event_ce) {
+		php_ncurses_mouse_event_fill(Z_OBJ_P(arg), &mevent);
+		RETURN_BOOL(retval == 0);
+	}
+#endif
 	zval_dtor(arg);
 	array_init(arg);
-
-	retval = getmouse(&mevent);
-
-	add_assoc_long(arg, "id", mevent.id);
-	add_assoc_long(arg, "x", mevent.x);
-	add_assoc_long(arg, "y", mevent.y);
-	add_assoc_long(arg, "z", mevent.z);
-	add_assoc_long(arg, "mmask", mevent.bstate);
+	php_ncurses_mevent_to_zval(arg, &mevent);
 
 	RETURN_BOOL(retval == 0);
 #undef FMT
@@ -2118,6 +3168,7 @@ PHP_FUNCTION(ncurses_ungetmouse)
 	zval *arg;
 #if PHP_MAJOR_VERSION >= 7
 	zval *zvalue;
+	zend_string *name;
 #else
 	zval **zvalue;
 #endif
@@ -2130,30 +3181,12 @@ PHP_FUNCTION(ncurses_ungetmouse)
 	IS_NCURSES_INITIALIZED();
 
 #if PHP_MAJOR_VERSION >= 7
-	if ((zvalue = zend_hash_str_find(Z_ARRVAL_P(arg), "id", sizeof("id")-1)) != NULL) {
-		convert_to_long_ex(zvalue);
-		mevent.id = Z_LVAL_P(zvalue);
-	}
-
-	if ((zvalue = zend_hash_str_find(Z_ARRVAL_P(arg), "x", sizeof("x")-1)) != NULL) {
-		convert_to_long_ex(zvalue);
-		mevent.x = Z_LVAL_P(zvalue);
-	}
-
-	if ((zvalue = zend_hash_str_find(Z_ARRVAL_P(arg), "y", sizeof("y")-1)) != NULL) {
-		convert_to_long_ex(zvalue);
-		mevent.y = Z_LVAL_P(zvalue);
-	}
-
-	if ((zvalue = zend_hash_str_find(Z_ARRVAL_P(arg), "z", sizeof("z")-1)) != NULL) {
-		convert_to_long_ex(zvalue);
-		mevent.z = Z_LVAL_P(zvalue);
-	}
-
-	if ((zvalue = zend_hash_str_find(Z_ARRVAL_P(arg), "mmask", sizeof("mmask")-1)) != NULL) {
-		convert_to_long_ex(zvalue);
-		mevent.bstate = Z_LVAL_P(zvalue);
-	}
+	memset(&mevent, 0, sizeof(mevent));
+	ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL_P(arg), name, zvalue) {
+		if (name) {
+			php_ncurses_mevent_field(&mevent, name, zvalue);
+		}
+	} ZEND_HASH_FOREACH_END();
 #else
 	if (zend_hash_find(Z_ARRVAL_P(arg), "id", sizeof("id"), (void **) &zvalue) == SUCCESS) {
 		convert_to_long_ex(zvalue);
@@ -2227,13 +3260,13 @@ PHP_FUNCTION(ncurses_wmouse_trafo)
 {
 	zval *handle, *x, *y;
 	int nx, ny, retval;
-	WINDOW **win;
+	WINDOW *win;
 	zend_bool toscreen;
 
 #if PHP_MAJOR_VERSION >= 7
-#define FMT "rz/z/b/"
+#define FMT PHP_NCURSES_WIN "z/z/b/"
 #else
-#define FMT "rzzb"
+#define FMT PHP_NCURSES_WIN "zzb"
 #endif
 	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, FMT, &handle, &y, &x, &toscreen) == FAILURE) {
 		return;
@@ -2247,7 +3280,7 @@ PHP_FUNCTION(ncurses_wmouse_trafo)
 	nx = Z_LVAL_P(x);
 	ny = Z_LVAL_P(y);
 
-	retval = wmouse_trafo (*win, &ny, &nx, toscreen);
+	retval = wmouse_trafo (win, &ny, &nx, toscreen);
 
 	ZVAL_LONG(x, nx);
 	ZVAL_LONG(y, ny);
@@ -2262,12 +3295,12 @@ PHP_FUNCTION(ncurses_wmouse_trafo)
 PHP_FUNCTION(ncurses_getyx)
 {
 	zval *handle, *x, *y;
-	WINDOW **win;
+	WINDOW *win;
 
 #if PHP_MAJOR_VERSION >= 7
-#define FMT "rz/z/"
+#define FMT PHP_NCURSES_WIN "z/z/"
 #else
-#define FMT "rzz"
+#define FMT PHP_NCURSES_WIN "zz"
 #endif
 	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, FMT, &handle, &y, &x) == FAILURE) {
 		return;
@@ -2278,7 +3311,7 @@ PHP_FUNCTION(ncurses_getyx)
 	convert_to_long(x);
 	convert_to_long(y);
 
-	getyx(*win, Z_LVAL_P(y), Z_LVAL_P(x));
+	getyx(win, Z_LVAL_P(y), Z_LVAL_P(x));
 #undef FMT
 }
 /* }}} */
@@ -2288,12 +3321,12 @@ PHP_FUNCTION(ncurses_getyx)
 PHP_FUNCTION(ncurses_getmaxyx)
 {
 	zval *handle, *x, *y;
-	WINDOW **win;
+	WINDOW *win;
 
 #if PHP_MAJOR_VERSION >= 7
-#define FMT "rz/z/"
+#define FMT PHP_NCURSES_WIN "z/z/"
 #else
-#define FMT "rzz"
+#define FMT PHP_NCURSES_WIN "zz"
 #endif
 	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, FMT, &handle, &y, &x) == FAILURE) {
 		return;
@@ -2304,7 +3337,7 @@ PHP_FUNCTION(ncurses_getmaxyx)
 	convert_to_long(x);
 	convert_to_long(y);
 
-	getmaxyx(*win, Z_LVAL_P(y), Z_LVAL_P(x));
+	getmaxyx(win, Z_LVAL_P(y), Z_LVAL_P(x));
 #undef FMT
 }
 /* }}} */
@@ -2314,9 +3347,9 @@ PHP_FUNCTION(ncurses_getmaxyx)
 PHP_FUNCTION(ncurses_wmove)
 {
 	zval *handle, *x, *y;
-	WINDOW **win;
+	WINDOW *win;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rzz", &handle, &y, &x) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "zz", &handle, &y, &x) == FAILURE) {
 		return;
 	}
 
@@ -2325,7 +3358,7 @@ PHP_FUNCTION(ncurses_wmove)
 	convert_to_long(x);
 	convert_to_long(y);
 
-	RETURN_LONG(wmove(*win, Z_LVAL_P(y), Z_LVAL_P(x)));
+	RETURN_LONG(wmove(win, Z_LVAL_P(y), Z_LVAL_P(x)));
 }
 /* }}} */
 
@@ -2335,15 +3368,15 @@ PHP_FUNCTION(ncurses_keypad)
 {
 	zval *handle;
 	zend_bool bf;
-	WINDOW **win;
+	WINDOW *win;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rb", &handle, &bf) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "b", &handle, &bf) == FAILURE) {
 		return;
 	}
 
 	FETCH_WINRES(win, &handle);
 
-	RETURN_LONG(keypad(*win, bf));
+	RETURN_LONG(keypad(win, bf));
 
 }
 /* }}} */
@@ -2355,15 +3388,15 @@ PHP_FUNCTION(ncurses_wcolor_set)
 {
 	zval *handle;
 	zend_long color_pair;
-	WINDOW **win;
+	WINDOW *win;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rl", &handle, &color_pair) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "l", &handle, &color_pair) == FAILURE) {
 		return;
 	}
 
   	FETCH_WINRES(win, &handle);
 
-	RETURN_LONG(wcolor_set(*win, color_pair, 0));
+	RETURN_LONG(wcolor_set(win, color_pair, 0));
 }
 /* }}} */
 #endif
@@ -2373,15 +3406,15 @@ PHP_FUNCTION(ncurses_wcolor_set)
 PHP_FUNCTION(ncurses_wclear)
 {
 	zval *handle;
-	WINDOW **win;
+	WINDOW *win;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r", &handle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN, &handle) == FAILURE) {
 		return;
 	}	
 
 	FETCH_WINRES(win, &handle);
 
-	RETURN_LONG(wclear(*win));
+	RETURN_LONG(wclear(win));
 }
 /* }}} */
 
@@ -2390,15 +3423,15 @@ PHP_FUNCTION(ncurses_wclear)
 PHP_FUNCTION(ncurses_wnoutrefresh)
 {
 	zval *handle;
-	WINDOW **win;
+	WINDOW *win;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r", &handle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN, &handle) == FAILURE) {
 		return;
 	}
 
 	FETCH_WINRES(win, &handle);
 
-	RETURN_LONG(wnoutrefresh(*win));
+	RETURN_LONG(php_ncurses_wnoutrefresh(win));
 }
 /* }}} */
 
@@ -2414,18 +3447,14 @@ PHP_FUNCTION(ncurses_waddstr)
 	int str_len;
 #endif
 	zend_long n = 0;
-	WINDOW **win;
+	WINDOW *win;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rs|l", &handle, &str, &str_len, &n) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "s|l", &handle, &str, &str_len, &n) == FAILURE) {
 		return;
 	}
 
 	FETCH_WINRES(win, &handle);
-	if (!n) {
-		RETURN_LONG(waddstr(*win, str));
-	} else {
-		RETURN_LONG(waddnstr(*win, str, n));
-	}
+	RETURN_LONG(php_ncurses_waddnstr(win, str, str_len, n ? n : -1));
 }
 /* }}} */
 
@@ -2434,15 +3463,15 @@ PHP_FUNCTION(ncurses_waddstr)
 PHP_FUNCTION(ncurses_wgetch)
 {
 	zval *handle;
-	WINDOW **win;
+	WINDOW *win;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r", &handle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN, &handle) == FAILURE) {
 		return;
 	}
 
 	FETCH_WINRES(win, &handle);
 
-	RETURN_LONG(wgetch(*win));
+	RETURN_LONG(php_ncurses_wgetch(win));
 }
 /* }}} */
 
@@ -2451,16 +3480,16 @@ PHP_FUNCTION(ncurses_wgetch)
 PHP_FUNCTION(ncurses_wattroff)
 {
 	zval *handle;
-	WINDOW **win;
+	WINDOW *win;
 	zend_long attrs;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rl", &handle, &attrs) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "l", &handle, &attrs) == FAILURE) {
 		return;
 	}
 
 	FETCH_WINRES(win, &handle);
 
-	RETURN_LONG(wattroff(*win, attrs));
+	RETURN_LONG(wattroff(win, attrs));
 }
 /* }}} */
 
@@ -2469,16 +3498,16 @@ PHP_FUNCTION(ncurses_wattroff)
 PHP_FUNCTION(ncurses_wattron)
 {
 	zval *handle;
-	WINDOW **win;
+	WINDOW *win;
 	zend_long attrs;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rl", &handle, &attrs) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "l", &handle, &attrs) == FAILURE) {
 		return;
 	}
 
 	FETCH_WINRES(win, &handle);
 
-	RETURN_LONG(wattron(*win, attrs));
+	RETURN_LONG(wattron(win, attrs));
 }
 /* }}} */
 
@@ -2487,16 +3516,16 @@ PHP_FUNCTION(ncurses_wattron)
 PHP_FUNCTION(ncurses_wattrset)
 {
 	zval *handle;
-	WINDOW **win;
+	WINDOW *win;
 	zend_long attrs;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rl", &handle, &attrs) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "l", &handle, &attrs) == FAILURE) {
 		return;
 	}
 
 	FETCH_WINRES(win, &handle);
 
-	RETURN_LONG(wattrset(*win, attrs));
+	RETURN_LONG(wattrset(win, attrs));
 }
 /* }}} */
 
@@ -2505,15 +3534,15 @@ PHP_FUNCTION(ncurses_wattrset)
 PHP_FUNCTION(ncurses_wstandend)
 {
 	zval *handle;
-	WINDOW **win;
+	WINDOW *win;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r", &handle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN, &handle) == FAILURE) {
 		return;
 	}
 
 	FETCH_WINRES(win, &handle);
 
-	RETURN_LONG(wstandend(*win));
+	RETURN_LONG(wstandend(win));
 }
 /* }}} */
 
@@ -2522,46 +3551,255 @@ PHP_FUNCTION(ncurses_wstandend)
 PHP_FUNCTION(ncurses_wstandout)
 {
 	zval *handle;
-	WINDOW **win;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN, &handle) == FAILURE) {
+		return;
+	}
+
+	FETCH_WINRES(win, &handle);
+
+	RETURN_LONG(wstandout(win));
+}
+/* }}} */
+
+/* {{{ proto int ncurses_touchwin(resource window)
+   Marks the whole window as changed, so that the next refresh redraws it */
+PHP_FUNCTION(ncurses_touchwin)
+{
+	zval *handle;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN, &handle) == FAILURE) {
+		return;
+	}
+
+	FETCH_WINRES(win, &handle);
+
+	RETURN_LONG(touchwin(win));
+}
+/* }}} */
+
+/* {{{ proto int ncurses_untouchwin(resource window)
+   Marks the whole window as unchanged since the last refresh */
+PHP_FUNCTION(ncurses_untouchwin)
+{
+	zval *handle;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN, &handle) == FAILURE) {
+		return;
+	}
+
+	FETCH_WINRES(win, &handle);
+
+	RETURN_LONG(untouchwin(win));
+}
+/* }}} */
+
+/* {{{ proto int ncurses_wtouchln(resource window, int y, int n, int changed)
+   Marks n lines starting at y as changed, or as unchanged if changed is 0 */
+PHP_FUNCTION(ncurses_wtouchln)
+{
+	zval *handle;
+	WINDOW *win;
+	zend_long y, n, changed;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "lll", &handle, &y, &n, &changed) == FAILURE) {
+		return;
+	}
+
+	FETCH_WINRES(win, &handle);
+
+	RETURN_LONG(wtouchln(win, y, n, changed));
+}
+/* }}} */
+
+/* {{{ proto bool ncurses_is_linetouched(resource window, int line)
+   Checks if line was changed since the last refresh of the window */
+PHP_FUNCTION(ncurses_is_linetouched)
+{
+	zval *handle;
+	WINDOW *win;
+	zend_long line;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "l", &handle, &line) == FAILURE) {
+		return;
+	}
+
+	FETCH_WINRES(win, &handle);
+
+	if (line < 0 || line > getmaxy(win) - 1) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Line %ld is outside of the window", (long)line);
+		RETURN_FALSE;
+	}
+
+	RETURN_BOOL(is_linetouched(win, line) == TRUE);
+}
+/* }}} */
+
+/* {{{ proto bool ncurses_is_wintouched(resource window)
+   Checks if the window was changed since its last refresh */
+PHP_FUNCTION(ncurses_is_wintouched)
+{
+	zval *handle;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN, &handle) == FAILURE) {
+		return;
+	}
+
+	FETCH_WINRES(win, &handle);
+
+	RETURN_BOOL(is_wintouched(win));
+}
+/* }}} */
+
+/* {{{ proto int ncurses_wredrawln(resource window, int beg_line, int num_lines)
+   Discards what the terminal shows for num_lines lines from beg_line, so
+   that the next refresh redraws them completely */
+PHP_FUNCTION(ncurses_wredrawln)
+{
+	zval *handle;
+	WINDOW *win;
+	zend_long beg, num;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN "ll", &handle, &beg, &num) == FAILURE) {
+		return;
+	}
+
+	FETCH_WINRES(win, &handle);
+
+	RETURN_LONG(wredrawln(win, beg, num));
+}
+/* }}} */
+
+/* {{{ proto array ncurses_wdirty_lines(resource window)
+   Returns the ranges of lines changed since the last refresh of the window
+   as a list of array(first, last) */
+PHP_FUNCTION(ncurses_wdirty_lines)
+{
+	zval *handle;
+	WINDOW *win;
+	int y, first = -1, height;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r", &handle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN, &handle) == FAILURE) {
 		return;
 	}
 
 	FETCH_WINRES(win, &handle);
 
-	RETURN_LONG(wstandout(*win));
+	array_init(return_value);
+
+	height = getmaxy(win);
+	for (y = 0; y <= height; y++) {
+		if (y < height && is_linetouched(win, y) == TRUE) {
+			if (first < 0) {
+				first = y;
+			}
+		} else if (first >= 0) {
+#if PHP_MAJOR_VERSION >= 7
+			zval range;
+
+			array_init_size(&range, 2);
+			add_next_index_long(&range, first);
+			add_next_index_long(&range, y - 1);
+			add_next_index_zval(return_value, &range);
+#else
+			zval *range;
+
+			MAKE_STD_ZVAL(range);
+			array_init(range);
+			add_next_index_long(range, first);
+			add_next_index_long(range, y - 1);
+			add_next_index_zval(return_value, range);
+#endif
+			first = -1;
+		}
+	}
 }
 /* }}} */
 
 #if HAVE_NCURSES_PANEL
+#if PHP_MAJOR_VERSION == 7
+/* {{{ php_ncurses_window_panel_set
+   Records panel as the panel showing win */
+PHP_NCURSES_API void php_ncurses_window_panel_set(WINDOW *win, zend_resource *panel)
+{
+	if (!NCURSES_G(window_panels)) {
+		NCURSES_G(window_panels) = pemalloc(sizeof(HashTable), 1);
+		zend_hash_init(NCURSES_G(window_panels), 8, NULL, NULL, 1);
+	}
+	zend_hash_index_update_ptr(NCURSES_G(window_panels), (zend_ulong)(uintptr_t)win, panel);
+}
+/* }}} */
+
+/* {{{ php_ncurses_window_panel_del
+   Forgets panel as the panel showing win, unless another one took its place */
+PHP_NCURSES_API void php_ncurses_window_panel_del(WINDOW *win, zend_resource *panel)
+{
+	if (NCURSES_G(window_panels) && win
+			&& zend_hash_index_find_ptr(NCURSES_G(window_panels), (zend_ulong)(uintptr_t)win) == panel) {
+		zend_hash_index_del(NCURSES_G(window_panels), (zend_ulong)(uintptr_t)win);
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_panel_res_replace
+   Replaces the window of panel and moves the reference to the new window resource */
+static int php_ncurses_panel_res_replace(PANEL *panel, zval *window)
+{
+	php_ncurses_panel_res *res = (php_ncurses_panel_res *)panel_userptr(panel);
+	WINDOW *old = panel_window(panel);
+	zval old_window;
+	int ret = replace_panel(panel, (WINDOW *)Z_RES_P(window)->ptr);
+
+	if (ret == OK) {
+		php_ncurses_window_panel_del(old, res->panel);
+		php_ncurses_window_panel_set((WINDOW *)Z_RES_P(window)->ptr, res->panel);
+		ZVAL_COPY_VALUE(&old_window, &res->window);
+		ZVAL_COPY(&res->window, window);
+		zval_ptr_dtor(&old_window);
+	}
+
+	return ret;
+}
+/* }}} */
+#endif
+
 /* {{{ proto resource ncurses_new_panel(resource window)
    Create a new panel and associate it with window */
 PHP_FUNCTION(ncurses_new_panel)
 {
 	zval *handle;
-	WINDOW **win;
-	PANEL **panel;
+	WINDOW *win;
+	PANEL *panel;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r", &handle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_WIN, &handle) == FAILURE) {
 		return;
 	}
 
 	FETCH_WINRES(win, &handle);
 
-	panel = (PANEL **)emalloc(sizeof(PANEL *));
-	*panel = new_panel(*win);
+	panel = new_panel(win);
 
-	if (*panel == NULL) {
-		efree(panel);
+	if (panel == NULL) {
 		RETURN_FALSE;
 	} else {
-#if PHP_MAJOR_VERSION >= 7
-		zend_resource *id = zend_register_resource(panel, le_ncurses_windows);
+#if PHP_VERSION_ID >= 80000
+		php_ncurses_panel_wrap(return_value, panel, handle);
+#elif PHP_MAJOR_VERSION >= 7
+		php_ncurses_panel_res *res = emalloc(sizeof(php_ncurses_panel_res));
+
+		res->panel = zend_register_resource(panel, le_ncurses_panels);
+		ZVAL_COPY(&res->window, handle);
+		set_panel_userptr(panel, (void*)res);
+		php_ncurses_window_panel_set(win, res->panel);
+		RETURN_RES(res->panel);
 #else
 		long id = ZEND_REGISTER_RESOURCE(return_value, panel, le_ncurses_panels);
+		set_panel_userptr(panel, (void*)id);
 #endif
-		set_panel_userptr(*panel, (void*)id);
 	}
 
 }
@@ -2573,10 +3811,12 @@ PHP_FUNCTION(ncurses_del_panel)
 {
 	zval *handle;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r", &handle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_PANEL, &handle) == FAILURE) {
 		return;
 	}
-#if PHP_MAJOR_VERSION >= 7
+#if PHP_VERSION_ID >= 80000
+	php_ncurses_panel_delete(php_ncurses_panel_from_obj(Z_OBJ_P(handle)));
+#elif PHP_MAJOR_VERSION >= 7
 	zend_list_delete(Z_RES_P(handle));
 #else
 	zend_list_delete(Z_RESVAL_P(handle));
@@ -2590,15 +3830,15 @@ PHP_FUNCTION(ncurses_del_panel)
 PHP_FUNCTION(ncurses_hide_panel)
 {
 	zval *handle;
-	PANEL **panel;
+	PANEL *panel;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r", &handle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_PANEL, &handle) == FAILURE) {
 		return;
 	}
 	
 	FETCH_PANEL(panel, &handle);
 
-	RETURN_LONG(hide_panel(*panel));
+	RETURN_LONG(hide_panel(panel));
 
 }
 /* }}} */
@@ -2608,15 +3848,15 @@ PHP_FUNCTION(ncurses_hide_panel)
 PHP_FUNCTION(ncurses_show_panel)
 {
 	zval *handle;
-	PANEL **panel;
+	PANEL *panel;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r", &handle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_PANEL, &handle) == FAILURE) {
 		return;
 	}
 
 	FETCH_PANEL(panel, &handle);
 
-	RETURN_LONG(show_panel(*panel));
+	RETURN_LONG(show_panel(panel));
 
 }
 /* }}} */
@@ -2626,15 +3866,15 @@ PHP_FUNCTION(ncurses_show_panel)
 PHP_FUNCTION(ncurses_top_panel)
 {
 	zval *handle;
-	PANEL **panel;
+	PANEL *panel;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r", &handle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_PANEL, &handle) == FAILURE) {
 		return;
 	}
 
 	FETCH_PANEL(panel, &handle);
 
-	RETURN_LONG(top_panel(*panel));
+	RETURN_LONG(top_panel(panel));
 
 }
 /* }}} */
@@ -2644,15 +3884,15 @@ PHP_FUNCTION(ncurses_top_panel)
 PHP_FUNCTION(ncurses_bottom_panel)
 {
 	zval *handle;
-	PANEL **panel;
+	PANEL *panel;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r", &handle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_PANEL, &handle) == FAILURE) {
 		return;
 	}
 
 	FETCH_PANEL(panel, &handle);
 
-	RETURN_LONG(bottom_panel(*panel));
+	RETURN_LONG(bottom_panel(panel));
 
 }
 /* }}} */
@@ -2662,16 +3902,16 @@ PHP_FUNCTION(ncurses_bottom_panel)
 PHP_FUNCTION(ncurses_move_panel)
 {
 	zval *handle;
-	PANEL **panel;
+	PANEL *panel;
 	zend_long startx, starty;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rll", &handle, &startx, &starty) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_PANEL "ll", &handle, &startx, &starty) == FAILURE) {
 		return;
 	}
 
 	FETCH_PANEL(panel, &handle);
 
-	RETURN_LONG(move_panel(*panel, startx, starty));
+	RETURN_LONG(move_panel(panel, startx, starty));
 
 }
 /* }}} */
@@ -2681,17 +3921,23 @@ PHP_FUNCTION(ncurses_move_panel)
 PHP_FUNCTION(ncurses_replace_panel)
 {
 	zval *phandle, *whandle;
-	PANEL **panel;
-	WINDOW **window;
+	PANEL *panel;
+	WINDOW *window;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "rr", &phandle, &whandle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_PANEL PHP_NCURSES_WIN, &phandle, &whandle) == FAILURE) {
 		return;
 	}
 
 	FETCH_PANEL(panel, &phandle);
 	FETCH_WINRES(window, &whandle);
 
-	RETURN_LONG(replace_panel(*panel, *window));
+#if PHP_VERSION_ID >= 80000
+	RETURN_LONG(php_ncurses_panel_replace(php_ncurses_panel_from_obj(Z_OBJ_P(phandle)), whandle));
+#elif PHP_MAJOR_VERSION >= 7
+	RETURN_LONG(php_ncurses_panel_res_replace(panel, whandle));
+#else
+	RETURN_LONG(replace_panel(panel, window));
+#endif
 
 }
 /* }}} */
@@ -2701,23 +3947,28 @@ PHP_FUNCTION(ncurses_replace_panel)
 PHP_FUNCTION(ncurses_panel_above)
 {
 	zval *phandle = NULL;
-	PANEL **panel;
+	PANEL *panel;
 	PANEL *above;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r!", &phandle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_PANEL "!", &phandle) == FAILURE) {
 		return;
 	}
 
 	if (phandle) {
 		FETCH_PANEL(panel, &phandle);
-		above = panel_above(*panel);
+		above = panel_above(panel);
 	} else {
 		above = panel_above((PANEL *)0);
 	}
 
 	if (above) {
-#if PHP_MAJOR_VERSION >= 7
-		zend_resource *id = (zend_resource *)panel_userptr(above);
+#if PHP_VERSION_ID >= 80000
+		zend_object *obj = (zend_object *)panel_userptr(above);
+
+		GC_ADDREF(obj);
+		RETURN_OBJ(obj);
+#elif PHP_MAJOR_VERSION >= 7
+		zend_resource *id = ((php_ncurses_panel_res *)panel_userptr(above))->panel;
 #if PHP_VERSION_ID < 70300
 		GC_REFCOUNT(id)++;
 #else
@@ -2740,22 +3991,27 @@ PHP_FUNCTION(ncurses_panel_above)
 PHP_FUNCTION(ncurses_panel_below)
 {
 	zval *phandle = NULL;
-	PANEL **panel;
+	PANEL *panel;
 	PANEL *below;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r!", &phandle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_PANEL "!", &phandle) == FAILURE) {
 		return;
 	}
 
 	if (phandle) {
 		FETCH_PANEL(panel, &phandle);
-		below = panel_below(*panel);
+		below = panel_below(panel);
 	} else {
 		below = panel_below((PANEL *)0);
 	}
 	if (below) {
-#if PHP_MAJOR_VERSION >= 7
-		zend_resource *id = (zend_resource *)panel_userptr(below);
+#if PHP_VERSION_ID >= 80000
+		zend_object *obj = (zend_object *)panel_userptr(below);
+
+		GC_ADDREF(obj);
+		RETURN_OBJ(obj);
+#elif PHP_MAJOR_VERSION >= 7
+		zend_resource *id = ((php_ncurses_panel_res *)panel_userptr(below))->panel;
 #if PHP_VERSION_ID < 70300
 		GC_REFCOUNT(id)++;
 #else
@@ -2778,20 +4034,24 @@ PHP_FUNCTION(ncurses_panel_below)
 PHP_FUNCTION(ncurses_panel_window)
 {
 	zval *phandle = NULL;
-	PANEL **panel;
-	WINDOW **win;
+	PANEL *panel;
+	WINDOW *win;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "r", &phandle) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, PHP_NCURSES_PANEL, &phandle) == FAILURE) {
 		return;
 	}
 
 	FETCH_PANEL(panel, &phandle);
 
-	win = (WINDOW **)emalloc(sizeof(WINDOW *));
-	*win = panel_window(*panel);
+#if PHP_VERSION_ID >= 80000
+	/* hand back the very object the panel was created or replaced with */
+	RETURN_COPY(&php_ncurses_panel_from_obj(Z_OBJ_P(phandle))->window);
+#elif PHP_MAJOR_VERSION >= 7
+	ZVAL_COPY(return_value, &((php_ncurses_panel_res *)panel_userptr(panel))->window);
+#else
+	win = panel_window(panel);
 
-	if (*win == NULL) {
-		efree(win);
+	if (win == NULL) {
 		RETURN_FALSE;
 	}
 #if PHP_MAJOR_VERSION >= 7
@@ -2799,6 +4059,7 @@ PHP_FUNCTION(ncurses_panel_window)
 #else
 	ZEND_REGISTER_RESOURCE(return_value, win, le_ncurses_windows);
 #endif
+#endif
 }
 /* }}} */
 
@@ -2807,9 +4068,249 @@ PHP_FUNCTION(ncurses_panel_window)
 PHP_FUNCTION(ncurses_update_panels)
 {
 	IS_NCURSES_INITIALIZED();
+	php_ncurses_frame_touch();
+	update_panels();
+}
+/* }}} */
+
+#if PHP_MAJOR_VERSION >= 7
+/* {{{ php_ncurses_panel_zval
+   Sets zv to a new reference to the PHP value of panel */
+static void php_ncurses_panel_zval(zval *zv, PANEL *panel)
+{
+#if PHP_VERSION_ID >= 80000
+	zend_object *obj = (zend_object *)panel_userptr(panel);
+
+	GC_ADDREF(obj);
+	ZVAL_OBJ(zv, obj);
+#else
+	zend_resource *id = ((php_ncurses_panel_res *)panel_userptr(panel))->panel;
+
+#if PHP_VERSION_ID < 70300
+	GC_REFCOUNT(id)++;
+#else
+	GC_ADDREF(id);
+#endif
+	ZVAL_RES(zv, id);
+#endif
+}
+/* }}} */
+
+/* {{{ proto resource ncurses_window_panel(resource window)
+   Returns the panel showing window, false if there is none */
+PHP_FUNCTION(ncurses_window_panel)
+{
+	zval *handle;
+	WINDOW *win;
+#if PHP_VERSION_ID < 80000
+	zend_resource *id;
+#endif
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), PHP_NCURSES_WIN, &handle) == FAILURE) {
+		return;
+	}
+
+	FETCH_WINRES(win, &handle);
+
+#if PHP_VERSION_ID >= 80000
+	if (php_ncurses_window_from_obj(Z_OBJ_P(handle))->panel) {
+		zend_object *obj = php_ncurses_window_from_obj(Z_OBJ_P(handle))->panel;
+
+		GC_ADDREF(obj);
+		RETURN_OBJ(obj);
+	}
+#else
+	if (NCURSES_G(window_panels)
+			&& (id = zend_hash_index_find_ptr(NCURSES_G(window_panels), (zend_ulong)(uintptr_t)win)) != NULL) {
+#if PHP_VERSION_ID < 70300
+		GC_REFCOUNT(id)++;
+#else
+		GC_ADDREF(id);
+#endif
+		RETURN_RES(id);
+	}
+#endif
+	RETURN_FALSE;
+}
+/* }}} */
+
+/* {{{ proto array ncurses_panel_stack(void)
+   Returns all visible panels from the bottom of the stack to the top */
+PHP_FUNCTION(ncurses_panel_stack)
+{
+	PANEL *panel = NULL;
+	zval zpanel;
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		return;
+	}
+	IS_NCURSES_INITIALIZED();
+
+	array_init(return_value);
+	while ((panel = panel_above(panel)) != NULL) {
+		php_ncurses_panel_zval(&zpanel, panel);
+		add_next_index_zval(return_value, &zpanel);
+	}
+}
+/* }}} */
+#endif
+
+#if PHP_MAJOR_VERSION >= 7
+enum {
+	PHP_NCURSES_PANEL_OP_MOVE,
+	PHP_NCURSES_PANEL_OP_SHOW,
+	PHP_NCURSES_PANEL_OP_HIDE,
+	PHP_NCURSES_PANEL_OP_TOP,
+	PHP_NCURSES_PANEL_OP_BOTTOM,
+	PHP_NCURSES_PANEL_OP_REPLACE
+};
+
+typedef struct _php_ncurses_panel_op {
+	int     op;
+	PANEL  *panel;
+	zval   *zpanel;
+	zval   *zwindow;
+	WINDOW *window;
+	int     y, x;
+} php_ncurses_panel_op;
+
+/* {{{ proto int ncurses_panels_apply(array ops [, bool doupdate])
+   Applies a list of panel operations such as array("move", panel, y, x),
+   array("top", panel) or array("replace", panel, window), then updates the
+   panel stack once. Nothing is applied if any operation is invalid.
+   Returns the number of operations that succeeded */
+PHP_FUNCTION(ncurses_panels_apply)
+{
+	zval *zops, *zop, *zv;
+	zend_bool do_update = 0;
+	php_ncurses_panel_op *ops, *op;
+	uint32_t n = 0, i;
+	zend_long applied = 0;
+	HashTable *args;
+	static const char *names[] = { "move", "show", "hide", "top", "bottom", "replace" };
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "a|b", &zops, &do_update) == FAILURE) {
+		return;
+	}
+	IS_NCURSES_INITIALIZED();
+
+	ops = safe_emalloc(zend_hash_num_elements(Z_ARRVAL_P(zops)), sizeof(php_ncurses_panel_op), 0);
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(zops), zop) {
+		ZVAL_DEREF(zop);
+		op = &ops[n];
+		if (Z_TYPE_P(zop) != IS_ARRAY
+				|| (zv = zend_hash_index_find(Z_ARRVAL_P(zop), 0)) == NULL || Z_TYPE_P(zv) != IS_STRING) {
+			php_error_docref(NULL, E_WARNING, "Operation %u must be an array starting with the operation name", n);
+			goto fail;
+		}
+		args = Z_ARRVAL_P(zop);
+
+		for (op->op = 0; op->op < (int)(sizeof(names) / sizeof(names[0])); op->op++) {
+			if (!strcasecmp(Z_STRVAL_P(zv), names[op->op])) {
+				break;
+			}
+		}
+		if (op->op == (int)(sizeof(names) / sizeof(names[0]))) {
+			php_error_docref(NULL, E_WARNING, "Operation %u has an unknown name '%s'", n, Z_STRVAL_P(zv));
+			goto fail;
+		}
+
+		if ((op->zpanel = zend_hash_index_find(args, 1)) == NULL) {
+			php_error_docref(NULL, E_WARNING, "Operation %u has no panel", n);
+			goto fail;
+		}
+		ZVAL_DEREF(op->zpanel);
+#if PHP_VERSION_ID >= 80000
+		if ((op->panel = php_ncurses_panel_fetch(op->zpanel)) == NULL) {
+#else
+		if (Z_TYPE_P(op->zpanel) != IS_RESOURCE
+				|| (op->panel = (PANEL *)zend_fetch_resource(Z_RES_P(op->zpanel), "ncurses_panel", le_ncurses_panels)) == NULL) {
+#endif
+			if (!EG(exception)) {
+				php_error_docref(NULL, E_WARNING, "Operation %u has no valid panel", n);
+			}
+			goto fail;
+		}
+
+		if (op->op == PHP_NCURSES_PANEL_OP_MOVE) {
+			zval *zy = zend_hash_index_find(args, 2), *zx = zend_hash_index_find(args, 3);
+
+			if (!zy || !zx) {
+				php_error_docref(NULL, E_WARNING, "Operation %u needs a line and a column to move to", n);
+				goto fail;
+			}
+			op->y = (int)zval_get_long(zy);
+			op->x = (int)zval_get_long(zx);
+		} else if (op->op == PHP_NCURSES_PANEL_OP_REPLACE) {
+			if ((op->zwindow = zend_hash_index_find(args, 2)) == NULL) {
+				php_error_docref(NULL, E_WARNING, "Operation %u has no window", n);
+				goto fail;
+			}
+			ZVAL_DEREF(op->zwindow);
+#if PHP_VERSION_ID >= 80000
+			if ((op->window = php_ncurses_window_fetch(op->zwindow)) == NULL) {
+#else
+			if (Z_TYPE_P(op->zwindow) != IS_RESOURCE
+					|| (op->window = (WINDOW *)zend_fetch_resource(Z_RES_P(op->zwindow), "ncurses_window", le_ncurses_windows)) == NULL) {
+#endif
+				if (!EG(exception)) {
+					php_error_docref(NULL, E_WARNING, "Operation %u has no valid window", n);
+				}
+				goto fail;
+			}
+		}
+		n++;
+	} ZEND_HASH_FOREACH_END();
+
+	for (i = 0; i < n; i++) {
+		int ret = ERR;
+
+		op = &ops[i];
+		switch (op->op) {
+			case PHP_NCURSES_PANEL_OP_MOVE:
+				ret = move_panel(op->panel, op->y, op->x);
+				break;
+			case PHP_NCURSES_PANEL_OP_SHOW:
+				ret = show_panel(op->panel);
+				break;
+			case PHP_NCURSES_PANEL_OP_HIDE:
+				ret = hide_panel(op->panel);
+				break;
+			case PHP_NCURSES_PANEL_OP_TOP:
+				ret = top_panel(op->panel);
+				break;
+			case PHP_NCURSES_PANEL_OP_BOTTOM:
+				ret = bottom_panel(op->panel);
+				break;
+			case PHP_NCURSES_PANEL_OP_REPLACE:
+#if PHP_VERSION_ID >= 80000
+				ret = php_ncurses_panel_replace(php_ncurses_panel_from_obj(Z_OBJ_P(op->zpanel)), op->zwindow);
+#else
+				ret = php_ncurses_panel_res_replace(op->panel, op->zwindow);
+#endif
+				break;
+		}
+		if (ret == OK) {
+			applied++;
+		}
+	}
+	efree(ops);
+
+	php_ncurses_frame_touch();
 	update_panels();
+	if (do_update) {
+		php_ncurses_doupdate();
+	}
+
+	RETURN_LONG(applied);
+
+fail:
+	efree(ops);
+	RETURN_FALSE;
 }
 /* }}} */
+#endif
 #endif /* HAVE_NCURSES_PANEL */
 
 /*
@@ -0,0 +1,1037 @@
+/*
+   +----------------------------------------------------------------------+
+   | PHP Version 5                                                        |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1997-2006 The PHP Group                                |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_ini.h"
+#include "php_ncurses.h"
+#include "ext/standard/php_smart_string.h"
+
+#include <errno.h>
+
+#ifndef PHP_WIN32
+# include <unistd.h>
+#endif
+
+/* Headless terminal, started by ncurses_headless_init().
+ *
+ * curses writes to a temporary file instead of the tty. Whatever it wrote
+ * is fed into a small emulator of the xterm control sequences curses uses,
+ * which keeps the resulting screen as a grid of cells. Tests can then
+ * compare that grid, or the raw output, against golden values without any
+ * terminal attached. Input comes from a second temporary file that stays
+ * empty, so reads never block. */
+
+#if PHP_MAJOR_VERSION >= 7 && !defined(PHP_WIN32)
+
+#define PHP_NCURSES_VT_MAX_PARAMS 16
+
+/* ncurses_headless_output() returns at most this much, older output is dropped */
+#define PHP_NCURSES_VT_RAW_MAX (1024 * 1024)
+
+enum {
+	PHP_NCURSES_VT_GROUND,
+	PHP_NCURSES_VT_ESC,
+	PHP_NCURSES_VT_CSI,
+	PHP_NCURSES_VT_OSC,
+	PHP_NCURSES_VT_CHARSET,
+	PHP_NCURSES_VT_IGNORE_ONE
+};
+
+typedef struct _php_ncurses_vt_cell {
+	uint32_t ch;    /* code point, 0 for the right half of a wide character */
+	uint32_t attr;  /* A_* attributes */
+	int16_t  fg;    /* -1 is the default color */
+	int16_t  bg;
+} php_ncurses_vt_cell;
+
+typedef struct _php_ncurses_vt {
+	int rows;
+	int cols;
+	php_ncurses_vt_cell *cells;
+
+	/* cursor and rendition */
+	int y, x;
+	int wrap_pending;
+	int top, bottom;
+	uint32_t attr;
+	int16_t fg, bg;
+	int acs;
+	uint32_t last_ch;
+
+	/* ESC 7 */
+	int saved_y, saved_x;
+	uint32_t saved_attr;
+	int16_t saved_fg, saved_bg;
+	int saved_acs;
+
+	/* parser */
+	int state;
+	int params[PHP_NCURSES_VT_MAX_PARAMS];
+	int nparams;
+	int private_mode;
+	uint32_t cp;
+	int utf8_left;
+
+	FILE *out;
+	FILE *in;
+	SCREEN *screen;
+	smart_string raw;
+} php_ncurses_vt;
+
+/* DEC special graphics, '_' through '~' */
+static const uint32_t php_ncurses_vt_acs[] = {
+	0x0020, 0x25C6, 0x2592, 0x2409, 0x240C, 0x240D, 0x240A, 0x00B0,
+	0x00B1, 0x2424, 0x240B, 0x2518, 0x2510, 0x250C, 0x2514, 0x253C,
+	0x23BA, 0x23BB, 0x2500, 0x23BC, 0x23BD, 0x251C, 0x2524, 0x2534,
+	0x252C, 0x2502, 0x2264, 0x2265, 0x03C0, 0x2260, 0x00A3, 0x00B7
+};
+
+/* {{{ php_ncurses_vt_width
+   Columns taken by a code point, East Asian wide characters take two */
+static int php_ncurses_vt_width(uint32_t c)
+{
+	if (c < 0x1100) {
+		return 1;
+	}
+	if ((c <= 0x115F) ||
+		(c >= 0x2E80 && c <= 0xA4CF && c != 0x303F) ||
+		(c >= 0xAC00 && c <= 0xD7A3) ||
+		(c >= 0xF900 && c <= 0xFAFF) ||
+		(c >= 0xFE30 && c <= 0xFE4F) ||
+		(c >= 0xFF00 && c <= 0xFF60) ||
+		(c >= 0xFFE0 && c <= 0xFFE6) ||
+		(c >= 0x1F300 && c <= 0x1F64F) ||
+		(c >= 0x1F900 && c <= 0x1F9FF) ||
+		(c >= 0x20000 && c <= 0x3FFFD)) {
+		return 2;
+	}
+	return 1;
+}
+/* }}} */
+
+#define PHP_NCURSES_VT_CELL(vt, y, x) (&(vt)->cells[(y) * (vt)->cols + (x)])
+
+/* {{{ php_ncurses_vt_erase
+   Blanks n cells starting at y, x with the current background */
+static void php_ncurses_vt_erase(php_ncurses_vt *vt, int y, int x, int n)
+{
+	php_ncurses_vt_cell *cell = PHP_NCURSES_VT_CELL(vt, y, x);
+
+	if (n > vt->cols - x) {
+		n = vt->cols - x;
+	}
+	while (n-- > 0) {
+		cell->ch = ' ';
+		cell->attr = 0;
+		cell->fg = -1;
+		cell->bg = vt->bg;
+		cell++;
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_vt_scroll
+   Scrolls the lines top..bottom up by n lines, down for negative n */
+static void php_ncurses_vt_scroll(php_ncurses_vt *vt, int top, int bottom, int n)
+{
+	int lines = bottom - top + 1, i;
+	size_t row = (size_t)vt->cols * sizeof(php_ncurses_vt_cell);
+
+	if (n > lines) {
+		n = lines;
+	} else if (n < -lines) {
+		n = -lines;
+	}
+
+	if (n > 0) {
+		memmove(PHP_NCURSES_VT_CELL(vt, top, 0), PHP_NCURSES_VT_CELL(vt, top + n, 0), (lines - n) * row);
+		for (i = bottom - n + 1; i <= bottom; i++) {
+			php_ncurses_vt_erase(vt, i, 0, vt->cols);
+		}
+	} else if (n < 0) {
+		n = -n;
+		memmove(PHP_NCURSES_VT_CELL(vt, top + n, 0), PHP_NCURSES_VT_CELL(vt, top, 0), (lines - n) * row);
+		for (i = top; i < top + n; i++) {
+			php_ncurses_vt_erase(vt, i, 0, vt->cols);
+		}
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_vt_linefeed */
+static void php_ncurses_vt_linefeed(php_ncurses_vt *vt)
+{
+	vt->wrap_pending = 0;
+	if (vt->y == vt->bottom) {
+		php_ncurses_vt_scroll(vt, vt->top, vt->bottom, 1);
+	} else if (vt->y < vt->rows - 1) {
+		vt->y++;
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_vt_reset */
+static void php_ncurses_vt_reset(php_ncurses_vt *vt)
+{
+	int y;
+
+	vt->y = vt->x = 0;
+	vt->wrap_pending = 0;
+	vt->top = 0;
+	vt->bottom = vt->rows - 1;
+	vt->attr = 0;
+	vt->fg = vt->bg = -1;
+	vt->acs = 0;
+	vt->last_ch = ' ';
+	vt->saved_y = vt->saved_x = 0;
+	vt->saved_attr = 0;
+	vt->saved_fg = vt->saved_bg = -1;
+	vt->saved_acs = 0;
+	vt->state = PHP_NCURSES_VT_GROUND;
+
+	for (y = 0; y < vt->rows; y++) {
+		php_ncurses_vt_erase(vt, y, 0, vt->cols);
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_vt_put
+   Writes a printable character at the cursor */
+static void php_ncurses_vt_put(php_ncurses_vt *vt, uint32_t ch)
+{
+	php_ncurses_vt_cell *cell;
+	int width;
+
+	if (vt->acs && ch >= '_' && ch <= '~') {
+		ch = php_ncurses_vt_acs[ch - '_'];
+	}
+	width = php_ncurses_vt_width(ch);
+
+	if (vt->wrap_pending || vt->x + width > vt->cols) {
+		vt->x = 0;
+		php_ncurses_vt_linefeed(vt);
+	}
+	if (width == 2 && vt->x + 1 >= vt->cols) {
+		/* no room for both halves even on a fresh line, as with one column */
+		ch = ' ';
+		width = 1;
+	}
+
+	cell = PHP_NCURSES_VT_CELL(vt, vt->y, vt->x);
+	cell->ch = ch;
+	cell->attr = vt->attr;
+	cell->fg = vt->fg;
+	cell->bg = vt->bg;
+	if (width == 2) {
+		cell[1] = cell[0];
+		cell[1].ch = 0;
+	}
+	vt->last_ch = ch;
+
+	vt->x += width;
+	if (vt->x >= vt->cols) {
+		vt->x = vt->cols - 1;
+		vt->wrap_pending = 1;
+	}
+}
+/* }}} */
+
+#define PHP_NCURSES_VT_PARAM(vt, i, def) \
+	((vt)->nparams > (i) && (vt)->params[i] > 0 ? (vt)->params[i] : (def))
+
+/* {{{ php_ncurses_vt_sgr */
+static void php_ncurses_vt_sgr(php_ncurses_vt *vt)
+{
+	int i, p;
+
+	if (vt->nparams == 0) {
+		vt->nparams = 1;
+		vt->params[0] = 0;
+	}
+
+	for (i = 0; i < vt->nparams; i++) {
+		p = vt->params[i];
+		switch (p) {
+			case 0:  vt->attr = 0; vt->fg = vt->bg = -1; break;
+			case 1:  vt->attr |= A_BOLD; break;
+			case 2:  vt->attr |= A_DIM; break;
+			case 4:  vt->attr |= A_UNDERLINE; break;
+			case 5:  vt->attr |= A_BLINK; break;
+			case 7:  vt->attr |= A_REVERSE; break;
+			case 8:  vt->attr |= A_INVIS; break;
+			case 22: vt->attr &= ~(A_BOLD | A_DIM); break;
+			case 24: vt->attr &= ~A_UNDERLINE; break;
+			case 25: vt->attr &= ~A_BLINK; break;
+			case 27: vt->attr &= ~A_REVERSE; break;
+			case 28: vt->attr &= ~A_INVIS; break;
+			case 39: vt->fg = -1; break;
+			case 49: vt->bg = -1; break;
+			case 38:
+			case 48:
+				/* 38;5;n and 48;5;n */
+				if (i + 2 < vt->nparams && vt->params[i + 1] == 5) {
+					if (p == 38) {
+						vt->fg = (int16_t)vt->params[i + 2];
+					} else {
+						vt->bg = (int16_t)vt->params[i + 2];
+					}
+					i += 2;
+				}
+				break;
+			default:
+				if (p >= 30 && p <= 37) {
+					vt->fg = p - 30;
+				} else if (p >= 40 && p <= 47) {
+					vt->bg = p - 40;
+				} else if (p >= 90 && p <= 97) {
+					vt->fg = p - 90 + 8;
+				} else if (p >= 100 && p <= 107) {
+					vt->bg = p - 100 + 8;
+				}
+				break;
+		}
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_vt_csi
+   Executes a control sequence with final byte c */
+static void php_ncurses_vt_csi(php_ncurses_vt *vt, unsigned char c)
+{
+	int n = PHP_NCURSES_VT_PARAM(vt, 0, 1), y, x;
+	php_ncurses_vt_cell *cell;
+
+	if (vt->private_mode) {
+		/* mode switches like ?1049h and ?25l do not change the grid */
+		return;
+	}
+	if (c != 'b') {
+		vt->wrap_pending = 0;
+	}
+
+	switch (c) {
+		case 'H':
+		case 'f':
+			vt->y = MIN(PHP_NCURSES_VT_PARAM(vt, 0, 1), vt->rows) - 1;
+			vt->x = MIN(PHP_NCURSES_VT_PARAM(vt, 1, 1), vt->cols) - 1;
+			break;
+		case 'A':
+			vt->y = MAX(vt->y - n, vt->y >= vt->top ? vt->top : 0);
+			break;
+		case 'B':
+			vt->y = MIN(vt->y + n, vt->y <= vt->bottom ? vt->bottom : vt->rows - 1);
+			break;
+		case 'C':
+			vt->x = MIN(vt->x + n, vt->cols - 1);
+			break;
+		case 'D':
+			vt->x = MAX(vt->x - n, 0);
+			break;
+		case 'E':
+			vt->y = MIN(vt->y + n, vt->rows - 1);
+			vt->x = 0;
+			break;
+		case 'F':
+			vt->y = MAX(vt->y - n, 0);
+			vt->x = 0;
+			break;
+		case 'G':
+		case '`':
+			vt->x = MIN(n, vt->cols) - 1;
+			break;
+		case 'd':
+			vt->y = MIN(n, vt->rows) - 1;
+			break;
+		case 'J':
+			switch (PHP_NCURSES_VT_PARAM(vt, 0, 0)) {
+				case 0:
+					php_ncurses_vt_erase(vt, vt->y, vt->x, vt->cols);
+					for (y = vt->y + 1; y < vt->rows; y++) {
+						php_ncurses_vt_erase(vt, y, 0, vt->cols);
+					}
+					break;
+				case 1:
+					for (y = 0; y < vt->y; y++) {
+						php_ncurses_vt_erase(vt, y, 0, vt->cols);
+					}
+					php_ncurses_vt_erase(vt, vt->y, 0, vt->x + 1);
+					break;
+				default:
+					for (y = 0; y < vt->rows; y++) {
+						php_ncurses_vt_erase(vt, y, 0, vt->cols);
+					}
+					break;
+			}
+			break;
+		case 'K':
+			switch (PHP_NCURSES_VT_PARAM(vt, 0, 0)) {
+				case 0:
+					php_ncurses_vt_erase(vt, vt->y, vt->x, vt->cols);
+					break;
+				case 1:
+					php_ncurses_vt_erase(vt, vt->y, 0, vt->x + 1);
+					break;
+				default:
+					php_ncurses_vt_erase(vt, vt->y, 0, vt->cols);
+					break;
+			}
+			break;
+		case 'L':
+			if (vt->y >= vt->top && vt->y <= vt->bottom) {
+				php_ncurses_vt_scroll(vt, vt->y, vt->bottom, -n);
+			}
+			break;
+		case 'M':
+			if (vt->y >= vt->top && vt->y <= vt->bottom) {
+				php_ncurses_vt_scroll(vt, vt->y, vt->bottom, n);
+			}
+			break;
+		case '@':
+			n = MIN(n, vt->cols - vt->x);
+			cell = PHP_NCURSES_VT_CELL(vt, vt->y, vt->x);
+			memmove(cell + n, cell, (vt->cols - vt->x - n) * sizeof(php_ncurses_vt_cell));
+			php_ncurses_vt_erase(vt, vt->y, vt->x, n);
+			break;
+		case 'P':
+			n = MIN(n, vt->cols - vt->x);
+			cell = PHP_NCURSES_VT_CELL(vt, vt->y, vt->x);
+			memmove(cell, cell + n, (vt->cols - vt->x - n) * sizeof(php_ncurses_vt_cell));
+			php_ncurses_vt_erase(vt, vt->y, vt->cols - n, n);
+			break;
+		case 'X':
+			php_ncurses_vt_erase(vt, vt->y, vt->x, n);
+			break;
+		case 'S':
+			php_ncurses_vt_scroll(vt, vt->top, vt->bottom, n);
+			break;
+		case 'T':
+			php_ncurses_vt_scroll(vt, vt->top, vt->bottom, -n);
+			break;
+		case 'b':
+			/* rep: repeat the last character */
+			for (x = 0; x < n; x++) {
+				php_ncurses_vt_put(vt, vt->last_ch);
+			}
+			break;
+		case 'r':
+			vt->top = PHP_NCURSES_VT_PARAM(vt, 0, 1) - 1;
+			vt->bottom = MIN(PHP_NCURSES_VT_PARAM(vt, 1, vt->rows), vt->rows) - 1;
+			if (vt->top >= vt->bottom) {
+				vt->top = 0;
+				vt->bottom = vt->rows - 1;
+			}
+			vt->y = vt->x = 0;
+			break;
+		case 'm':
+			php_ncurses_vt_sgr(vt);
+			break;
+		case 's':
+			vt->saved_y = vt->y;
+			vt->saved_x = vt->x;
+			break;
+		case 'u':
+			vt->y = vt->saved_y;
+			vt->x = vt->saved_x;
+			break;
+		default:
+			/* window manipulation, reports and the like */
+			break;
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_vt_esc
+   Executes ESC followed by c */
+static void php_ncurses_vt_esc(php_ncurses_vt *vt, unsigned char c)
+{
+	vt->state = PHP_NCURSES_VT_GROUND;
+
+	switch (c) {
+		case '[':
+			vt->state = PHP_NCURSES_VT_CSI;
+			vt->nparams = 0;
+			vt->private_mode = 0;
+			memset(vt->params, 0, sizeof(vt->params));
+			break;
+		case ']':
+		case 'P':
+		case '_':
+		case '^':
+			vt->state = PHP_NCURSES_VT_OSC;
+			break;
+		case '(':
+			vt->state = PHP_NCURSES_VT_CHARSET;
+			break;
+		case ')':
+		case '*':
+		case '+':
+		case '#':
+		case ' ':
+			vt->state = PHP_NCURSES_VT_IGNORE_ONE;
+			break;
+		case '7':
+			vt->saved_y = vt->y;
+			vt->saved_x = vt->x;
+			vt->saved_attr = vt->attr;
+			vt->saved_fg = vt->fg;
+			vt->saved_bg = vt->bg;
+			vt->saved_acs = vt->acs;
+			break;
+		case '8':
+			vt->y = vt->saved_y;
+			vt->x = vt->saved_x;
+			vt->attr = vt->saved_attr;
+			vt->fg = vt->saved_fg;
+			vt->bg = vt->saved_bg;
+			vt->acs = vt->saved_acs;
+			vt->wrap_pending = 0;
+			break;
+		case 'D':
+			php_ncurses_vt_linefeed(vt);
+			break;
+		case 'E':
+			vt->x = 0;
+			php_ncurses_vt_linefeed(vt);
+			break;
+		case 'M':
+			vt->wrap_pending = 0;
+			if (vt->y == vt->top) {
+				php_ncurses_vt_scroll(vt, vt->top, vt->bottom, -1);
+			} else if (vt->y > 0) {
+				vt->y--;
+			}
+			break;
+		case 'c':
+			php_ncurses_vt_reset(vt);
+			break;
+		default:
+			/* keypad modes and the like */
+			break;
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_vt_feed
+   Runs output of curses through the emulator */
+static void php_ncurses_vt_feed(php_ncurses_vt *vt, const unsigned char *s, size_t len)
+{
+	unsigned char c;
+
+	while (len--) {
+		c = *s++;
+
+		switch (vt->state) {
+			case PHP_NCURSES_VT_ESC:
+				php_ncurses_vt_esc(vt, c);
+				continue;
+
+			case PHP_NCURSES_VT_CSI:
+				if (c >= '0' && c <= '9') {
+					if (vt->nparams == 0) {
+						vt->nparams = 1;
+					}
+					vt->params[vt->nparams - 1] = vt->params[vt->nparams - 1] * 10 + (c - '0');
+				} else if (c == ';') {
+					if (vt->nparams == 0) {
+						vt->nparams = 1;
+					}
+					if (vt->nparams < PHP_NCURSES_VT_MAX_PARAMS) {
+						vt->nparams++;
+					}
+				} else if (c >= 0x3c && c <= 0x3f) {
+					vt->private_mode = 1;
+				} else if (c >= 0x40 && c <= 0x7e) {
+					vt->state = PHP_NCURSES_VT_GROUND;
+					php_ncurses_vt_csi(vt, c);
+				} else if (c == 0x1b) {
+					vt->state = PHP_NCURSES_VT_ESC;
+				}
+				continue;
+
+			case PHP_NCURSES_VT_OSC:
+				/* terminated by BEL or ST */
+				if (c == 0x07) {
+					vt->state = PHP_NCURSES_VT_GROUND;
+				} else if (c == 0x1b) {
+					vt->state = PHP_NCURSES_VT_IGNORE_ONE;
+				}
+				continue;
+
+			case PHP_NCURSES_VT_CHARSET:
+				vt->acs = (c == '0');
+				vt->state = PHP_NCURSES_VT_GROUND;
+				continue;
+
+			case PHP_NCURSES_VT_IGNORE_ONE:
+				vt->state = PHP_NCURSES_VT_GROUND;
+				continue;
+		}
+
+		/* ground state: UTF-8 continuation */
+		if (vt->utf8_left) {
+			if ((c & 0xC0) == 0x80) {
+				vt->cp = (vt->cp << 6) | (c & 0x3F);
+				if (--vt->utf8_left == 0) {
+					php_ncurses_vt_put(vt, vt->cp);
+				}
+				continue;
+			}
+			vt->utf8_left = 0;
+		}
+
+		if (c >= 0x80) {
+			if ((c & 0xE0) == 0xC0) {
+				vt->cp = c & 0x1F;
+				vt->utf8_left = 1;
+			} else if ((c & 0xF0) == 0xE0) {
+				vt->cp = c & 0x0F;
+				vt->utf8_left = 2;
+			} else if ((c & 0xF8) == 0xF0) {
+				vt->cp = c & 0x07;
+				vt->utf8_left = 3;
+			} else {
+				php_ncurses_vt_put(vt, c);
+			}
+			continue;
+		}
+
+		switch (c) {
+			case 0x1b:
+				vt->state = PHP_NCURSES_VT_ESC;
+				break;
+			case '\r':
+				vt->x = 0;
+				vt->wrap_pending = 0;
+				break;
+			case '\n':
+			case '\v':
+			case '\f':
+				php_ncurses_vt_linefeed(vt);
+				break;
+			case '\b':
+				if (vt->x > 0) {
+					vt->x--;
+				}
+				vt->wrap_pending = 0;
+				break;
+			case '\t':
+				vt->x = MIN((vt->x / 8 + 1) * 8, vt->cols - 1);
+				break;
+			default:
+				if (c >= 0x20 && c != 0x7f) {
+					php_ncurses_vt_put(vt, c);
+				}
+				break;
+		}
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_vt_free */
+static void php_ncurses_vt_free(php_ncurses_vt *vt)
+{
+	if (vt->screen) {
+		delscreen(vt->screen);
+	}
+	if (vt->out) {
+		fclose(vt->out);
+	}
+	if (vt->in) {
+		fclose(vt->in);
+	}
+	smart_string_free(&vt->raw);
+	efree(vt->cells);
+	efree(vt);
+}
+/* }}} */
+
+/* {{{ php_ncurses_vt_record
+   Keeps buf for ncurses_headless_output(), up to PHP_NCURSES_VT_RAW_MAX bytes */
+static void php_ncurses_vt_record(php_ncurses_vt *vt, const char *buf, size_t len)
+{
+	size_t drop;
+
+	if (len >= PHP_NCURSES_VT_RAW_MAX) {
+		buf += len - PHP_NCURSES_VT_RAW_MAX;
+		len = PHP_NCURSES_VT_RAW_MAX;
+		vt->raw.len = 0;
+	} else if (vt->raw.len + len > PHP_NCURSES_VT_RAW_MAX) {
+		drop = vt->raw.len + len - PHP_NCURSES_VT_RAW_MAX;
+		memmove(vt->raw.c, vt->raw.c + drop, vt->raw.len - drop);
+		vt->raw.len -= drop;
+	}
+	smart_string_appendl(&vt->raw, buf, len);
+}
+/* }}} */
+
+/* {{{ php_ncurses_headless_pump
+   Feeds everything curses wrote since the last call into the emulator */
+PHP_NCURSES_API void php_ncurses_headless_pump(void)
+{
+	php_ncurses_vt *vt = NCURSES_G(headless);
+	unsigned char buf[4096];
+	ssize_t n;
+	off_t offset = 0;
+	int fd;
+
+	if (!vt) {
+		return;
+	}
+
+	fflush(vt->out);
+	fd = fileno(vt->out);
+
+	while ((n = pread(fd, buf, sizeof(buf), offset)) > 0) {
+		php_ncurses_vt_feed(vt, buf, (size_t)n);
+		php_ncurses_vt_record(vt, (const char *)buf, (size_t)n);
+		offset += n;
+	}
+
+	if (offset) {
+		if (ftruncate(fd, 0) == 0) {
+			fseek(vt->out, 0, SEEK_SET);
+		}
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_headless_feed
+   Passes output through the emulator as if curses had written it */
+PHP_NCURSES_API void php_ncurses_headless_feed(const char *buf, size_t len)
+{
+	php_ncurses_vt *vt = NCURSES_G(headless);
+
+	if (vt) {
+		php_ncurses_vt_feed(vt, (const unsigned char *)buf, len);
+		php_ncurses_vt_record(vt, buf, len);
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_headless_orphan
+   Deletes the panels of the main screen and marks its windows as deleted,
+   delscreen() is about to free them and a later delwin() must not run */
+static void php_ncurses_headless_orphan(void)
+{
+#if PHP_VERSION_ID >= 80000
+	zend_objects_store *store = &EG(objects_store);
+	zend_object *object;
+	php_ncurses_window *win;
+	uint32_t i;
+
+# if HAVE_NCURSES_PANEL
+	/* panels first, while the windows they show are still there */
+	for (i = 1; i < store->top; i++) {
+		object = store->object_buckets[i];
+		if (IS_OBJ_VALID(object) && instanceof_function(object->ce, php_ncurses_panel_ce)) {
+			php_ncurses_panel *panel = php_ncurses_panel_from_obj(object);
+
+			if (Z_TYPE(panel->window) == IS_OBJECT && !Z_NCURSES_WINDOW_P(&panel->window)->screen) {
+				php_ncurses_panel_delete(panel);
+			}
+		}
+	}
+# endif
+	for (i = 1; i < store->top; i++) {
+		object = store->object_buckets[i];
+		if (IS_OBJ_VALID(object) && instanceof_function(object->ce, php_ncurses_window_ce)) {
+			win = php_ncurses_window_from_obj(object);
+			if (!win->screen) {
+				win->win = NULL;
+			}
+		}
+	}
+#else
+	zend_resource *res;
+
+# if HAVE_NCURSES_PANEL
+	ZEND_HASH_FOREACH_PTR(&EG(regular_list), res) {
+		if (res->type == le_ncurses_panels && res->ptr) {
+			PANEL *panel = (PANEL *)res->ptr;
+			php_ncurses_panel_res *data = (php_ncurses_panel_res *)panel_userptr(panel);
+
+			del_panel(panel);
+			res->ptr = NULL;
+			if (data) {
+				zval_ptr_dtor(&data->window);
+				efree(data);
+			}
+		}
+	} ZEND_HASH_FOREACH_END();
+	if (NCURSES_G(window_panels)) {
+		zend_hash_clean(NCURSES_G(window_panels));
+	}
+# endif
+	ZEND_HASH_FOREACH_PTR(&EG(regular_list), res) {
+		if (res->type == le_ncurses_windows) {
+			res->ptr = NULL;
+		}
+	} ZEND_HASH_FOREACH_END();
+#endif
+}
+/* }}} */
+
+/* {{{ php_ncurses_headless_stdscr
+   Points the STDSCR constant, deleted with the previous terminal, at stdscr */
+static void php_ncurses_headless_stdscr(void)
+{
+	zval *zscr = zend_get_constant_str("STDSCR", sizeof("STDSCR")-1);
+
+	if (!zscr) {
+		return;
+	}
+#if PHP_VERSION_ID >= 80000
+	if (Z_TYPE_P(zscr) == IS_OBJECT && Z_OBJCE_P(zscr) == php_ncurses_window_ce
+			&& !Z_NCURSES_WINDOW_P(zscr)->win) {
+		Z_NCURSES_WINDOW_P(zscr)->win = stdscr;
+	}
+#else
+	if (Z_TYPE_P(zscr) == IS_RESOURCE && Z_RES_P(zscr)->type == le_ncurses_windows
+			&& !Z_RES_P(zscr)->ptr) {
+		Z_RES_P(zscr)->ptr = stdscr;
+	}
+#endif
+}
+/* }}} */
+
+/* {{{ php_ncurses_headless_shutdown
+   Ends curses on the headless terminal and frees it, together with the
+   windows and panels made on it */
+PHP_NCURSES_API void php_ncurses_headless_shutdown(void)
+{
+	php_ncurses_vt *vt = NCURSES_G(headless);
+	SCREEN *current;
+
+	if (!vt) {
+		return;
+	}
+
+	current = set_term(vt->screen);
+	if (!isendwin()) {
+		endwin();
+	}
+	php_ncurses_headless_orphan();
+	if (current != vt->screen) {
+		set_term(current);
+	}
+
+	if (NCURSES_G(main_term).screen == vt->screen) {
+		NCURSES_G(main_term).screen = NULL;
+	}
+	php_ncurses_vt_free(vt);
+	NCURSES_G(headless) = NULL;
+}
+/* }}} */
+
+/* {{{ proto bool ncurses_headless_init([int rows [, int cols [, string term]]])
+   Initializes ncurses on an emulated terminal of rows x cols instead of the tty */
+PHP_FUNCTION(ncurses_headless_init)
+{
+	zend_long rows = 24, cols = 80;
+	char *term = "xterm", *saved;
+	size_t term_len;
+	zend_bool cached;
+	php_ncurses_vt *vt;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "|lls", &rows, &cols, &term, &term_len) == FAILURE) {
+		return;
+	}
+
+	if (NCURSES_G(headless)) {
+		if (!isendwin()) {
+			php_error_docref(NULL, E_WARNING, "A headless terminal is already running, call ncurses_end() first");
+			RETURN_FALSE;
+		}
+	}
+	if (rows < 1 || rows > 1000 || cols < 1 || cols > 1000) {
+		php_error_docref(NULL, E_WARNING, "The terminal size must be between 1 and 1000 in both directions");
+		RETURN_FALSE;
+	}
+
+#if PHP_VERSION_ID >= 80000
+	php_ncurses_screen_main();
+#endif
+	php_ncurses_headless_shutdown();
+
+	vt = ecalloc(1, sizeof(php_ncurses_vt));
+	vt->rows = (int)rows;
+	vt->cols = (int)cols;
+	vt->cells = safe_emalloc((size_t)rows, cols * sizeof(php_ncurses_vt_cell), 0);
+	php_ncurses_vt_reset(vt);
+
+	vt->out = tmpfile();
+	vt->in = tmpfile();
+	if (!vt->out || !vt->in) {
+		php_error_docref(NULL, E_WARNING, "Unable to create the terminal files: %s", strerror(errno));
+		php_ncurses_vt_free(vt);
+		RETURN_FALSE;
+	}
+
+	/* the emulator decodes UTF-8, so that is what curses should send */
+	php_ncurses_setup_locale(1);
+	saved = php_ncurses_terminfo_begin(term, &cached);
+	vt->screen = newterm(term, vt->out, vt->in);
+	php_ncurses_terminfo_end(saved, cached);
+	if (!vt->screen) {
+		php_error_docref(NULL, E_WARNING, "Unable to start a terminal of type %s", term);
+		php_ncurses_vt_free(vt);
+		RETURN_FALSE;
+	}
+	resizeterm(vt->rows, vt->cols);
+
+	NCURSES_G(headless) = vt;
+	NCURSES_G(main_term).screen = vt->screen;
+	NCURSES_G(input_fd) = fileno(vt->in);
+	NCURSES_G(output_fd) = fileno(vt->out);
+	php_ncurses_setup_screen();
+	php_ncurses_headless_stdscr();
+	php_ncurses_acs_store(term);
+
+	RETURN_TRUE;
+}
+/* }}} */
+
+/* {{{ php_ncurses_vt_utf8
+   Appends the UTF-8 encoding of c */
+static void php_ncurses_vt_utf8(smart_string *s, uint32_t c)
+{
+	if (c < 0x80) {
+		smart_string_appendc(s, (char)c);
+	} else if (c < 0x800) {
+		smart_string_appendc(s, (char)(0xC0 | (c >> 6)));
+		smart_string_appendc(s, (char)(0x80 | (c & 0x3F)));
+	} else if (c < 0x10000) {
+		smart_string_appendc(s, (char)(0xE0 | (c >> 12)));
+		smart_string_appendc(s, (char)(0x80 | ((c >> 6) & 0x3F)));
+		smart_string_appendc(s, (char)(0x80 | (c & 0x3F)));
+	} else {
+		smart_string_appendc(s, (char)(0xF0 | (c >> 18)));
+		smart_string_appendc(s, (char)(0x80 | ((c >> 12) & 0x3F)));
+		smart_string_appendc(s, (char)(0x80 | ((c >> 6) & 0x3F)));
+		smart_string_appendc(s, (char)(0x80 | (c & 0x3F)));
+	}
+}
+/* }}} */
+
+/* {{{ proto array ncurses_headless_screen([bool cells])
+   Returns the emulated screen as one UTF-8 string per row, or with cells as
+   rows of arrays with the keys ch, attr, fg and bg */
+PHP_FUNCTION(ncurses_headless_screen)
+{
+	zend_bool with_cells = 0;
+	php_ncurses_vt *vt;
+	php_ncurses_vt_cell *cell;
+	smart_string line = {0};
+	zval row, entry;
+	int y, x;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "|b", &with_cells) == FAILURE) {
+		return;
+	}
+
+	if ((vt = NCURSES_G(headless)) == NULL) {
+		php_error_docref(NULL, E_WARNING, "No headless terminal is running, see ncurses_headless_init()");
+		RETURN_FALSE;
+	}
+
+	php_ncurses_headless_pump();
+
+	array_init_size(return_value, vt->rows);
+	for (y = 0; y < vt->rows; y++) {
+		cell = PHP_NCURSES_VT_CELL(vt, y, 0);
+
+		if (!with_cells) {
+			line.len = 0;
+			for (x = 0; x < vt->cols; x++, cell++) {
+				if (cell->ch) {
+					php_ncurses_vt_utf8(&line, cell->ch);
+				}
+			}
+			add_next_index_stringl(return_value, line.c ? line.c : "", line.len);
+			continue;
+		}
+
+		array_init_size(&row, vt->cols);
+		for (x = 0; x < vt->cols; x++, cell++) {
+			line.len = 0;
+			if (cell->ch) {
+				php_ncurses_vt_utf8(&line, cell->ch);
+			}
+			array_init_size(&entry, 4);
+			add_assoc_stringl(&entry, "ch", line.c ? line.c : "", line.len);
+			add_assoc_long(&entry, "attr", cell->attr);
+			add_assoc_long(&entry, "fg", cell->fg);
+			add_assoc_long(&entry, "bg", cell->bg);
+			add_next_index_zval(&row, &entry);
+		}
+		add_next_index_zval(return_value, &row);
+	}
+
+	smart_string_free(&line);
+}
+/* }}} */
+
+/* {{{ proto string ncurses_headless_output(void)
+   Returns the raw bytes curses wrote to the headless terminal since the last
+   call, the last megabyte of them if there were more */
+PHP_FUNCTION(ncurses_headless_output)
+{
+	php_ncurses_vt *vt;
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		return;
+	}
+
+	if ((vt = NCURSES_G(headless)) == NULL) {
+		php_error_docref(NULL, E_WARNING, "No headless terminal is running, see ncurses_headless_init()");
+		RETURN_FALSE;
+	}
+
+	php_ncurses_headless_pump();
+
+	RETVAL_STRINGL(vt->raw.c ? vt->raw.c : "", vt->raw.len);
+	vt->raw.len = 0;
+}
+/* }}} */
+
+#else
+
+PHP_NCURSES_API void php_ncurses_headless_pump(void)
+{
+}
+
+PHP_NCURSES_API void php_ncurses_headless_shutdown(void)
+{
+}
+
+PHP_NCURSES_API void php_ncurses_headless_feed(const char *buf, size_t len)
+{
+}
+
+#endif
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
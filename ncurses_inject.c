@@ -0,0 +1,241 @@
+/*
+   +----------------------------------------------------------------------+
+   | PHP Version 5                                                        |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1997-2006 The PHP Group                                |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_ini.h"
+#include "php_ncurses.h"
+
+#ifdef PHP_WIN32
+# include "win32/time.h"
+#else
+# include <unistd.h>
+#endif
+
+/* Scripted input, queued by ncurses_inject().
+ *
+ * The queue of ungetch() holds a few dozen keys and the one of ungetmouse()
+ * only a handful of events, and both give the last pushed entry back first.
+ * The script is therefore kept here and handed to curses one event at a
+ * time: every read of the extension pushes the next event with ungetch() or
+ * ungetmouse() right before calling wgetch(), once the event is due. A read
+ * that would block waits for the event, a read with a timeout only as long
+ * as the timeout allows. ncurses_getch_async() reads without a timeout, so
+ * it only takes events that are due and leaves the waiting to its waiter. */
+
+#if PHP_MAJOR_VERSION >= 7
+
+typedef struct _php_ncurses_injected {
+	double due;     /* php_ncurses_now() at which the event may be read */
+	int    key;     /* KEY_MOUSE for mouse events */
+	MEVENT mevent;
+} php_ncurses_injected;
+
+typedef struct _php_ncurses_inject {
+	php_ncurses_injected *events;
+	size_t count;   /* events queued */
+	size_t pos;     /* next event to push */
+	size_t size;
+} php_ncurses_inject;
+
+/* {{{ php_ncurses_inject_add
+   Appends an event, due delay seconds after the previous one */
+static void php_ncurses_inject_add(php_ncurses_inject *q, int key, MEVENT *mevent, double delay)
+{
+	php_ncurses_injected *e;
+
+	if (q->count == q->size) {
+		q->size = q->size ? q->size * 2 : 64;
+		q->events = erealloc(q->events, q->size * sizeof(php_ncurses_injected));
+	}
+
+	e = &q->events[q->count];
+	e->due = (q->count > q->pos ? q->events[q->count - 1].due : php_ncurses_now()) + delay;
+	e->key = key;
+	if (mevent) {
+		e->mevent = *mevent;
+	}
+	q->count++;
+}
+/* }}} */
+
+/* {{{ php_ncurses_inject_reset
+   Drops the queued events */
+PHP_NCURSES_API void php_ncurses_inject_reset(void)
+{
+	php_ncurses_inject *q = NCURSES_G(inject);
+
+	if (q) {
+		if (q->events) {
+			efree(q->events);
+		}
+		efree(q);
+		NCURSES_G(inject) = NULL;
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_inject_pump
+   Hands the next queued event to curses if the following read of win gets
+   to it: it is due, or due within the delay set for win, which is waited */
+PHP_NCURSES_API void php_ncurses_inject_pump(WINDOW *win)
+{
+	php_ncurses_inject *q = NCURSES_G(inject);
+	php_ncurses_injected *e;
+	double wait;
+#ifdef HAVE_NCURSES_WGETDELAY
+	int delay = wgetdelay(win);
+#else
+	int delay = -1;
+#endif
+
+	if (!q || q->pos == q->count) {
+		return;
+	}
+
+	e = &q->events[q->pos];
+	wait = e->due - php_ncurses_now();
+	if (wait > 0 && delay >= 0 && wait * 1000.0 > (double)delay) {
+		return;
+	}
+	/* usleep() is only meant for less than a second */
+	while (wait > 0) {
+		usleep(wait < 1.0 ? (unsigned int)(wait * 1000000.0) : 999999);
+		wait = e->due - php_ncurses_now();
+	}
+
+	if (e->key == KEY_MOUSE) {
+		ungetmouse(&e->mevent);
+	} else {
+		ungetch(e->key);
+	}
+
+	if (++q->pos == q->count) {
+		q->pos = q->count = 0;
+	}
+}
+/* }}} */
+
+/* {{{ proto int|false ncurses_inject(array events [, int interval_ms])
+   Queues keys and mouse events for the following reads. An event is a key
+   code, a string standing for its bytes, an array like the ones of
+   ncurses_getmouse() or array("key" => code). Each event becomes readable
+   interval_ms after the previous one, "delay" in an array event overrides
+   that for the event. Returns the number of events still queued */
+PHP_FUNCTION(ncurses_inject)
+{
+	zval *events, *event, *val;
+	zend_long interval = 0, delay;
+	zend_string *name;
+	php_ncurses_inject *q;
+	size_t count, i;
+	MEVENT mevent;
+	int key;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "a|l", &events, &interval) == FAILURE) {
+		return;
+	}
+	IS_NCURSES_INITIALIZED();
+
+	if (interval < 0) {
+		php_error_docref(NULL, E_WARNING, "The interval must not be negative");
+		RETURN_FALSE;
+	}
+
+	if (!(q = NCURSES_G(inject))) {
+		q = ecalloc(1, sizeof(php_ncurses_inject));
+		NCURSES_G(inject) = q;
+	}
+	count = q->count;
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(events), event) {
+		ZVAL_DEREF(event);
+		switch (Z_TYPE_P(event)) {
+			case IS_LONG:
+				php_ncurses_inject_add(q, (int)Z_LVAL_P(event), NULL, (double)interval / 1000.0);
+				break;
+
+			case IS_STRING:
+				for (i = 0; i < Z_STRLEN_P(event); i++) {
+					php_ncurses_inject_add(q, (unsigned char)Z_STRVAL_P(event)[i], NULL,
+						i ? 0.0 : (double)interval / 1000.0);
+				}
+				break;
+
+			case IS_ARRAY:
+				memset(&mevent, 0, sizeof(mevent));
+				key = KEY_MOUSE;
+				delay = interval;
+				/* one pass over the fields instead of a lookup per field */
+				ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL_P(event), name, val) {
+					if (!name || php_ncurses_mevent_field(&mevent, name, val)) {
+						continue;
+					}
+					if (zend_string_equals_literal(name, "key")) {
+						key = (int)zval_get_long(val);
+					} else if (zend_string_equals_literal(name, "delay")) {
+						delay = zval_get_long(val);
+					}
+				} ZEND_HASH_FOREACH_END();
+
+				if (delay < 0) {
+					php_error_docref(NULL, E_WARNING, "The delay of an event must not be negative");
+					goto failure;
+				}
+				php_ncurses_inject_add(q, key, key == KEY_MOUSE ? &mevent : NULL, (double)delay / 1000.0);
+				break;
+
+			default:
+				php_error_docref(NULL, E_WARNING, "Events must be key codes, strings or arrays, %s given", zend_zval_type_name(event));
+				goto failure;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	RETURN_LONG((zend_long)(q->count - q->pos));
+
+failure:
+	/* nothing of a broken script is queued */
+	q->count = count;
+	if (q->pos == q->count) {
+		q->pos = q->count = 0;
+	}
+	RETURN_FALSE;
+}
+/* }}} */
+
+#else
+
+PHP_NCURSES_API void php_ncurses_inject_reset(void)
+{
+}
+
+PHP_NCURSES_API void php_ncurses_inject_pump(WINDOW *win)
+{
+}
+
+#endif
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
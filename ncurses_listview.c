@@ -0,0 +1,419 @@
+/*
+   +----------------------------------------------------------------------+
+   | PHP Version 5                                                        |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1997-2006 The PHP Group                                |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_ini.h"
+#include "php_ncurses.h"
+
+#if PHP_VERSION_ID >= 80000
+#include "ncurses_listview_arginfo.h"
+
+PHP_NCURSES_API zend_class_entry *php_ncurses_listview_ce;
+static zend_object_handlers php_ncurses_listview_handlers;
+
+#define Z_NCURSES_LISTVIEW_P(zv) php_ncurses_listview_from_obj(Z_OBJ_P(zv))
+
+/* {{{ php_ncurses_listview_clamp
+   Keeps selected inside the list and scrolls offset so that it is visible */
+static void php_ncurses_listview_clamp(php_ncurses_listview *lv, int height)
+{
+	if (lv->selected >= lv->count) {
+		lv->selected = lv->count - 1;
+	}
+	if (lv->selected < 0) {
+		lv->selected = lv->count > 0 ? 0 : -1;
+	}
+
+	if (height > 0 && lv->selected >= 0) {
+		if (lv->selected < lv->offset) {
+			lv->offset = lv->selected;
+		} else if (lv->selected >= lv->offset + height) {
+			lv->offset = lv->selected - height + 1;
+		}
+	}
+	if (lv->offset > lv->count - height) {
+		lv->offset = lv->count - height;
+	}
+	if (lv->offset < 0) {
+		lv->offset = 0;
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_listview_fetch
+   Makes lv->rows hold the rows offset .. offset + height, asking the
+   provider only when the viewport moved since the last call */
+static int php_ncurses_listview_fetch(php_ncurses_listview *lv, int height)
+{
+	zval args[2], retval;
+	zend_long length;
+
+	if (Z_TYPE(lv->rows) == IS_ARRAY && lv->rows_offset == lv->offset && lv->rows_count == height) {
+		return SUCCESS;
+	}
+	zval_ptr_dtor(&lv->rows);
+	ZVAL_UNDEF(&lv->rows);
+
+	if (Z_TYPE(lv->provider) == IS_ARRAY) {
+		/* rows are read straight from the array on render */
+		lv->rows_offset = lv->offset;
+		lv->rows_count = height;
+		return SUCCESS;
+	}
+
+	length = MIN(height, lv->count - lv->offset);
+	if (length <= 0) {
+		array_init(&lv->rows);
+		lv->rows_offset = lv->offset;
+		lv->rows_count = height;
+		return SUCCESS;
+	}
+
+	ZVAL_LONG(&args[0], lv->offset);
+	ZVAL_LONG(&args[1], length);
+	ZVAL_UNDEF(&retval);
+
+	if (call_user_function(NULL, NULL, &lv->provider, &retval, 2, args) == FAILURE || EG(exception)) {
+		zval_ptr_dtor(&retval);
+		return FAILURE;
+	}
+	if (Z_TYPE(retval) != IS_ARRAY) {
+		zend_type_error("NcursesListView row provider must return an array, %s returned", zend_zval_type_name(&retval));
+		zval_ptr_dtor(&retval);
+		return FAILURE;
+	}
+
+	ZVAL_COPY_VALUE(&lv->rows, &retval);
+	lv->rows_offset = lv->offset;
+	lv->rows_count = height;
+
+	return SUCCESS;
+}
+/* }}} */
+
+static zend_object *php_ncurses_listview_new(zend_class_entry *ce)
+{
+	php_ncurses_listview *lv = zend_object_alloc(sizeof(php_ncurses_listview), ce);
+
+	ZVAL_UNDEF(&lv->window);
+	ZVAL_UNDEF(&lv->provider);
+	ZVAL_UNDEF(&lv->rows);
+	lv->count = 0;
+	lv->selected = -1;
+	lv->offset = 0;
+	lv->rows_offset = -1;
+	lv->rows_count = 0;
+	lv->selected_attr = A_REVERSE;
+
+	zend_object_std_init(&lv->std, ce);
+	object_properties_init(&lv->std, ce);
+	lv->std.handlers = &php_ncurses_listview_handlers;
+
+	return &lv->std;
+}
+
+static void php_ncurses_listview_free(zend_object *object)
+{
+	php_ncurses_listview *lv = php_ncurses_listview_from_obj(object);
+
+	zval_ptr_dtor(&lv->window);
+	zval_ptr_dtor(&lv->provider);
+	zval_ptr_dtor(&lv->rows);
+
+	zend_object_std_dtor(object);
+}
+
+static HashTable *php_ncurses_listview_get_gc(zend_object *object, zval **table, int *n)
+{
+	php_ncurses_listview *lv = php_ncurses_listview_from_obj(object);
+	zend_get_gc_buffer *gc_buffer = zend_get_gc_buffer_create();
+
+	zend_get_gc_buffer_add_zval(gc_buffer, &lv->window);
+	zend_get_gc_buffer_add_zval(gc_buffer, &lv->provider);
+	zend_get_gc_buffer_add_zval(gc_buffer, &lv->rows);
+	zend_get_gc_buffer_use(gc_buffer, table, n);
+
+	return zend_std_get_properties(object);
+}
+
+/* {{{ proto NcursesListView::__construct(NcursesWindow window, int count, callable|array provider)
+   Creates a list of count rows shown in window. provider is either an array
+   of rows or a callable taking (int offset, int length) that returns a list
+   of the rows in that range; it is only asked for the rows currently in view */
+ZEND_METHOD(NcursesListView, __construct)
+{
+	zval *window, *provider;
+	zend_long count;
+	php_ncurses_listview *lv = Z_NCURSES_LISTVIEW_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "Olz", &window, php_ncurses_window_ce, &count, &provider) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	if (count < 0) {
+		zend_argument_value_error(2, "must be greater than or equal to 0");
+		RETURN_THROWS();
+	}
+	if (Z_TYPE_P(provider) != IS_ARRAY && !zend_is_callable(provider, 0, NULL)) {
+		zend_argument_type_error(3, "must be a valid callback or an array, %s given", zend_zval_type_name(provider));
+		RETURN_THROWS();
+	}
+
+	zval_ptr_dtor(&lv->window);
+	zval_ptr_dtor(&lv->provider);
+	zval_ptr_dtor(&lv->rows);
+	ZVAL_COPY(&lv->window, window);
+	ZVAL_COPY(&lv->provider, provider);
+	ZVAL_UNDEF(&lv->rows);
+
+	lv->count = count;
+	lv->selected = count > 0 ? 0 : -1;
+	lv->offset = 0;
+	lv->rows_offset = -1;
+}
+/* }}} */
+
+/* {{{ proto int NcursesListView::getCount()
+   Returns the number of rows */
+ZEND_METHOD(NcursesListView, getCount)
+{
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	RETURN_LONG(Z_NCURSES_LISTVIEW_P(ZEND_THIS)->count);
+}
+/* }}} */
+
+/* {{{ proto void NcursesListView::setCount(int count)
+   Changes the number of rows, for lists that grow or shrink */
+ZEND_METHOD(NcursesListView, setCount)
+{
+	zend_long count;
+	php_ncurses_listview *lv = Z_NCURSES_LISTVIEW_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "l", &count) == FAILURE) {
+		RETURN_THROWS();
+	}
+	if (count < 0) {
+		zend_argument_value_error(1, "must be greater than or equal to 0");
+		RETURN_THROWS();
+	}
+
+	lv->count = count;
+	lv->rows_offset = -1;
+	php_ncurses_listview_clamp(lv, 0);
+}
+/* }}} */
+
+/* {{{ proto int NcursesListView::getSelected()
+   Returns the index of the selected row, -1 for an empty list */
+ZEND_METHOD(NcursesListView, getSelected)
+{
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	RETURN_LONG(Z_NCURSES_LISTVIEW_P(ZEND_THIS)->selected);
+}
+/* }}} */
+
+/* {{{ proto void NcursesListView::select(int index)
+   Selects a row, the view scrolls to it on the next render() */
+ZEND_METHOD(NcursesListView, select)
+{
+	zend_long index;
+	php_ncurses_listview *lv = Z_NCURSES_LISTVIEW_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "l", &index) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	lv->selected = index;
+	php_ncurses_listview_clamp(lv, 0);
+}
+/* }}} */
+
+/* {{{ proto int NcursesListView::getOffset()
+   Returns the index of the first row in view */
+ZEND_METHOD(NcursesListView, getOffset)
+{
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	RETURN_LONG(Z_NCURSES_LISTVIEW_P(ZEND_THIS)->offset);
+}
+/* }}} */
+
+/* {{{ proto void NcursesListView::setSelectedAttr(int attr)
+   Sets the attributes of the selected row, NCURSES_A_REVERSE by default */
+ZEND_METHOD(NcursesListView, setSelectedAttr)
+{
+	zend_long attr;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "l", &attr) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	Z_NCURSES_LISTVIEW_P(ZEND_THIS)->selected_attr = (attr_t)attr;
+}
+/* }}} */
+
+/* {{{ proto bool NcursesListView::handleKey(int key)
+   Moves the selection for the up, down, page up, page down, home and end
+   keys. Returns false for any other key so the caller can handle it */
+ZEND_METHOD(NcursesListView, handleKey)
+{
+	zend_long key;
+	int height;
+	WINDOW *win;
+	php_ncurses_listview *lv = Z_NCURSES_LISTVIEW_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "l", &key) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	if ((win = php_ncurses_window_fetch(&lv->window)) == NULL) {
+		RETURN_THROWS();
+	}
+	height = getmaxy(win);
+
+	switch (key) {
+		case KEY_UP:
+			lv->selected--;
+			break;
+		case KEY_DOWN:
+			lv->selected++;
+			break;
+		case KEY_PPAGE:
+			lv->selected -= height;
+			lv->offset -= height;
+			break;
+		case KEY_NPAGE:
+			lv->selected += height;
+			lv->offset += height;
+			break;
+		case KEY_HOME:
+			lv->selected = 0;
+			break;
+		case KEY_END:
+			lv->selected = lv->count - 1;
+			break;
+		default:
+			RETURN_FALSE;
+	}
+
+	if (lv->selected < 0) {
+		lv->selected = 0;
+	}
+	php_ncurses_listview_clamp(lv, height);
+
+	RETURN_TRUE;
+}
+/* }}} */
+
+/* {{{ proto int NcursesListView::render()
+   Draws the rows in view into the window and returns how many were drawn.
+   The window is not refreshed */
+ZEND_METHOD(NcursesListView, render)
+{
+	int height, width, line;
+	zend_long index;
+	zval *row;
+	zend_string *str;
+	attr_t saved;
+	WINDOW *win;
+	php_ncurses_listview *lv = Z_NCURSES_LISTVIEW_P(ZEND_THIS);
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	if ((win = php_ncurses_window_fetch(&lv->window)) == NULL) {
+		RETURN_THROWS();
+	}
+	getmaxyx(win, height, width);
+
+	php_ncurses_listview_clamp(lv, height);
+	if (php_ncurses_listview_fetch(lv, height) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	saved = getattrs(win);
+	for (line = 0; line < height; line++) {
+		index = lv->offset + line;
+		row = NULL;
+
+		if (index < lv->count) {
+			if (Z_TYPE(lv->provider) == IS_ARRAY) {
+				row = zend_hash_index_find(Z_ARRVAL(lv->provider), index);
+			} else {
+				row = zend_hash_index_find(Z_ARRVAL(lv->rows), line);
+			}
+		}
+
+		wattrset(win, index == lv->selected ? lv->selected_attr : A_NORMAL);
+		wmove(win, line, 0);
+		if (row) {
+			str = zval_get_string(row);
+			php_ncurses_waddfield(win, ZSTR_VAL(str), ZSTR_LEN(str), width, PHP_NCURSES_ALIGN_LEFT);
+			zend_string_release(str);
+		} else {
+			php_ncurses_waddfield(win, "", 0, width, PHP_NCURSES_ALIGN_LEFT);
+		}
+	}
+	wattrset(win, saved);
+
+	RETURN_LONG(MIN(height, lv->count - lv->offset));
+}
+/* }}} */
+
+/* {{{ proto void NcursesListView::invalidate()
+   Drops the cached rows so that render() asks the provider again */
+ZEND_METHOD(NcursesListView, invalidate)
+{
+	php_ncurses_listview *lv = Z_NCURSES_LISTVIEW_P(ZEND_THIS);
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	lv->rows_offset = -1;
+}
+/* }}} */
+
+/* {{{ PHP_MINIT_FUNCTION
+ */
+PHP_MINIT_FUNCTION(ncurses_listview)
+{
+	php_ncurses_listview_ce = register_class_NcursesListView();
+	php_ncurses_listview_ce->create_object = php_ncurses_listview_new;
+
+	memcpy(&php_ncurses_listview_handlers, &std_object_handlers, sizeof(zend_object_handlers));
+	php_ncurses_listview_handlers.offset = XtOffsetOf(php_ncurses_listview, std);
+	php_ncurses_listview_handlers.free_obj = php_ncurses_listview_free;
+	php_ncurses_listview_handlers.get_gc = php_ncurses_listview_get_gc;
+	php_ncurses_listview_handlers.clone_obj = NULL;
+
+	return SUCCESS;
+}
+/* }}} */
+
+#endif /* PHP_VERSION_ID >= 80000 */
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
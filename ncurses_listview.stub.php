@@ -0,0 +1,29 @@
+<?php
+
+/** @generate-class-entries */
+
+/** @strict-properties */
+final class NcursesListView
+{
+	public function __construct(NcursesWindow $window, int $count, callable|array $provider) {}
+
+	public function getCount(): int {}
+
+	public function setCount(int $count): void {}
+
+	public function getSelected(): int {}
+
+	public function select(int $index): void {}
+
+	public function getOffset(): int {}
+
+	public function setSelectedAttr(int $attr): void {}
+
+	public function handleKey(int $key): bool {}
+
+	public function render(): int {}
+
+	public function invalidate(): void {}
+}
+
+?>
@@ -0,0 +1,74 @@
+/* This is a generated file, edit the .stub.php file instead.
+ * Stub hash: 8da3e23080163cc067a281b120c92567c041fcb2 */
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_class_NcursesListView___construct, 0, 0, 3)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
+	ZEND_ARG_TYPE_INFO(0, count, IS_LONG, 0)
+	ZEND_ARG_TYPE_MASK(0, provider, MAY_BE_CALLABLE|MAY_BE_ARRAY, NULL)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesListView_getCount, 0, 0, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesListView_setCount, 0, 1, IS_VOID, 0)
+	ZEND_ARG_TYPE_INFO(0, count, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+#define arginfo_class_NcursesListView_getSelected arginfo_class_NcursesListView_getCount
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesListView_select, 0, 1, IS_VOID, 0)
+	ZEND_ARG_TYPE_INFO(0, index, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+#define arginfo_class_NcursesListView_getOffset arginfo_class_NcursesListView_getCount
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesListView_setSelectedAttr, 0, 1, IS_VOID, 0)
+	ZEND_ARG_TYPE_INFO(0, attr, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesListView_handleKey, 0, 1, _IS_BOOL, 0)
+	ZEND_ARG_TYPE_INFO(0, key, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+#define arginfo_class_NcursesListView_render arginfo_class_NcursesListView_getCount
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesListView_invalidate, 0, 0, IS_VOID, 0)
+ZEND_END_ARG_INFO()
+
+
+ZEND_METHOD(NcursesListView, __construct);
+ZEND_METHOD(NcursesListView, getCount);
+ZEND_METHOD(NcursesListView, setCount);
+ZEND_METHOD(NcursesListView, getSelected);
+ZEND_METHOD(NcursesListView, select);
+ZEND_METHOD(NcursesListView, getOffset);
+ZEND_METHOD(NcursesListView, setSelectedAttr);
+ZEND_METHOD(NcursesListView, handleKey);
+ZEND_METHOD(NcursesListView, render);
+ZEND_METHOD(NcursesListView, invalidate);
+
+
+static const zend_function_entry class_NcursesListView_methods[] = {
+	ZEND_ME(NcursesListView, __construct, arginfo_class_NcursesListView___construct, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesListView, getCount, arginfo_class_NcursesListView_getCount, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesListView, setCount, arginfo_class_NcursesListView_setCount, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesListView, getSelected, arginfo_class_NcursesListView_getSelected, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesListView, select, arginfo_class_NcursesListView_select, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesListView, getOffset, arginfo_class_NcursesListView_getOffset, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesListView, setSelectedAttr, arginfo_class_NcursesListView_setSelectedAttr, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesListView, handleKey, arginfo_class_NcursesListView_handleKey, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesListView, render, arginfo_class_NcursesListView_render, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesListView, invalidate, arginfo_class_NcursesListView_invalidate, ZEND_ACC_PUBLIC)
+	ZEND_FE_END
+};
+
+static zend_class_entry *register_class_NcursesListView(void)
+{
+	zend_class_entry ce, *class_entry;
+
+	INIT_CLASS_ENTRY(ce, "NcursesListView", class_NcursesListView_methods);
+	class_entry = zend_register_internal_class_ex(&ce, NULL);
+	class_entry->ce_flags |= ZEND_ACC_FINAL|ZEND_ACC_NO_DYNAMIC_PROPERTIES;
+
+	return class_entry;
+}
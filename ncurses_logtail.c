@@ -0,0 +1,368 @@
+/*
+   +----------------------------------------------------------------------+
+   | PHP Version 5                                                        |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1997-2006 The PHP Group                                |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_ini.h"
+#include "php_ncurses.h"
+
+#if PHP_VERSION_ID >= 80000
+#include "ncurses_logtail_arginfo.h"
+
+PHP_NCURSES_API zend_class_entry *php_ncurses_logtail_ce;
+static zend_object_handlers php_ncurses_logtail_handlers;
+
+#define Z_NCURSES_LOGTAIL_P(zv) php_ncurses_logtail_from_obj(Z_OBJ_P(zv))
+
+/* a line without newline longer than this is cut and stored as is */
+#define PHP_NCURSES_LOGTAIL_MAX_LINE 65536
+
+/* {{{ php_ncurses_logtail_push
+   Appends one line to the ring, dropping the oldest one when it is full */
+static int php_ncurses_logtail_push(php_ncurses_logtail *lt, const char *line, size_t len)
+{
+	if (len && line[len - 1] == '\r') {
+		len--;
+	}
+	if (lt->filter && !zend_memnstr(line, ZSTR_VAL(lt->filter), ZSTR_LEN(lt->filter), line + len)) {
+		return 0;
+	}
+
+	if (lt->count == lt->capacity) {
+		zend_string_release(lt->lines[lt->head]);
+		lt->lines[lt->head] = zend_string_init(line, len, 0);
+		lt->head = (lt->head + 1) % lt->capacity;
+	} else {
+		lt->lines[(lt->head + lt->count) % lt->capacity] = zend_string_init(line, len, 0);
+		lt->count++;
+	}
+	lt->dirty = 1;
+
+	return 1;
+}
+/* }}} */
+
+/* {{{ php_ncurses_logtail_feed
+   Splits data into lines and returns how many of them were kept. A trailing
+   piece without newline is held back until the rest of the line arrives */
+static zend_long php_ncurses_logtail_feed(php_ncurses_logtail *lt, const char *data, size_t len)
+{
+	const char *nl;
+	size_t piece;
+	zend_long added = 0;
+
+	while (len && (nl = memchr(data, '\n', len)) != NULL) {
+		piece = nl - data;
+
+		if (lt->partial.s && ZSTR_LEN(lt->partial.s)) {
+			smart_str_appendl(&lt->partial, data, piece);
+			added += php_ncurses_logtail_push(lt, ZSTR_VAL(lt->partial.s), ZSTR_LEN(lt->partial.s));
+			ZSTR_LEN(lt->partial.s) = 0;
+		} else {
+			added += php_ncurses_logtail_push(lt, data, piece);
+		}
+
+		data += piece + 1;
+		len -= piece + 1;
+	}
+
+	if (len) {
+		smart_str_appendl(&lt->partial, data, len);
+		if (ZSTR_LEN(lt->partial.s) >= PHP_NCURSES_LOGTAIL_MAX_LINE) {
+			added += php_ncurses_logtail_push(lt, ZSTR_VAL(lt->partial.s), ZSTR_LEN(lt->partial.s));
+			ZSTR_LEN(lt->partial.s) = 0;
+		}
+	}
+
+	return added;
+}
+/* }}} */
+
+/* {{{ php_ncurses_logtail_clear */
+static void php_ncurses_logtail_clear(php_ncurses_logtail *lt)
+{
+	zend_long i;
+
+	for (i = 0; i < lt->count; i++) {
+		zend_string_release(lt->lines[(lt->head + i) % lt->capacity]);
+	}
+	lt->head = 0;
+	lt->count = 0;
+	lt->dirty = 1;
+	if (lt->partial.s) {
+		ZSTR_LEN(lt->partial.s) = 0;
+	}
+}
+/* }}} */
+
+static zend_object *php_ncurses_logtail_new(zend_class_entry *ce)
+{
+	php_ncurses_logtail *lt = zend_object_alloc(sizeof(php_ncurses_logtail), ce);
+
+	ZVAL_UNDEF(&lt->window);
+	ZVAL_UNDEF(&lt->stream);
+	lt->lines = NULL;
+	lt->capacity = 0;
+	lt->head = 0;
+	lt->count = 0;
+	lt->filter = NULL;
+	lt->partial.s = NULL;
+	lt->partial.a = 0;
+	lt->dirty = 1;
+
+	zend_object_std_init(&lt->std, ce);
+	object_properties_init(&lt->std, ce);
+	lt->std.handlers = &php_ncurses_logtail_handlers;
+
+	return &lt->std;
+}
+
+static void php_ncurses_logtail_free(zend_object *object)
+{
+	php_ncurses_logtail *lt = php_ncurses_logtail_from_obj(object);
+
+	if (lt->lines) {
+		php_ncurses_logtail_clear(lt);
+		efree(lt->lines);
+	}
+	if (lt->filter) {
+		zend_string_release(lt->filter);
+	}
+	smart_str_free(&lt->partial);
+	zval_ptr_dtor(&lt->window);
+	zval_ptr_dtor(&lt->stream);
+
+	zend_object_std_dtor(object);
+}
+
+/* {{{ proto NcursesLogTail::__construct(NcursesWindow window [, resource stream [, int capacity]])
+   Creates a tail of the last capacity lines read from stream, shown in window.
+   The stream is switched to non-blocking mode */
+ZEND_METHOD(NcursesLogTail, __construct)
+{
+	zval *window, *zstream = NULL;
+	zend_long capacity = 1000;
+	php_stream *stream;
+	php_ncurses_logtail *lt = Z_NCURSES_LOGTAIL_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "O|r!l", &window, php_ncurses_window_ce, &zstream, &capacity) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	if (capacity < 1 || capacity > INT_MAX) {
+		zend_argument_value_error(3, "must be between 1 and %d", INT_MAX);
+		RETURN_THROWS();
+	}
+
+	if (zstream) {
+		php_stream_from_zval(stream, zstream);
+		php_stream_set_option(stream, PHP_STREAM_OPTION_BLOCKING, 0, NULL);
+	}
+
+	if (lt->lines) {
+		php_ncurses_logtail_clear(lt);
+		efree(lt->lines);
+	}
+	zval_ptr_dtor(&lt->window);
+	zval_ptr_dtor(&lt->stream);
+
+	ZVAL_COPY(&lt->window, window);
+	if (zstream) {
+		ZVAL_COPY(&lt->stream, zstream);
+	} else {
+		ZVAL_UNDEF(&lt->stream);
+	}
+	lt->capacity = capacity;
+	lt->lines = safe_emalloc(capacity, sizeof(zend_string *), 0);
+	lt->head = 0;
+	lt->count = 0;
+	lt->dirty = 1;
+}
+/* }}} */
+
+/* {{{ proto int NcursesLogTail::pump([int max_bytes])
+   Reads what is available on the stream without blocking, at most max_bytes,
+   and returns the number of lines added */
+ZEND_METHOD(NcursesLogTail, pump)
+{
+	zend_long max_bytes = 1024 * 1024, added = 0;
+	char buf[8192];
+	ssize_t n;
+	size_t total = 0;
+	php_stream *stream;
+	php_ncurses_logtail *lt = Z_NCURSES_LOGTAIL_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "|l", &max_bytes) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	if (Z_TYPE(lt->stream) != IS_RESOURCE) {
+		zend_throw_error(NULL, "NcursesLogTail has no stream, use append() instead");
+		RETURN_THROWS();
+	}
+	php_stream_from_zval(stream, &lt->stream);
+
+	while (max_bytes <= 0 || total < (size_t)max_bytes) {
+		n = php_stream_read(stream, buf, max_bytes > 0 ? MIN(sizeof(buf), (size_t)max_bytes - total) : sizeof(buf));
+		if (n <= 0) {
+			break;
+		}
+		added += php_ncurses_logtail_feed(lt, buf, (size_t)n);
+		total += n;
+	}
+
+	RETURN_LONG(added);
+}
+/* }}} */
+
+/* {{{ proto int NcursesLogTail::append(string data)
+   Adds data as if it was read from the stream and returns the number of lines added */
+ZEND_METHOD(NcursesLogTail, append)
+{
+	char *data;
+	size_t data_len;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "s", &data, &data_len) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	RETURN_LONG(php_ncurses_logtail_feed(Z_NCURSES_LOGTAIL_P(ZEND_THIS), data, data_len));
+}
+/* }}} */
+
+/* {{{ proto void NcursesLogTail::setFilter(?string needle)
+   Keeps only lines that contain needle from now on, null keeps all */
+ZEND_METHOD(NcursesLogTail, setFilter)
+{
+	zend_string *needle;
+	php_ncurses_logtail *lt = Z_NCURSES_LOGTAIL_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "S!", &needle) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	if (lt->filter) {
+		zend_string_release(lt->filter);
+	}
+	lt->filter = needle && ZSTR_LEN(needle) ? zend_string_copy(needle) : NULL;
+}
+/* }}} */
+
+/* {{{ proto int NcursesLogTail::getCount()
+   Returns the number of lines held */
+ZEND_METHOD(NcursesLogTail, getCount)
+{
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	RETURN_LONG(Z_NCURSES_LOGTAIL_P(ZEND_THIS)->count);
+}
+/* }}} */
+
+/* {{{ proto array NcursesLogTail::getLines()
+   Returns the lines held, oldest first */
+ZEND_METHOD(NcursesLogTail, getLines)
+{
+	zend_long i;
+	php_ncurses_logtail *lt = Z_NCURSES_LOGTAIL_P(ZEND_THIS);
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	array_init_size(return_value, (uint32_t)lt->count);
+	for (i = 0; i < lt->count; i++) {
+		add_next_index_str(return_value, zend_string_copy(lt->lines[(lt->head + i) % lt->capacity]));
+	}
+}
+/* }}} */
+
+/* {{{ proto void NcursesLogTail::clear()
+   Drops all lines */
+ZEND_METHOD(NcursesLogTail, clear)
+{
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	php_ncurses_logtail_clear(Z_NCURSES_LOGTAIL_P(ZEND_THIS));
+}
+/* }}} */
+
+/* {{{ proto bool NcursesLogTail::render([bool force])
+   Draws the newest lines into the window, one per row and cut at its width.
+   Returns false without drawing when nothing changed since the last call */
+ZEND_METHOD(NcursesLogTail, render)
+{
+	zend_bool force = 0;
+	int height, width, line;
+	zend_long first;
+	zend_string *str;
+	WINDOW *win;
+	php_ncurses_logtail *lt = Z_NCURSES_LOGTAIL_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "|b", &force) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	if ((win = php_ncurses_window_fetch(&lt->window)) == NULL) {
+		RETURN_THROWS();
+	}
+	if (!lt->dirty && !force) {
+		RETURN_FALSE;
+	}
+	getmaxyx(win, height, width);
+
+	first = lt->count > height ? lt->count - height : 0;
+	for (line = 0; line < height; line++) {
+		wmove(win, line, 0);
+		if (first + line < lt->count) {
+			str = lt->lines[(lt->head + first + line) % lt->capacity];
+			php_ncurses_waddfield(win, ZSTR_VAL(str), ZSTR_LEN(str), width, PHP_NCURSES_ALIGN_LEFT);
+		} else {
+			php_ncurses_waddfield(win, "", 0, width, PHP_NCURSES_ALIGN_LEFT);
+		}
+	}
+	lt->dirty = 0;
+
+	RETURN_TRUE;
+}
+/* }}} */
+
+/* {{{ PHP_MINIT_FUNCTION
+ */
+PHP_MINIT_FUNCTION(ncurses_logtail)
+{
+	php_ncurses_logtail_ce = register_class_NcursesLogTail();
+	php_ncurses_logtail_ce->create_object = php_ncurses_logtail_new;
+
+	memcpy(&php_ncurses_logtail_handlers, &std_object_handlers, sizeof(zend_object_handlers));
+	php_ncurses_logtail_handlers.offset = XtOffsetOf(php_ncurses_logtail, std);
+	php_ncurses_logtail_handlers.free_obj = php_ncurses_logtail_free;
+	php_ncurses_logtail_handlers.clone_obj = NULL;
+
+	return SUCCESS;
+}
+/* }}} */
+
+#endif /* PHP_VERSION_ID >= 80000 */
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
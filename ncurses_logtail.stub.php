@@ -0,0 +1,26 @@
+<?php
+
+/** @generate-class-entries */
+
+/** @strict-properties */
+final class NcursesLogTail
+{
+	/** @param resource|null $stream */
+	public function __construct(NcursesWindow $window, $stream = null, int $capacity = 1000) {}
+
+	public function pump(int $max_bytes = 1048576): int {}
+
+	public function append(string $data): int {}
+
+	public function setFilter(?string $needle): void {}
+
+	public function getCount(): int {}
+
+	public function getLines(): array {}
+
+	public function clear(): void {}
+
+	public function render(bool $force = false): bool {}
+}
+
+?>
@@ -0,0 +1,67 @@
+/* This is a generated file, edit the .stub.php file instead.
+ * Stub hash: 03bd8dcf3638c0fcb8d077092f85b41e48092068 */
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_class_NcursesLogTail___construct, 0, 0, 1)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
+	ZEND_ARG_INFO_WITH_DEFAULT_VALUE(0, stream, "null")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, capacity, IS_LONG, 0, "1000")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesLogTail_pump, 0, 0, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, max_bytes, IS_LONG, 0, "1048576")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesLogTail_append, 0, 1, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, data, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesLogTail_setFilter, 0, 1, IS_VOID, 0)
+	ZEND_ARG_TYPE_INFO(0, needle, IS_STRING, 1)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesLogTail_getCount, 0, 0, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesLogTail_getLines, 0, 0, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesLogTail_clear, 0, 0, IS_VOID, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesLogTail_render, 0, 0, _IS_BOOL, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, force, _IS_BOOL, 0, "false")
+ZEND_END_ARG_INFO()
+
+
+ZEND_METHOD(NcursesLogTail, __construct);
+ZEND_METHOD(NcursesLogTail, pump);
+ZEND_METHOD(NcursesLogTail, append);
+ZEND_METHOD(NcursesLogTail, setFilter);
+ZEND_METHOD(NcursesLogTail, getCount);
+ZEND_METHOD(NcursesLogTail, getLines);
+ZEND_METHOD(NcursesLogTail, clear);
+ZEND_METHOD(NcursesLogTail, render);
+
+
+static const zend_function_entry class_NcursesLogTail_methods[] = {
+	ZEND_ME(NcursesLogTail, __construct, arginfo_class_NcursesLogTail___construct, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesLogTail, pump, arginfo_class_NcursesLogTail_pump, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesLogTail, append, arginfo_class_NcursesLogTail_append, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesLogTail, setFilter, arginfo_class_NcursesLogTail_setFilter, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesLogTail, getCount, arginfo_class_NcursesLogTail_getCount, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesLogTail, getLines, arginfo_class_NcursesLogTail_getLines, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesLogTail, clear, arginfo_class_NcursesLogTail_clear, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesLogTail, render, arginfo_class_NcursesLogTail_render, ZEND_ACC_PUBLIC)
+	ZEND_FE_END
+};
+
+static zend_class_entry *register_class_NcursesLogTail(void)
+{
+	zend_class_entry ce, *class_entry;
+
+	INIT_CLASS_ENTRY(ce, "NcursesLogTail", class_NcursesLogTail_methods);
+	class_entry = zend_register_internal_class_ex(&ce, NULL);
+	class_entry->ce_flags |= ZEND_ACC_FINAL|ZEND_ACC_NO_DYNAMIC_PROPERTIES;
+
+	return class_entry;
+}
@@ -0,0 +1,230 @@
+/*
+   +----------------------------------------------------------------------+
+   | PHP Version 5                                                        |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1997-2006 The PHP Group                                |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_ini.h"
+#include "php_ncurses.h"
+
+#ifndef PHP_WIN32
+# include <unistd.h>
+#endif
+
+/* Mouse events.
+ *
+ * The classic xterm report sends coordinates as single bytes offset by 32,
+ * which ends at column 223. The SGR report (mode 1006) sends them as decimal
+ * numbers: ESC [ < button ; x ; y followed by M for a press or m for a
+ * release. curses only decodes it when the terminfo entry asks for it, so
+ * after ncurses_mouse_sgr() the extension decodes the reports curses passes
+ * through as plain keys itself. The decoded event is kept until
+ * ncurses_getmouse() fetches it, curses' own events are used otherwise.
+ *
+ * NcursesMouseEvent is filled in place by ncurses_getmouse(), reading
+ * events into the same object over and over allocates nothing. */
+
+/* {{{ php_ncurses_mouse_sgr_state
+   Converts the button byte of an SGR report to the bstate of an MEVENT */
+static mmask_t php_ncurses_mouse_sgr_state(int b, int release)
+{
+	mmask_t state = 0;
+
+	if (b & 4) {
+		state |= BUTTON_SHIFT;
+	}
+	if (b & 8) {
+		state |= BUTTON_ALT;
+	}
+	if (b & 16) {
+		state |= BUTTON_CTRL;
+	}
+
+	if (b & 64) {
+		/* wheel, only reported as presses */
+		if ((b & 3) == 0) {
+			state |= BUTTON4_PRESSED;
+#ifdef BUTTON5_PRESSED
+		} else if ((b & 3) == 1) {
+			state |= BUTTON5_PRESSED;
+#endif
+		}
+		return state;
+	}
+
+	if (b & 32) {
+		return state | REPORT_MOUSE_POSITION;
+	}
+
+	switch (b & 3) {
+		case 0:
+			return state | (release ? BUTTON1_RELEASED : BUTTON1_PRESSED);
+		case 1:
+			return state | (release ? BUTTON2_RELEASED : BUTTON2_PRESSED);
+		case 2:
+			return state | (release ? BUTTON3_RELEASED : BUTTON3_PRESSED);
+	}
+	return state | REPORT_MOUSE_POSITION;
+}
+/* }}} */
+
+/* {{{ php_ncurses_mouse_read_sgr
+   Called after wgetch() returned ESC: reads the rest of an SGR mouse report
+   and returns KEY_MOUSE, or puts back what was read and returns ESC */
+PHP_NCURSES_API int php_ncurses_mouse_read_sgr(WINDOW *win)
+{
+	int buf[PHP_NCURSES_UNREAD_MAX], n = 0, ch, field = 0;
+	int values[3] = {0, 0, 0};
+#ifdef HAVE_NCURSES_WGETDELAY
+	int delay = wgetdelay(win);
+#else
+	int delay = -1;
+#endif
+
+	/* the report arrives in one piece, what is missing now is no report */
+	wtimeout(win, 0);
+	while (n < PHP_NCURSES_UNREAD_MAX) {
+		php_ncurses_inject_pump(win);
+		if ((ch = wgetch(win)) == ERR) {
+			break;
+		}
+		buf[n++] = ch;
+		if (n <= 2) {
+			if (ch != (n == 1 ? '[' : '<')) {
+				break;
+			}
+		} else if (ch >= '0' && ch <= '9') {
+			if (values[field] < 100000) {
+				values[field] = values[field] * 10 + (ch - '0');
+			}
+		} else if (ch == ';' && field < 2) {
+			field++;
+		} else if ((ch == 'M' || ch == 'm') && field == 2) {
+			wtimeout(win, delay);
+			memset(&NCURSES_G(mouse_event), 0, sizeof(MEVENT));
+			NCURSES_G(mouse_event).x = values[1] - 1;
+			NCURSES_G(mouse_event).y = values[2] - 1;
+			NCURSES_G(mouse_event).bstate = php_ncurses_mouse_sgr_state(values[0], ch == 'm');
+			NCURSES_G(mouse_pending) = 1;
+			return KEY_MOUSE;
+		} else {
+			break;
+		}
+	}
+	wtimeout(win, delay);
+
+	/* kept aside rather than given to ungetch(), which would return them
+	   after anything ncurses_inject() hands to curses meanwhile */
+	while (n > 0) {
+		NCURSES_G(unread)[NCURSES_G(unread_len)++] = buf[--n];
+	}
+	return 27;
+}
+/* }}} */
+
+/* {{{ php_ncurses_getmouse
+   getmouse() that returns a decoded SGR report first */
+PHP_NCURSES_API int php_ncurses_getmouse(MEVENT *mevent)
+{
+	if (NCURSES_G(mouse_pending)) {
+		*mevent = NCURSES_G(mouse_event);
+		NCURSES_G(mouse_pending) = 0;
+		return OK;
+	}
+	return getmouse(mevent);
+}
+/* }}} */
+
+/* {{{ proto bool ncurses_mouse_sgr([bool enable])
+   Switches the terminal to SGR mouse reports, which work beyond column 223,
+   and decodes them on the following reads */
+PHP_FUNCTION(ncurses_mouse_sgr)
+{
+	zend_bool enable = 1;
+	const char *seq;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|b", &enable) == FAILURE) {
+		return;
+	}
+	IS_NCURSES_INITIALIZED();
+
+#ifdef PHP_WIN32
+	php_error_docref(NULL TSRMLS_CC, E_WARNING, "SGR mouse reports are not supported on this platform");
+	RETURN_FALSE;
+#else
+	seq = enable ? "\033[?1006h" : "\033[?1006l";
+	if (write(NCURSES_G(output_fd), seq, strlen(seq)) < 0) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Unable to write to the terminal");
+		RETURN_FALSE;
+	}
+	NCURSES_G(mouse_sgr) = enable;
+	NCURSES_G(mouse_pending) = 0;
+	NCURSES_G(unread_len) = 0;
+	RETURN_TRUE;
+#endif
+}
+/* }}} */
+
+#if PHP_VERSION_ID >= 80000
+#include "ncurses_mouse_arginfo.h"
+
+PHP_NCURSES_API zend_class_entry *php_ncurses_mouse_event_ce;
+
+/* {{{ php_ncurses_mouse_event_fill
+   Writes mevent to the properties of an NcursesMouseEvent */
+PHP_NCURSES_API void php_ncurses_mouse_event_fill(zend_object *obj, MEVENT *mevent)
+{
+	zend_long fields[PHP_NCURSES_MOUSE_EVENT_PROPS];
+	zval *prop;
+	int i;
+
+	fields[0] = mevent->id;
+	fields[1] = mevent->x;
+	fields[2] = mevent->y;
+	fields[3] = mevent->z;
+	fields[4] = (zend_long)mevent->bstate;
+
+	for (i = 0; i < PHP_NCURSES_MOUSE_EVENT_PROPS; i++) {
+		prop = OBJ_PROP_NUM(obj, i);
+		/* a reference to an int property only accepts ints, which these are */
+		ZVAL_DEREF(prop);
+		ZVAL_LONG(prop, fields[i]);
+	}
+}
+/* }}} */
+
+/* {{{ PHP_MINIT_FUNCTION
+ */
+PHP_MINIT_FUNCTION(ncurses_mouse)
+{
+	php_ncurses_mouse_event_ce = register_class_NcursesMouseEvent();
+
+	return SUCCESS;
+}
+/* }}} */
+
+#endif /* PHP_VERSION_ID >= 80000 */
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
@@ -0,0 +1,19 @@
+<?php
+
+/** @generate-class-entries */
+
+/** @strict-properties */
+final class NcursesMouseEvent
+{
+	public int $id = 0;
+
+	public int $x = 0;
+
+	public int $y = 0;
+
+	public int $z = 0;
+
+	public int $mmask = 0;
+}
+
+?>
@@ -0,0 +1,47 @@
+/* This is a generated file, edit the .stub.php file instead.
+ * Stub hash: fe4b39c83343daa54126d0512d7a8701a6aa181e */
+
+static const zend_function_entry class_NcursesMouseEvent_methods[] = {
+	ZEND_FE_END
+};
+
+static zend_class_entry *register_class_NcursesMouseEvent(void)
+{
+	zend_class_entry ce, *class_entry;
+
+	INIT_CLASS_ENTRY(ce, "NcursesMouseEvent", class_NcursesMouseEvent_methods);
+	class_entry = zend_register_internal_class_ex(&ce, NULL);
+	class_entry->ce_flags |= ZEND_ACC_FINAL|ZEND_ACC_NO_DYNAMIC_PROPERTIES;
+
+	zval property_id_default_value;
+	ZVAL_LONG(&property_id_default_value, 0);
+	zend_string *property_id_name = zend_string_init("id", sizeof("id") - 1, 1);
+	zend_declare_typed_property(class_entry, property_id_name, &property_id_default_value, ZEND_ACC_PUBLIC, NULL, (zend_type) ZEND_TYPE_INIT_MASK(MAY_BE_LONG));
+	zend_string_release(property_id_name);
+
+	zval property_x_default_value;
+	ZVAL_LONG(&property_x_default_value, 0);
+	zend_string *property_x_name = zend_string_init("x", sizeof("x") - 1, 1);
+	zend_declare_typed_property(class_entry, property_x_name, &property_x_default_value, ZEND_ACC_PUBLIC, NULL, (zend_type) ZEND_TYPE_INIT_MASK(MAY_BE_LONG));
+	zend_string_release(property_x_name);
+
+	zval property_y_default_value;
+	ZVAL_LONG(&property_y_default_value, 0);
+	zend_string *property_y_name = zend_string_init("y", sizeof("y") - 1, 1);
+	zend_declare_typed_property(class_entry, property_y_name, &property_y_default_value, ZEND_ACC_PUBLIC, NULL, (zend_type) ZEND_TYPE_INIT_MASK(MAY_BE_LONG));
+	zend_string_release(property_y_name);
+
+	zval property_z_default_value;
+	ZVAL_LONG(&property_z_default_value, 0);
+	zend_string *property_z_name = zend_string_init("z", sizeof("z") - 1, 1);
+	zend_declare_typed_property(class_entry, property_z_name, &property_z_default_value, ZEND_ACC_PUBLIC, NULL, (zend_type) ZEND_TYPE_INIT_MASK(MAY_BE_LONG));
+	zend_string_release(property_z_name);
+
+	zval property_mmask_default_value;
+	ZVAL_LONG(&property_mmask_default_value, 0);
+	zend_string *property_mmask_name = zend_string_init("mmask", sizeof("mmask") - 1, 1);
+	zend_declare_typed_property(class_entry, property_mmask_name, &property_mmask_default_value, ZEND_ACC_PUBLIC, NULL, (zend_type) ZEND_TYPE_INIT_MASK(MAY_BE_LONG));
+	zend_string_release(property_mmask_name);
+
+	return class_entry;
+}
@@ -0,0 +1,507 @@
+/*
+   +----------------------------------------------------------------------+
+   | PHP Version 5                                                        |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1997-2006 The PHP Group                                |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_ini.h"
+#include "php_ncurses.h"
+
+#include <errno.h>
+#include <time.h>
+
+#ifndef PHP_WIN32
+# include <unistd.h>
+#endif
+
+/* Session recorder, started by ncurses_record_start().
+ *
+ * curses writes to the terminal by itself, so for the length of every
+ * physical update the output descriptor is pointed at a temporary file.
+ * Afterwards the captured bytes are passed on to the terminal and added to
+ * the asciicast v2 recording as one output event. The descriptor is only
+ * swapped around the update, so terminal mode changes and window size
+ * queries still reach the real terminal; output curses sends outside of
+ * ncurses_refresh(), ncurses_doupdate() and friends is not recorded.
+ *
+ * Events are collected in a buffer that is written to the stream once it
+ * holds PHP_NCURSES_RECORD_FLUSH_BYTES or PHP_NCURSES_RECORD_FLUSH_SECS
+ * passed since the last write. */
+
+#if PHP_MAJOR_VERSION >= 7 && !defined(PHP_WIN32)
+
+#include "zend_smart_str.h"
+
+#define PHP_NCURSES_RECORD_FLUSH_BYTES 65536
+#define PHP_NCURSES_RECORD_FLUSH_SECS  1.0
+
+typedef struct _php_ncurses_recorder {
+	zval       stream;
+	FILE      *capture;
+	double     start;
+	double     flushed;
+	smart_str  buf;
+} php_ncurses_recorder;
+
+/* {{{ php_ncurses_record_escape
+   Appends len bytes as the contents of a JSON string, UTF-8 is kept as is */
+static void php_ncurses_record_escape(smart_str *dest, const unsigned char *s, size_t len)
+{
+	static const char hex[] = "0123456789abcdef";
+	const unsigned char *end = s + len, *run = s;
+
+	for (; s < end; s++) {
+		if (*s >= 0x20 && *s != '"' && *s != '\\' && *s != 0x7f) {
+			continue;
+		}
+		smart_str_appendl(dest, (const char *)run, s - run);
+		run = s + 1;
+		switch (*s) {
+			case '"':  smart_str_appendl(dest, "\\\"", 2); break;
+			case '\\': smart_str_appendl(dest, "\\\\", 2); break;
+			case '\n': smart_str_appendl(dest, "\\n", 2); break;
+			case '\r': smart_str_appendl(dest, "\\r", 2); break;
+			case '\t': smart_str_appendl(dest, "\\t", 2); break;
+			case '\b': smart_str_appendl(dest, "\\b", 2); break;
+			default:
+				smart_str_appendl(dest, "\\u00", 4);
+				smart_str_appendc(dest, hex[*s >> 4]);
+				smart_str_appendc(dest, hex[*s & 0xf]);
+				break;
+		}
+	}
+	smart_str_appendl(dest, (const char *)run, s - run);
+}
+/* }}} */
+
+/* {{{ php_ncurses_record_flush
+   Writes the buffered events to the stream */
+static void php_ncurses_record_flush(php_ncurses_recorder *rec, double now)
+{
+	php_stream *stream;
+
+	rec->flushed = now;
+	if (!rec->buf.s || !ZSTR_LEN(rec->buf.s)) {
+		return;
+	}
+
+	/* the stream may have been closed behind our back */
+	stream = (php_stream *)zend_fetch_resource2(Z_RES(rec->stream), NULL, php_file_le_stream(), php_file_le_pstream());
+	if (stream) {
+		php_stream_write(stream, ZSTR_VAL(rec->buf.s), ZSTR_LEN(rec->buf.s));
+		php_stream_flush(stream);
+		/* the recording is no terminal output, see ncurses_stats() */
+		NCURSES_G(stats_excluded) += (long)ZSTR_LEN(rec->buf.s);
+	}
+	ZSTR_LEN(rec->buf.s) = 0;
+}
+/* }}} */
+
+/* {{{ php_ncurses_record_free */
+static void php_ncurses_record_free(php_ncurses_recorder *rec)
+{
+	php_ncurses_record_flush(rec, php_ncurses_now());
+	smart_str_free(&rec->buf);
+	zval_ptr_dtor(&rec->stream);
+	fclose(rec->capture);
+	efree(rec);
+}
+/* }}} */
+
+/* {{{ php_ncurses_record_write
+   Writes all of buf to fd */
+static void php_ncurses_record_write(int fd, const char *buf, size_t len)
+{
+	ssize_t n;
+
+	while (len > 0) {
+		n = write(fd, buf, len);
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return;
+		}
+		buf += n;
+		len -= (size_t)n;
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_record_begin
+   Points the output of curses at the capture file until php_ncurses_record_end()
+   and returns a copy of the descriptor it replaced, -1 if nothing is recorded */
+PHP_NCURSES_API int php_ncurses_record_begin(void)
+{
+	php_ncurses_recorder *rec = NCURSES_G(recorder);
+	int saved_fd;
+
+	if (!rec || (saved_fd = dup(NCURSES_G(output_fd))) < 0) {
+		return -1;
+	}
+	if (dup2(fileno(rec->capture), NCURSES_G(output_fd)) < 0) {
+		close(saved_fd);
+		return -1;
+	}
+
+	return saved_fd;
+}
+/* }}} */
+
+/* {{{ php_ncurses_record_end
+   Puts the output descriptor back, then passes what curses wrote on to the
+   terminal and into the recording */
+PHP_NCURSES_API void php_ncurses_record_end(int saved_fd)
+{
+	php_ncurses_recorder *rec = NCURSES_G(recorder);
+	int fd = NCURSES_G(output_fd), capture_fd;
+	char buf[8192], head[48];
+	ssize_t n;
+	off_t offset = 0;
+	double now;
+
+	dup2(saved_fd, fd);
+	close(saved_fd);
+
+	capture_fd = fileno(rec->capture);
+	now = php_ncurses_now();
+	while ((n = pread(capture_fd, buf, sizeof(buf), offset)) > 0) {
+		php_ncurses_record_write(fd, buf, (size_t)n);
+		if (offset == 0) {
+			smart_str_appendl(&rec->buf, head, snprintf(head, sizeof(head), "[%.6f, \"o\", \"", now - rec->start));
+		}
+		php_ncurses_record_escape(&rec->buf, (const unsigned char *)buf, (size_t)n);
+		offset += n;
+	}
+	if (offset == 0) {
+		return;
+	}
+	/* curses wrote the output once into the capture file, only the copy
+	   to the terminal counts */
+	NCURSES_G(stats_excluded) += (long)offset;
+	smart_str_appendl(&rec->buf, "\"]\n", 3);
+
+	if (ftruncate(capture_fd, 0) == 0) {
+		lseek(capture_fd, 0, SEEK_SET);
+	}
+	if (ZSTR_LEN(rec->buf.s) >= PHP_NCURSES_RECORD_FLUSH_BYTES || now - rec->flushed >= PHP_NCURSES_RECORD_FLUSH_SECS) {
+		php_ncurses_record_flush(rec, now);
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_record_shutdown
+   Writes out and stops a recording that is still running */
+PHP_NCURSES_API void php_ncurses_record_shutdown(void)
+{
+	if (NCURSES_G(recorder)) {
+		php_ncurses_record_free(NCURSES_G(recorder));
+		NCURSES_G(recorder) = NULL;
+	}
+}
+/* }}} */
+
+/* {{{ proto bool ncurses_record_start(resource stream [, ?string title])
+   Records everything curses sends to the terminal from now on as an
+   asciicast v2 file into stream */
+PHP_FUNCTION(ncurses_record_start)
+{
+	zval *zstream;
+	zend_string *title = NULL;
+	php_stream *stream;
+	php_ncurses_recorder *rec;
+	const char *term;
+	char head[128];
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "r|S!", &zstream, &title) == FAILURE) {
+		return;
+	}
+	php_stream_from_zval(stream, zstream);
+	IS_NCURSES_INITIALIZED();
+
+	if (NCURSES_G(recorder)) {
+		php_error_docref(NULL, E_WARNING, "A recording is already running, call ncurses_record_stop() first");
+		RETURN_FALSE;
+	}
+
+	rec = ecalloc(1, sizeof(php_ncurses_recorder));
+	if ((rec->capture = tmpfile()) == NULL) {
+		php_error_docref(NULL, E_WARNING, "Unable to create the capture file: %s", strerror(errno));
+		efree(rec);
+		RETURN_FALSE;
+	}
+	ZVAL_COPY(&rec->stream, zstream);
+	rec->start = php_ncurses_now();
+
+	term = termname();
+	smart_str_appendl(&rec->buf, head, snprintf(head, sizeof(head), "{\"version\": 2, \"width\": %d, \"height\": %d, \"timestamp\": %ld, \"env\": {\"TERM\": \"",
+		COLS, LINES, (long)time(NULL)));
+	php_ncurses_record_escape(&rec->buf, (const unsigned char *)(term ? term : ""), term ? strlen(term) : 0);
+	smart_str_appendl(&rec->buf, "\"}", 2);
+	if (title) {
+		smart_str_appendl(&rec->buf, ", \"title\": \"", 12);
+		php_ncurses_record_escape(&rec->buf, (const unsigned char *)ZSTR_VAL(title), ZSTR_LEN(title));
+		smart_str_appendc(&rec->buf, '"');
+	}
+	smart_str_appendl(&rec->buf, "}\n", 2);
+	php_ncurses_record_flush(rec, rec->start);
+
+	NCURSES_G(recorder) = rec;
+	RETURN_TRUE;
+}
+/* }}} */
+
+/* {{{ proto bool ncurses_record_stop(void)
+   Writes out the rest of the recording and stops it, the stream stays open */
+PHP_FUNCTION(ncurses_record_stop)
+{
+	if (zend_parse_parameters_none() == FAILURE) {
+		return;
+	}
+
+	if (!NCURSES_G(recorder)) {
+		php_error_docref(NULL, E_WARNING, "No recording is running, see ncurses_record_start()");
+		RETURN_FALSE;
+	}
+	php_ncurses_record_shutdown();
+
+	RETURN_TRUE;
+}
+/* }}} */
+
+/* {{{ php_ncurses_replay_hex */
+static int php_ncurses_replay_hex(const char *p, const char *end, uint32_t *cp)
+{
+	int i;
+
+	*cp = 0;
+	if (end - p < 4) {
+		return FAILURE;
+	}
+	for (i = 0; i < 4; i++) {
+		*cp <<= 4;
+		if (p[i] >= '0' && p[i] <= '9') {
+			*cp |= p[i] - '0';
+		} else if ((p[i] | 0x20) >= 'a' && (p[i] | 0x20) <= 'f') {
+			*cp |= (p[i] | 0x20) - 'a' + 10;
+		} else {
+			return FAILURE;
+		}
+	}
+	return SUCCESS;
+}
+/* }}} */
+
+/* {{{ php_ncurses_replay_string
+   Decodes the JSON string starting after the opening quote at *p into dest,
+   *p is left after the closing quote */
+static int php_ncurses_replay_string(const char **p, const char *end, smart_str *dest)
+{
+	const char *s = *p;
+	uint32_t cp, low;
+
+	while (s < end && *s != '"') {
+		if (*s != '\\') {
+			smart_str_appendc(dest, *s++);
+			continue;
+		}
+		if (++s >= end) {
+			return FAILURE;
+		}
+		switch (*s++) {
+			case '"':  smart_str_appendc(dest, '"'); break;
+			case '\\': smart_str_appendc(dest, '\\'); break;
+			case '/':  smart_str_appendc(dest, '/'); break;
+			case 'b':  smart_str_appendc(dest, '\b'); break;
+			case 'f':  smart_str_appendc(dest, '\f'); break;
+			case 'n':  smart_str_appendc(dest, '\n'); break;
+			case 'r':  smart_str_appendc(dest, '\r'); break;
+			case 't':  smart_str_appendc(dest, '\t'); break;
+			case 'u':
+				if (php_ncurses_replay_hex(s, end, &cp) == FAILURE) {
+					return FAILURE;
+				}
+				s += 4;
+				if (cp >= 0xD800 && cp <= 0xDBFF && end - s >= 6 && s[0] == '\\' && s[1] == 'u'
+						&& php_ncurses_replay_hex(s + 2, end, &low) == SUCCESS && low >= 0xDC00 && low <= 0xDFFF) {
+					cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+					s += 6;
+				}
+				if (cp < 0x80) {
+					smart_str_appendc(dest, (char)cp);
+				} else if (cp < 0x800) {
+					smart_str_appendc(dest, (char)(0xC0 | (cp >> 6)));
+					smart_str_appendc(dest, (char)(0x80 | (cp & 0x3F)));
+				} else if (cp < 0x10000) {
+					smart_str_appendc(dest, (char)(0xE0 | (cp >> 12)));
+					smart_str_appendc(dest, (char)(0x80 | ((cp >> 6) & 0x3F)));
+					smart_str_appendc(dest, (char)(0x80 | (cp & 0x3F)));
+				} else {
+					smart_str_appendc(dest, (char)(0xF0 | (cp >> 18)));
+					smart_str_appendc(dest, (char)(0x80 | ((cp >> 12) & 0x3F)));
+					smart_str_appendc(dest, (char)(0x80 | ((cp >> 6) & 0x3F)));
+					smart_str_appendc(dest, (char)(0x80 | (cp & 0x3F)));
+				}
+				break;
+			default:
+				return FAILURE;
+		}
+	}
+	if (s >= end) {
+		return FAILURE;
+	}
+	*p = s + 1;
+	return SUCCESS;
+}
+/* }}} */
+
+#define PHP_NCURSES_REPLAY_SKIP_WS(p, end) \
+	while ((p) < (end) && (*(p) == ' ' || *(p) == '\t')) (p)++
+
+/* {{{ php_ncurses_replay_event
+   Parses an event line [time, "type", "data"] */
+static int php_ncurses_replay_event(const char *p, const char *end, double *t, char *type, smart_str *data)
+{
+	const char *num_end;
+	smart_str code = {0};
+	int ret;
+
+	PHP_NCURSES_REPLAY_SKIP_WS(p, end);
+	if (p >= end || *p++ != '[') {
+		return FAILURE;
+	}
+	PHP_NCURSES_REPLAY_SKIP_WS(p, end);
+	*t = zend_strtod(p, &num_end);
+	if (num_end == p) {
+		return FAILURE;
+	}
+	p = num_end;
+	PHP_NCURSES_REPLAY_SKIP_WS(p, end);
+	if (p >= end || *p++ != ',') {
+		return FAILURE;
+	}
+	PHP_NCURSES_REPLAY_SKIP_WS(p, end);
+	if (p >= end || *p++ != '"') {
+		return FAILURE;
+	}
+	ret = php_ncurses_replay_string(&p, end, &code);
+	*type = (ret == SUCCESS && code.s && ZSTR_LEN(code.s) == 1) ? ZSTR_VAL(code.s)[0] : 0;
+	smart_str_free(&code);
+	if (ret == FAILURE) {
+		return FAILURE;
+	}
+	PHP_NCURSES_REPLAY_SKIP_WS(p, end);
+	if (p >= end || *p++ != ',') {
+		return FAILURE;
+	}
+	PHP_NCURSES_REPLAY_SKIP_WS(p, end);
+	if (p >= end || *p++ != '"') {
+		return FAILURE;
+	}
+	return php_ncurses_replay_string(&p, end, data);
+}
+/* }}} */
+
+/* {{{ proto array|false ncurses_replay(resource stream)
+   Feeds the output events of an asciicast v2 recording into the headless
+   terminal as fast as possible. Returns the number of events and bytes, the
+   duration of the recording and the seconds the replay took */
+PHP_FUNCTION(ncurses_replay)
+{
+	zval *zstream;
+	php_stream *stream;
+	char *line;
+	size_t len;
+	zend_long lineno = 0, events = 0, bytes = 0;
+	double t, duration = 0, start, elapsed = 0;
+	char type;
+	smart_str data = {0};
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "r", &zstream) == FAILURE) {
+		return;
+	}
+	php_stream_from_zval(stream, zstream);
+
+	if (!NCURSES_G(headless)) {
+		php_error_docref(NULL, E_WARNING, "No headless terminal is running, see ncurses_headless_init()");
+		RETURN_FALSE;
+	}
+	/* whatever curses wrote so far goes first */
+	php_ncurses_headless_pump();
+
+	while ((line = php_stream_get_line(stream, NULL, 0, &len)) != NULL) {
+		lineno++;
+		if ((lineno == 1 && line[0] == '{') || strspn(line, " \t\r\n") == len) {
+			efree(line);
+			continue;
+		}
+		if (php_ncurses_replay_event(line, line + len, &t, &type, &data) == FAILURE) {
+			efree(line);
+			smart_str_free(&data);
+			php_error_docref(NULL, E_WARNING, "Line " ZEND_LONG_FMT " is not an asciicast v2 event", lineno);
+			RETURN_FALSE;
+		}
+		efree(line);
+
+		duration = t;
+		if (type == 'o' && data.s) {
+			start = php_ncurses_now();
+			php_ncurses_headless_feed(ZSTR_VAL(data.s), ZSTR_LEN(data.s));
+			elapsed += php_ncurses_now() - start;
+			events++;
+			bytes += ZSTR_LEN(data.s);
+		}
+		if (data.s) {
+			ZSTR_LEN(data.s) = 0;
+		}
+	}
+	smart_str_free(&data);
+
+	array_init_size(return_value, 4);
+	add_assoc_long(return_value, "events", events);
+	add_assoc_long(return_value, "bytes", bytes);
+	add_assoc_double(return_value, "duration", duration);
+	add_assoc_double(return_value, "time", elapsed);
+}
+/* }}} */
+
+#else
+
+PHP_NCURSES_API int php_ncurses_record_begin(void)
+{
+	return -1;
+}
+
+PHP_NCURSES_API void php_ncurses_record_end(int saved_fd)
+{
+}
+
+PHP_NCURSES_API void php_ncurses_record_shutdown(void)
+{
+}
+
+#endif
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
@@ -0,0 +1,399 @@
+/*
+   +----------------------------------------------------------------------+
+   | PHP Version 5                                                        |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1997-2006 The PHP Group                                |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_ini.h"
+#include "php_ncurses.h"
+
+#if PHP_VERSION_ID >= 80000
+#include "ncurses_scene_arginfo.h"
+
+PHP_NCURSES_API zend_class_entry *php_ncurses_scene_ce;
+static zend_object_handlers php_ncurses_scene_handlers;
+
+#define Z_NCURSES_SCENE_P(zv) php_ncurses_scene_from_obj(Z_OBJ_P(zv))
+
+/* boxes nested deeper than this are rejected */
+#define PHP_NCURSES_SCENE_MAX_DEPTH 64
+
+/* area a node may draw into, in window coordinates; y and x are the
+   origin its coordinates are relative to */
+typedef struct _php_ncurses_scene_clip {
+	int y, x;
+	int top, left, bottom, right;  /* bottom and right are exclusive */
+} php_ncurses_scene_clip;
+
+static zend_long php_ncurses_scene_long(HashTable *node, const char *key, size_t key_len, zend_long def)
+{
+	zval *zv = zend_hash_str_find(node, key, key_len);
+
+	return zv ? zval_get_long(zv) : def;
+}
+
+#define SCENE_LONG(node, key, def) php_ncurses_scene_long(node, key, sizeof(key) - 1, def)
+
+static inline void php_ncurses_scene_put(php_ncurses_scene *scene, const php_ncurses_scene_clip *clip, zend_long y, zend_long x, const php_ncurses_cell *cell)
+{
+	if (y >= clip->top && y < clip->bottom && x >= clip->left && x < clip->right) {
+		scene->back[y * scene->cols + x] = *cell;
+	}
+}
+
+/* {{{ php_ncurses_scene_text */
+static void php_ncurses_scene_text(php_ncurses_scene *scene, const php_ncurses_scene_clip *clip, zend_long y, zend_long x, const char *str, size_t len, zend_long attr, zend_long pair)
+{
+	size_t pos = 0;
+	uint32_t cp;
+	php_ncurses_cell cell;
+
+	if (y < clip->top || y >= clip->bottom) {
+		return;
+	}
+	while (pos < len && x < clip->right) {
+		pos += php_ncurses_utf8_decode((const unsigned char *)str + pos, len - pos, &cp);
+		if (x >= clip->left) {
+			php_ncurses_cell_set(&cell, cp, attr, pair);
+			scene->back[y * scene->cols + x] = cell;
+		}
+		x++;
+	}
+}
+/* }}} */
+
+static int php_ncurses_scene_nodes(php_ncurses_scene *scene, const php_ncurses_scene_clip *clip, HashTable *nodes, int depth);
+
+/* {{{ php_ncurses_scene_node
+   Draws one node of the frame into the back buffer */
+static int php_ncurses_scene_node(php_ncurses_scene *scene, const php_ncurses_scene_clip *clip, zval *znode, int depth)
+{
+	HashTable *node;
+	zval *ztype, *zv;
+	const char *type = "text";
+	zend_long y, x, height, width, attr, pair, i, j;
+	php_ncurses_cell cell;
+
+	ZVAL_DEREF(znode);
+	if (Z_TYPE_P(znode) != IS_ARRAY) {
+		zend_type_error("Frame node must be of type array, %s given", zend_zval_type_name(znode));
+		return FAILURE;
+	}
+	node = Z_ARRVAL_P(znode);
+
+	if ((ztype = zend_hash_str_find(node, ZEND_STRL("type"))) != NULL) {
+		ZVAL_DEREF(ztype);
+		if (Z_TYPE_P(ztype) != IS_STRING) {
+			zend_type_error("Frame node type must be of type string, %s given", zend_zval_type_name(ztype));
+			return FAILURE;
+		}
+		type = Z_STRVAL_P(ztype);
+	}
+
+	y = clip->y + SCENE_LONG(node, "y", 0);
+	x = clip->x + SCENE_LONG(node, "x", 0);
+	attr = SCENE_LONG(node, "attr", 0);
+	pair = SCENE_LONG(node, "pair", 0);
+
+	if (!strcmp(type, "text")) {
+		zend_string *text;
+
+		if ((zv = zend_hash_str_find(node, ZEND_STRL("text"))) == NULL) {
+			return SUCCESS;
+		}
+		text = zval_get_string(zv);
+		php_ncurses_scene_text(scene, clip, y, x, ZSTR_VAL(text), ZSTR_LEN(text), attr, pair);
+		zend_string_release(text);
+
+		return SUCCESS;
+	}
+
+	height = SCENE_LONG(node, "height", clip->bottom - y);
+	width = SCENE_LONG(node, "width", clip->right - x);
+	if (height <= 0 || width <= 0) {
+		return SUCCESS;
+	}
+
+	if (!strcmp(type, "fill")) {
+		zv = zend_hash_str_find(node, ZEND_STRL("ch"));
+		if (zv) {
+			php_ncurses_cell_set_zval(&cell, zv, attr, pair);
+		} else {
+			php_ncurses_cell_set(&cell, ' ', attr, pair);
+		}
+		for (i = MAX(y, clip->top); i < MIN(y + height, clip->bottom); i++) {
+			for (j = MAX(x, clip->left); j < MIN(x + width, clip->right); j++) {
+				scene->back[i * scene->cols + j] = cell;
+			}
+		}
+
+		return SUCCESS;
+	}
+
+	if (!strcmp(type, "box")) {
+		php_ncurses_scene_clip inner;
+		int border = 1;
+
+		if ((zv = zend_hash_str_find(node, ZEND_STRL("border"))) != NULL) {
+			border = zend_is_true(zv);
+		}
+
+		if (border && height >= 2 && width >= 2) {
+			php_ncurses_cell_set_chtype(&cell, ACS_ULCORNER, attr, pair);
+			php_ncurses_scene_put(scene, clip, y, x, &cell);
+			php_ncurses_cell_set_chtype(&cell, ACS_URCORNER, attr, pair);
+			php_ncurses_scene_put(scene, clip, y, x + width - 1, &cell);
+			php_ncurses_cell_set_chtype(&cell, ACS_LLCORNER, attr, pair);
+			php_ncurses_scene_put(scene, clip, y + height - 1, x, &cell);
+			php_ncurses_cell_set_chtype(&cell, ACS_LRCORNER, attr, pair);
+			php_ncurses_scene_put(scene, clip, y + height - 1, x + width - 1, &cell);
+			php_ncurses_cell_set_chtype(&cell, ACS_HLINE, attr, pair);
+			for (j = x + 1; j < x + width - 1; j++) {
+				php_ncurses_scene_put(scene, clip, y, j, &cell);
+				php_ncurses_scene_put(scene, clip, y + height - 1, j, &cell);
+			}
+			php_ncurses_cell_set_chtype(&cell, ACS_VLINE, attr, pair);
+			for (i = y + 1; i < y + height - 1; i++) {
+				php_ncurses_scene_put(scene, clip, i, x, &cell);
+				php_ncurses_scene_put(scene, clip, i, x + width - 1, &cell);
+			}
+
+			if ((zv = zend_hash_str_find(node, ZEND_STRL("title"))) != NULL) {
+				zend_string *title = zval_get_string(zv);
+				php_ncurses_scene_clip bar = *clip;
+
+				bar.left = MAX(clip->left, x + 1);
+				bar.right = MIN(clip->right, x + width - 1);
+				php_ncurses_scene_text(scene, &bar, y, x + 2, ZSTR_VAL(title), ZSTR_LEN(title), attr, pair);
+				zend_string_release(title);
+			}
+		} else {
+			border = 0;
+		}
+
+		if ((zv = zend_hash_str_find(node, ZEND_STRL("children"))) == NULL) {
+			return SUCCESS;
+		}
+		ZVAL_DEREF(zv);
+		if (Z_TYPE_P(zv) != IS_ARRAY) {
+			zend_type_error("Frame node children must be of type array, %s given", zend_zval_type_name(zv));
+			return FAILURE;
+		}
+
+		/* children are placed and clipped inside the border */
+		inner.y = (int)y + border;
+		inner.x = (int)x + border;
+		inner.top = MAX(clip->top, inner.y);
+		inner.left = MAX(clip->left, inner.x);
+		inner.bottom = MIN(clip->bottom, (int)(y + height - border));
+		inner.right = MIN(clip->right, (int)(x + width - border));
+
+		return php_ncurses_scene_nodes(scene, &inner, Z_ARRVAL_P(zv), depth + 1);
+	}
+
+	zend_value_error("Unknown frame node type \"%s\"", type);
+	return FAILURE;
+}
+/* }}} */
+
+static int php_ncurses_scene_nodes(php_ncurses_scene *scene, const php_ncurses_scene_clip *clip, HashTable *nodes, int depth)
+{
+	zval *znode;
+
+	if (depth > PHP_NCURSES_SCENE_MAX_DEPTH) {
+		zend_value_error("Frame nodes must not be nested deeper than %d levels", PHP_NCURSES_SCENE_MAX_DEPTH);
+		return FAILURE;
+	}
+
+	ZEND_HASH_FOREACH_VAL(nodes, znode) {
+		if (php_ncurses_scene_node(scene, clip, znode, depth) == FAILURE) {
+			return FAILURE;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	return SUCCESS;
+}
+
+static zend_object *php_ncurses_scene_new(zend_class_entry *ce)
+{
+	php_ncurses_scene *scene = zend_object_alloc(sizeof(php_ncurses_scene), ce);
+
+	ZVAL_UNDEF(&scene->window);
+	scene->rows = 0;
+	scene->cols = 0;
+	scene->front = NULL;
+	scene->back = NULL;
+	scene->valid = 0;
+
+	zend_object_std_init(&scene->std, ce);
+	object_properties_init(&scene->std, ce);
+	scene->std.handlers = &php_ncurses_scene_handlers;
+
+	return &scene->std;
+}
+
+static void php_ncurses_scene_free(zend_object *object)
+{
+	php_ncurses_scene *scene = php_ncurses_scene_from_obj(object);
+
+	if (scene->front) {
+		efree(scene->front);
+		efree(scene->back);
+	}
+	zval_ptr_dtor(&scene->window);
+
+	zend_object_std_dtor(object);
+}
+
+/* {{{ proto NcursesScene::__construct(NcursesWindow window)
+   Creates a scene that draws frames into window */
+ZEND_METHOD(NcursesScene, __construct)
+{
+	zval *window;
+	php_ncurses_scene *scene = Z_NCURSES_SCENE_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "O", &window, php_ncurses_window_ce) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	zval_ptr_dtor(&scene->window);
+	ZVAL_COPY(&scene->window, window);
+	scene->valid = 0;
+}
+/* }}} */
+
+/* {{{ proto int NcursesScene::render(array frame)
+   Draws the frame and writes only the cells that differ from the previous
+   one to the window. Returns the number of cells written */
+ZEND_METHOD(NcursesScene, render)
+{
+	HashTable *frame;
+	WINDOW *win;
+	int rows, cols, y, x, start;
+	size_t n, i;
+	zend_long written = 0;
+	php_ncurses_cell *front, *back, *swap;
+	php_ncurses_scene_clip clip;
+	php_ncurses_scene *scene = Z_NCURSES_SCENE_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "h", &frame) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	if ((win = php_ncurses_window_fetch(&scene->window)) == NULL) {
+		RETURN_THROWS();
+	}
+	getmaxyx(win, rows, cols);
+	if (rows <= 0 || cols <= 0) {
+		RETURN_LONG(0);
+	}
+
+	n = (size_t)rows * cols;
+	if (rows != scene->rows || cols != scene->cols) {
+		if (scene->front) {
+			efree(scene->front);
+			efree(scene->back);
+		}
+		scene->front = safe_emalloc(n, sizeof(php_ncurses_cell), 0);
+		scene->back = safe_emalloc(n, sizeof(php_ncurses_cell), 0);
+		scene->rows = rows;
+		scene->cols = cols;
+		scene->valid = 0;
+	}
+
+	for (i = 0; i < n; i++) {
+		scene->back[i].ch = ' ';
+		scene->back[i].attr = 0;
+		scene->back[i].pair = 0;
+	}
+
+	clip.y = clip.x = 0;
+	clip.top = clip.left = 0;
+	clip.bottom = rows;
+	clip.right = cols;
+	if (php_ncurses_scene_nodes(scene, &clip, frame, 0) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	front = scene->front;
+	back = scene->back;
+	for (y = 0; y < rows; y++, front += cols, back += cols) {
+		if (!scene->valid) {
+			php_ncurses_cells_put(win, y, 0, back, cols);
+			written += cols;
+			continue;
+		}
+		if (!memcmp(front, back, cols * sizeof(php_ncurses_cell))) {
+			continue;
+		}
+		for (x = 0; x < cols; ) {
+			if (!memcmp(&front[x], &back[x], sizeof(php_ncurses_cell))) {
+				x++;
+				continue;
+			}
+			for (start = x; x < cols && memcmp(&front[x], &back[x], sizeof(php_ncurses_cell)); x++);
+			php_ncurses_cells_put(win, y, start, &back[start], x - start);
+			written += x - start;
+		}
+	}
+
+	swap = scene->front;
+	scene->front = scene->back;
+	scene->back = swap;
+	scene->valid = 1;
+
+	RETURN_LONG(written);
+}
+/* }}} */
+
+/* {{{ proto void NcursesScene::invalidate(void)
+   Makes the next render() write every cell, for when something else drew into the window */
+ZEND_METHOD(NcursesScene, invalidate)
+{
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	Z_NCURSES_SCENE_P(ZEND_THIS)->valid = 0;
+}
+/* }}} */
+
+/* {{{ PHP_MINIT_FUNCTION
+ */
+PHP_MINIT_FUNCTION(ncurses_scene)
+{
+	php_ncurses_scene_ce = register_class_NcursesScene();
+	php_ncurses_scene_ce->create_object = php_ncurses_scene_new;
+
+	memcpy(&php_ncurses_scene_handlers, &std_object_handlers, sizeof(zend_object_handlers));
+	php_ncurses_scene_handlers.offset = XtOffsetOf(php_ncurses_scene, std);
+	php_ncurses_scene_handlers.free_obj = php_ncurses_scene_free;
+	php_ncurses_scene_handlers.clone_obj = NULL;
+
+	return SUCCESS;
+}
+/* }}} */
+
+#endif /* PHP_VERSION_ID >= 80000 */
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
@@ -0,0 +1,15 @@
+<?php
+
+/** @generate-class-entries */
+
+/** @strict-properties */
+final class NcursesScene
+{
+	public function __construct(NcursesWindow $window) {}
+
+	public function render(array $frame): int {}
+
+	public function invalidate(): void {}
+}
+
+?>
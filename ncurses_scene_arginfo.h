@@ -0,0 +1,37 @@
+/* This is a generated file, edit the .stub.php file instead.
+ * Stub hash: d6f69f459af2896161184aa7a70266f463e9eb40 */
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_class_NcursesScene___construct, 0, 0, 1)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesScene_render, 0, 1, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, frame, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesScene_invalidate, 0, 0, IS_VOID, 0)
+ZEND_END_ARG_INFO()
+
+
+ZEND_METHOD(NcursesScene, __construct);
+ZEND_METHOD(NcursesScene, render);
+ZEND_METHOD(NcursesScene, invalidate);
+
+
+static const zend_function_entry class_NcursesScene_methods[] = {
+	ZEND_ME(NcursesScene, __construct, arginfo_class_NcursesScene___construct, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesScene, render, arginfo_class_NcursesScene_render, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesScene, invalidate, arginfo_class_NcursesScene_invalidate, ZEND_ACC_PUBLIC)
+	ZEND_FE_END
+};
+
+static zend_class_entry *register_class_NcursesScene(void)
+{
+	zend_class_entry ce, *class_entry;
+
+	INIT_CLASS_ENTRY(ce, "NcursesScene", class_NcursesScene_methods);
+	class_entry = zend_register_internal_class_ex(&ce, NULL);
+	class_entry->ce_flags |= ZEND_ACC_FINAL|ZEND_ACC_NO_DYNAMIC_PROPERTIES;
+
+	return class_entry;
+}
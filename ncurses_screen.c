@@ -0,0 +1,367 @@
+/*
+   +----------------------------------------------------------------------+
+   | PHP Version 5                                                        |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1997-2006 The PHP Group                                |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_ini.h"
+#include "php_ncurses.h"
+
+#include <errno.h>
+
+#ifndef PHP_WIN32
+# include <unistd.h>
+#endif
+
+/* Several terminals in one process.
+ *
+ * curses draws on the current SCREEN only, and ncurses_set_term() switches
+ * it. The screen of ncurses_init() or ncurses_headless_init() is the main
+ * one, NCURSES_G(screen) points to the NcursesScreen that is current
+ * otherwise. The color pair allocator, the palette and the input descriptor
+ * belong to a screen as well; they stay in the globals for the current one
+ * and are parked in the php_ncurses_term of the others. */
+
+#if PHP_VERSION_ID >= 80000
+#include "ncurses_screen_arginfo.h"
+
+PHP_NCURSES_API zend_class_entry *php_ncurses_screen_ce;
+static zend_object_handlers php_ncurses_screen_handlers;
+
+#define Z_NCURSES_SCREEN_P(zv) php_ncurses_screen_from_obj(Z_OBJ_P(zv))
+
+/* {{{ php_ncurses_term_current
+   Returns where the state of the current screen is parked */
+static php_ncurses_term *php_ncurses_term_current(void)
+{
+	if (NCURSES_G(screen)) {
+		return &php_ncurses_screen_from_obj(NCURSES_G(screen))->term;
+	}
+	return &NCURSES_G(main_term);
+}
+/* }}} */
+
+/* {{{ php_ncurses_term_park
+   Moves the per screen state out of the globals into t */
+static void php_ncurses_term_park(php_ncurses_term *t)
+{
+	t->input_fd = NCURSES_G(input_fd);
+	t->output_fd = NCURSES_G(output_fd);
+	t->pairs = NCURSES_G(pairs);
+	t->palette = NCURSES_G(palette);
+	NCURSES_G(pairs) = NULL;
+	NCURSES_G(palette) = NULL;
+}
+/* }}} */
+
+/* {{{ php_ncurses_term_unpark
+   Moves the state parked in t back into the globals, which must be empty */
+static void php_ncurses_term_unpark(php_ncurses_term *t)
+{
+	NCURSES_G(input_fd) = t->input_fd;
+	NCURSES_G(output_fd) = t->output_fd;
+	NCURSES_G(pairs) = t->pairs;
+	NCURSES_G(palette) = t->palette;
+	t->pairs = NULL;
+	t->palette = NULL;
+}
+/* }}} */
+
+/* {{{ php_ncurses_term_free
+   Frees the state parked in t */
+static void php_ncurses_term_free(php_ncurses_term *t)
+{
+	php_ncurses_term live;
+
+	php_ncurses_term_park(&live);
+	php_ncurses_term_unpark(t);
+	php_ncurses_pairs_reset();
+	php_ncurses_palette_reset();
+	php_ncurses_term_unpark(&live);
+}
+/* }}} */
+
+/* {{{ php_ncurses_screen_main
+   Gives the globals back to the main screen before ncurses_init() or
+   ncurses_headless_init() replace it, parking the current NcursesScreen */
+PHP_NCURSES_API void php_ncurses_screen_main(void)
+{
+	if (NCURSES_G(screen)) {
+		php_ncurses_term_park(php_ncurses_term_current());
+		php_ncurses_term_unpark(&NCURSES_G(main_term));
+		NCURSES_G(screen) = NULL;
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_screen_fdopen
+   Opens a stdio stream on a duplicate of the descriptor behind zstream */
+static FILE *php_ncurses_screen_fdopen(zval *zstream, const char *mode)
+{
+	php_stream *stream;
+	int fd, dup_fd;
+	FILE *fp;
+
+	php_stream_from_zval_no_verify(stream, zstream);
+	if (stream == NULL) {
+		return NULL;
+	}
+
+	if (php_stream_can_cast(stream, PHP_STREAM_AS_FD) == FAILURE ||
+		php_stream_cast(stream, PHP_STREAM_AS_FD, (void **)&fd, REPORT_ERRORS) == FAILURE) {
+		php_error_docref(NULL, E_WARNING, "The stream has no file descriptor curses could use");
+		return NULL;
+	}
+
+	if ((dup_fd = dup(fd)) == -1) {
+		php_error_docref(NULL, E_WARNING, "Unable to duplicate the file descriptor: %s", strerror(errno));
+		return NULL;
+	}
+	if ((fp = fdopen(dup_fd, mode)) == NULL) {
+		php_error_docref(NULL, E_WARNING, "Unable to open the file descriptor: %s", strerror(errno));
+		close(dup_fd);
+	}
+
+	return fp;
+}
+/* }}} */
+
+/* {{{ php_ncurses_screen_close
+   Ends curses on the terminal and deletes the screen, the main screen is
+   made current if this one was */
+static void php_ncurses_screen_close(php_ncurses_screen *scr)
+{
+	SCREEN *old;
+
+	if (NCURSES_G(screen) == &scr->std) {
+		endwin();
+		php_ncurses_pairs_reset();
+		php_ncurses_palette_reset();
+		php_ncurses_term_unpark(&NCURSES_G(main_term));
+		if (NCURSES_G(main_term).screen) {
+			set_term(NCURSES_G(main_term).screen);
+		}
+		NCURSES_G(screen) = NULL;
+	} else {
+		old = set_term(scr->term.screen);
+		endwin();
+		set_term(old);
+		php_ncurses_term_free(&scr->term);
+	}
+
+	delscreen(scr->term.screen);
+	scr->term.screen = NULL;
+	fclose(scr->out);
+	fclose(scr->in);
+}
+/* }}} */
+
+static zend_object *php_ncurses_screen_new(zend_class_entry *ce)
+{
+	php_ncurses_screen *scr = zend_object_alloc(sizeof(php_ncurses_screen), ce);
+
+	memset(&scr->term, 0, sizeof(scr->term));
+	scr->out = NULL;
+	scr->in = NULL;
+
+	zend_object_std_init(&scr->std, ce);
+	object_properties_init(&scr->std, ce);
+	scr->std.handlers = &php_ncurses_screen_handlers;
+
+	return &scr->std;
+}
+
+static void php_ncurses_screen_free(zend_object *object)
+{
+	php_ncurses_screen *scr = php_ncurses_screen_from_obj(object);
+
+	if (scr->term.screen) {
+		php_ncurses_screen_close(scr);
+	}
+
+	zend_object_std_dtor(object);
+}
+
+/* {{{ proto NcursesScreen|false ncurses_newterm(?string type, resource output, resource input)
+   Starts curses on another terminal and makes it the current screen. A null
+   type takes the terminal type from $TERM */
+PHP_FUNCTION(ncurses_newterm)
+{
+	char *type = NULL;
+	size_t type_len;
+	zval *zout, *zin;
+	FILE *out, *in;
+	SCREEN *screen;
+	php_ncurses_screen *scr;
+	php_ncurses_term *prev;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "s!rr", &type, &type_len, &zout, &zin) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	if ((out = php_ncurses_screen_fdopen(zout, "w")) == NULL) {
+		if (EG(exception)) {
+			RETURN_THROWS();
+		}
+		RETURN_FALSE;
+	}
+	if ((in = php_ncurses_screen_fdopen(zin, "r")) == NULL) {
+		fclose(out);
+		if (EG(exception)) {
+			RETURN_THROWS();
+		}
+		RETURN_FALSE;
+	}
+
+	php_ncurses_stats_open();
+	php_ncurses_setup_locale(0);
+
+	prev = php_ncurses_term_current();
+	php_ncurses_term_park(prev);
+	screen = newterm(type, out, in);
+	if (!screen) {
+		/* newterm() leaves the previous screen current when it fails */
+		php_ncurses_term_unpark(prev);
+		fclose(out);
+		fclose(in);
+		php_error_docref(NULL, E_WARNING, "Unable to start a terminal of type %s", type ? type : "$TERM");
+		RETURN_FALSE;
+	}
+
+	object_init_ex(return_value, php_ncurses_screen_ce);
+	scr = Z_NCURSES_SCREEN_P(return_value);
+	scr->term.screen = screen;
+	scr->out = out;
+	scr->in = in;
+
+	NCURSES_G(screen) = Z_OBJ_P(return_value);
+	NCURSES_G(input_fd) = fileno(in);
+	NCURSES_G(output_fd) = fileno(out);
+	php_ncurses_setup_screen();
+}
+/* }}} */
+
+/* {{{ proto bool ncurses_set_term(?NcursesScreen screen)
+   Makes screen the one curses draws on and reads from, null stands for the
+   screen of ncurses_init() */
+PHP_FUNCTION(ncurses_set_term)
+{
+	zval *zscreen = NULL;
+	php_ncurses_term *to;
+	zend_object *owner;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "O!", &zscreen, php_ncurses_screen_ce) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	if (zscreen) {
+		owner = Z_OBJ_P(zscreen);
+		to = &php_ncurses_screen_from_obj(owner)->term;
+	} else {
+		if (!NCURSES_G(main_term).screen) {
+			php_error_docref(NULL, E_WARNING, "No screen was started by ncurses_init()");
+			RETURN_FALSE;
+		}
+		owner = NULL;
+		to = &NCURSES_G(main_term);
+	}
+
+	if (owner != NCURSES_G(screen)) {
+		php_ncurses_term_park(php_ncurses_term_current());
+		php_ncurses_term_unpark(to);
+		set_term(to->screen);
+		NCURSES_G(screen) = owner;
+	}
+
+	RETURN_TRUE;
+}
+/* }}} */
+
+/* {{{ proto NcursesScreen::__construct(void)
+   Screens are created by ncurses_newterm() only */
+ZEND_METHOD(NcursesScreen, __construct)
+{
+	ZEND_PARSE_PARAMETERS_NONE();
+}
+/* }}} */
+
+/* {{{ proto NcursesWindow NcursesScreen::window(void)
+   Returns the standard screen window of this terminal */
+ZEND_METHOD(NcursesScreen, window)
+{
+	php_ncurses_screen *scr = Z_NCURSES_SCREEN_P(ZEND_THIS);
+	zend_object *current;
+	SCREEN *old;
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	/* stdscr and the screen the window belongs to are the current ones */
+	current = NCURSES_G(screen);
+	old = set_term(scr->term.screen);
+	NCURSES_G(screen) = &scr->std;
+	php_ncurses_window_wrap(return_value, stdscr, 0);
+	NCURSES_G(screen) = current;
+	set_term(old);
+}
+/* }}} */
+
+/* {{{ proto int NcursesScreen::end(void)
+   Restores the terminal to the mode it had before ncurses_newterm(). The
+   next refresh of one of its windows resumes curses mode */
+ZEND_METHOD(NcursesScreen, end)
+{
+	php_ncurses_screen *scr = Z_NCURSES_SCREEN_P(ZEND_THIS);
+	SCREEN *old;
+	int ret;
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	old = set_term(scr->term.screen);
+	ret = endwin();
+	set_term(old);
+
+	RETURN_LONG(ret);
+}
+/* }}} */
+
+/* {{{ PHP_MINIT_FUNCTION
+ */
+PHP_MINIT_FUNCTION(ncurses_screen)
+{
+	php_ncurses_screen_ce = register_class_NcursesScreen();
+	php_ncurses_screen_ce->create_object = php_ncurses_screen_new;
+
+	memcpy(&php_ncurses_screen_handlers, &std_object_handlers, sizeof(zend_object_handlers));
+	php_ncurses_screen_handlers.offset = XtOffsetOf(php_ncurses_screen, std);
+	php_ncurses_screen_handlers.free_obj = php_ncurses_screen_free;
+	php_ncurses_screen_handlers.clone_obj = NULL;
+
+	return SUCCESS;
+}
+/* }}} */
+
+#endif /* PHP_VERSION_ID >= 80000 */
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
@@ -0,0 +1,15 @@
+<?php
+
+/** @generate-class-entries */
+
+/** @strict-properties */
+final class NcursesScreen
+{
+	private function __construct() {}
+
+	public function window(): NcursesWindow {}
+
+	public function end(): int {}
+}
+
+?>
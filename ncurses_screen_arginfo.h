@@ -0,0 +1,35 @@
+/* This is a generated file, edit the .stub.php file instead.
+ * Stub hash: bbef05469f65f258b6ef62464c25b40c64132753 */
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_class_NcursesScreen___construct, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_class_NcursesScreen_window, 0, 0, NcursesWindow, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesScreen_end, 0, 0, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+
+ZEND_METHOD(NcursesScreen, __construct);
+ZEND_METHOD(NcursesScreen, window);
+ZEND_METHOD(NcursesScreen, end);
+
+
+static const zend_function_entry class_NcursesScreen_methods[] = {
+	ZEND_ME(NcursesScreen, __construct, arginfo_class_NcursesScreen___construct, ZEND_ACC_PRIVATE)
+	ZEND_ME(NcursesScreen, window, arginfo_class_NcursesScreen_window, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesScreen, end, arginfo_class_NcursesScreen_end, ZEND_ACC_PUBLIC)
+	ZEND_FE_END
+};
+
+static zend_class_entry *register_class_NcursesScreen(void)
+{
+	zend_class_entry ce, *class_entry;
+
+	INIT_CLASS_ENTRY(ce, "NcursesScreen", class_NcursesScreen_methods);
+	class_entry = zend_register_internal_class_ex(&ce, NULL);
+	class_entry->ce_flags |= ZEND_ACC_FINAL|ZEND_ACC_NO_DYNAMIC_PROPERTIES;
+
+	return class_entry;
+}
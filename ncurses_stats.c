@@ -0,0 +1,312 @@
+/*
+   +----------------------------------------------------------------------+
+   | PHP Version 5                                                        |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1997-2006 The PHP Group                                |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_ini.h"
+#include "php_ncurses.h"
+#include "ext/standard/info.h"
+
+#include <fcntl.h>
+#ifndef PHP_WIN32
+# include <unistd.h>
+#endif
+
+/* Render statistics, enabled with ncurses.stats=1.
+ *
+ * Bytes sent to the terminal are taken from the write counter of the
+ * process (wchar in /proc/self/io) around every call into the extension.
+ * Current ncurses versions write() to the terminal descriptor directly,
+ * so a counting FILE passed to newterm() would never see the output;
+ * sampling the counter also keeps the terminal modes and size detection
+ * of the real tty intact. Where /proc is not available only the number
+ * of updates and the time spent in them are recorded. The counter also
+ * sees what the recorder writes into its capture file and its recording,
+ * which it adds up in stats_excluded to be taken off again. */
+
+#if PHP_MAJOR_VERSION >= 7
+typedef struct _php_ncurses_stats_call {
+	zend_function *func;
+	zend_long      calls;
+	zend_long      bytes;
+} php_ncurses_stats_call;
+
+static void (*php_ncurses_prev_execute_internal)(zend_execute_data *execute_data, zval *return_value);
+static zend_module_entry *php_ncurses_module;
+#endif
+
+/* {{{ php_ncurses_stats_written
+   Returns the number of bytes the process wrote so far, -1 if unknown */
+static long php_ncurses_stats_written(void)
+{
+#ifndef PHP_WIN32
+	char buf[512], *p;
+	ssize_t n;
+
+	if (NCURSES_G(stats_io_fd) < 0) {
+		return -1;
+	}
+
+	n = pread(NCURSES_G(stats_io_fd), buf, sizeof(buf) - 1, 0);
+	if (n <= 0) {
+		return -1;
+	}
+	buf[n] = '\0';
+
+	if ((p = strstr(buf, "wchar:")) == NULL) {
+		return -1;
+	}
+	return strtol(p + sizeof("wchar:") - 1, NULL, 10);
+#else
+	return -1;
+#endif
+}
+/* }}} */
+
+/* {{{ php_ncurses_stats_open
+   Starts sampling the write counter of the current process, called by ncurses_init() */
+PHP_NCURSES_API void php_ncurses_stats_open(void)
+{
+	if (!NCURSES_G(stats)) {
+		return;
+	}
+
+#ifndef PHP_WIN32
+	if (NCURSES_G(stats_io_fd) >= 0) {
+		close(NCURSES_G(stats_io_fd));
+	}
+	/* opened per ncurses_init() rather than at startup, /proc/self is resolved on open */
+	NCURSES_G(stats_io_fd) = open("/proc/self/io", O_RDONLY);
+	if (NCURSES_G(stats_io_fd) >= 0 && php_ncurses_stats_written() < 0) {
+		close(NCURSES_G(stats_io_fd));
+		NCURSES_G(stats_io_fd) = -1;
+	}
+#endif
+}
+/* }}} */
+
+/* {{{ php_ncurses_stats_update
+   Records a physical update of the terminal that started at start */
+PHP_NCURSES_API void php_ncurses_stats_update(double start)
+{
+	NCURSES_G(stats_updates)++;
+	NCURSES_G(stats_update_time) += php_ncurses_now() - start;
+}
+/* }}} */
+
+#if PHP_MAJOR_VERSION >= 7
+/* {{{ php_ncurses_execute_internal
+   Counts calls and terminal output of every function and method of the extension */
+static void php_ncurses_execute_internal(zend_execute_data *execute_data, zval *return_value)
+{
+	zend_function *func = execute_data->func;
+	php_ncurses_stats_call *call, tmp;
+	long before, after, excluded, written;
+
+	if (func->internal_function.module != php_ncurses_module) {
+		if (php_ncurses_prev_execute_internal) {
+			php_ncurses_prev_execute_internal(execute_data, return_value);
+		} else {
+			execute_internal(execute_data, return_value);
+		}
+		return;
+	}
+
+	before = php_ncurses_stats_written();
+	excluded = NCURSES_G(stats_excluded);
+
+	if (php_ncurses_prev_execute_internal) {
+		php_ncurses_prev_execute_internal(execute_data, return_value);
+	} else {
+		execute_internal(execute_data, return_value);
+	}
+
+	if ((call = zend_hash_index_find_ptr(NCURSES_G(stats_calls), (zend_ulong)(uintptr_t)func)) == NULL) {
+		tmp.func = func;
+		tmp.calls = 0;
+		tmp.bytes = 0;
+		call = zend_hash_index_add_mem(NCURSES_G(stats_calls), (zend_ulong)(uintptr_t)func, &tmp, sizeof(tmp));
+	}
+	call->calls++;
+
+	if (before >= 0 && (after = php_ncurses_stats_written()) >= before) {
+		written = (after - before) - (NCURSES_G(stats_excluded) - excluded);
+		if (written > 0) {
+			call->bytes += written;
+			NCURSES_G(stats_bytes) += written;
+		}
+	}
+}
+/* }}} */
+#endif
+
+/* {{{ php_ncurses_stats_reset */
+static void php_ncurses_stats_reset(void)
+{
+	NCURSES_G(stats_bytes) = 0;
+	NCURSES_G(stats_updates) = 0;
+	NCURSES_G(stats_update_time) = 0.0;
+#if PHP_MAJOR_VERSION >= 7
+	if (NCURSES_G(stats_calls)) {
+		zend_hash_clean(NCURSES_G(stats_calls));
+	}
+#endif
+}
+/* }}} */
+
+#if PHP_MAJOR_VERSION >= 7
+static void php_ncurses_stats_call_dtor(zval *zv)
+{
+	pefree(Z_PTR_P(zv), 1);
+}
+#endif
+
+/* {{{ PHP_MINIT_FUNCTION
+ */
+PHP_MINIT_FUNCTION(ncurses_stats)
+{
+	NCURSES_G(stats_io_fd) = -1;
+
+	if (!NCURSES_G(stats)) {
+		return SUCCESS;
+	}
+
+#if PHP_MAJOR_VERSION >= 7
+	php_ncurses_module = zend_hash_str_find_ptr(&module_registry, "ncurses", sizeof("ncurses") - 1);
+
+	NCURSES_G(stats_calls) = pemalloc(sizeof(HashTable), 1);
+	zend_hash_init(NCURSES_G(stats_calls), 32, NULL, php_ncurses_stats_call_dtor, 1);
+
+	php_ncurses_prev_execute_internal = zend_execute_internal;
+	zend_execute_internal = php_ncurses_execute_internal;
+#endif
+
+	return SUCCESS;
+}
+/* }}} */
+
+/* {{{ PHP_MSHUTDOWN_FUNCTION
+ */
+PHP_MSHUTDOWN_FUNCTION(ncurses_stats)
+{
+	if (!NCURSES_G(stats)) {
+		return SUCCESS;
+	}
+
+#if PHP_MAJOR_VERSION >= 7
+	zend_execute_internal = php_ncurses_prev_execute_internal;
+
+	zend_hash_destroy(NCURSES_G(stats_calls));
+	pefree(NCURSES_G(stats_calls), 1);
+	NCURSES_G(stats_calls) = NULL;
+#endif
+#ifndef PHP_WIN32
+	if (NCURSES_G(stats_io_fd) >= 0) {
+		close(NCURSES_G(stats_io_fd));
+		NCURSES_G(stats_io_fd) = -1;
+	}
+#endif
+
+	return SUCCESS;
+}
+/* }}} */
+
+/* {{{ php_ncurses_stats_info
+   Adds the statistics to the phpinfo() table */
+PHP_NCURSES_API void php_ncurses_stats_info(void)
+{
+	char tmp[64];
+
+	php_info_print_table_row(2, "render statistics", NCURSES_G(stats) ? "enabled" : "disabled");
+	if (!NCURSES_G(stats)) {
+		return;
+	}
+
+	if (NCURSES_G(stats_io_fd) >= 0) {
+		snprintf(tmp, sizeof(tmp), "%ld", NCURSES_G(stats_bytes));
+		php_info_print_table_row(2, "bytes written", tmp);
+	} else {
+		php_info_print_table_row(2, "bytes written", "unknown");
+	}
+	snprintf(tmp, sizeof(tmp), "%ld", NCURSES_G(stats_updates));
+	php_info_print_table_row(2, "physical updates", tmp);
+	snprintf(tmp, sizeof(tmp), "%.6f s", NCURSES_G(stats_update_time));
+	php_info_print_table_row(2, "time in updates", tmp);
+}
+/* }}} */
+
+/* {{{ proto array ncurses_stats([bool reset])
+   Returns the render statistics gathered with ncurses.stats=1, reset clears them afterwards */
+PHP_FUNCTION(ncurses_stats)
+{
+	zend_bool reset = 0;
+#if PHP_MAJOR_VERSION >= 7
+	php_ncurses_stats_call *call;
+	zend_string *name;
+	zval calls, entry;
+#endif
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|b", &reset) == FAILURE) {
+		return;
+	}
+
+	array_init(return_value);
+	add_assoc_bool(return_value, "enabled", NCURSES_G(stats));
+	if (NCURSES_G(stats_io_fd) >= 0) {
+		add_assoc_long(return_value, "bytes_written", NCURSES_G(stats_bytes));
+	} else {
+		add_assoc_null(return_value, "bytes_written");
+	}
+	add_assoc_long(return_value, "updates", NCURSES_G(stats_updates));
+	add_assoc_double(return_value, "update_time", NCURSES_G(stats_update_time));
+
+#if PHP_MAJOR_VERSION >= 7
+	array_init(&calls);
+	if (NCURSES_G(stats_calls)) {
+		ZEND_HASH_FOREACH_PTR(NCURSES_G(stats_calls), call) {
+			if (call->func->common.scope) {
+				name = strpprintf(0, "%s::%s", ZSTR_VAL(call->func->common.scope->name), ZSTR_VAL(call->func->common.function_name));
+			} else {
+				name = zend_string_copy(call->func->common.function_name);
+			}
+
+			array_init_size(&entry, 2);
+			add_assoc_long(&entry, "calls", call->calls);
+			add_assoc_long(&entry, "bytes", call->bytes);
+			zend_hash_update(Z_ARRVAL(calls), name, &entry);
+			zend_string_release(name);
+		} ZEND_HASH_FOREACH_END();
+	}
+	add_assoc_zval(return_value, "functions", &calls);
+#endif
+
+	if (reset) {
+		php_ncurses_stats_reset();
+	}
+}
+/* }}} */
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
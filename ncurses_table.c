@@ -0,0 +1,430 @@
+/*
+   +----------------------------------------------------------------------+
+   | PHP Version 5                                                        |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1997-2006 The PHP Group                                |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_ini.h"
+#include "php_ncurses.h"
+
+#if PHP_MAJOR_VERSION >= 7
+
+typedef struct _php_ncurses_table_column {
+	zend_string *key;    /* string key into the row, NULL for index */
+	zend_ulong   index;
+	zend_string *title;
+	int          width;  /* display width, computed when not given */
+	int          fixed;
+	int          align;
+	attr_t       attr;
+} php_ncurses_table_column;
+
+/* {{{ php_ncurses_display_width
+   Measures str in terminal columns and returns in *bytes how much of it fits
+   into max columns, max < 0 measures everything */
+PHP_NCURSES_API int php_ncurses_display_width(const char *str, size_t len, int max, size_t *bytes)
+{
+	size_t pos = 0, n;
+	uint32_t cp;
+	int width = 0, w;
+
+	while (pos < len) {
+		n = php_ncurses_utf8_decode((const unsigned char *)str + pos, len - pos, &cp);
+		if (cp < 0x20 || cp == 0x7f) {
+			w = 2; /* shown as ^X */
+		} else {
+#ifdef HAVE_NCURSESW
+			w = wcwidth((wchar_t)cp);
+			if (w < 0) {
+				w = 1;
+			}
+#else
+			w = (int)n; /* without wide characters every byte takes a cell */
+#endif
+		}
+		if (max >= 0 && width + w > max) {
+			break;
+		}
+		width += w;
+		pos += n;
+	}
+
+	if (bytes) {
+		*bytes = pos;
+	}
+	return width;
+}
+/* }}} */
+
+/* {{{ php_ncurses_table_pad */
+static void php_ncurses_table_pad(WINDOW *win, int n)
+{
+	while (n-- > 0) {
+		waddch(win, ' ');
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_waddfield
+   Writes str truncated or padded to exactly width columns */
+PHP_NCURSES_API void php_ncurses_waddfield(WINDOW *win, const char *str, size_t len, int width, int align)
+{
+	size_t bytes;
+	int w = php_ncurses_display_width(str, len, width, &bytes), left = 0;
+
+	if (align == PHP_NCURSES_ALIGN_RIGHT) {
+		left = width - w;
+	} else if (align == PHP_NCURSES_ALIGN_CENTER) {
+		left = (width - w) / 2;
+	}
+
+	php_ncurses_table_pad(win, left);
+	php_ncurses_waddnstr(win, str, bytes, -1);
+	php_ncurses_table_pad(win, width - w - left);
+}
+/* }}} */
+
+/* {{{ php_ncurses_table_cell
+   Returns the cell of row for column, NULL if there is none */
+static zval *php_ncurses_table_cell(zval *row, php_ncurses_table_column *col)
+{
+	ZVAL_DEREF(row);
+
+	if (Z_TYPE_P(row) != IS_ARRAY) {
+		/* a scalar row is a table with a single column */
+		return col->key == NULL && col->index == 0 ? row : NULL;
+	}
+	if (col->key) {
+		return zend_symtable_find(Z_ARRVAL_P(row), col->key);
+	}
+	return zend_hash_index_find(Z_ARRVAL_P(row), col->index);
+}
+/* }}} */
+
+/* {{{ php_ncurses_table_long_option */
+static zend_long php_ncurses_table_long_option(HashTable *ht, const char *name, size_t name_len, zend_long def)
+{
+	zval *zv;
+
+	if (ht && (zv = zend_hash_str_find(ht, name, name_len)) != NULL && Z_TYPE_P(zv) != IS_NULL) {
+		return zval_get_long(zv);
+	}
+	return def;
+}
+/* }}} */
+
+#define PHP_NCURSES_TABLE_OPTION(ht, name, def) \
+	php_ncurses_table_long_option(ht, name, sizeof(name) - 1, def)
+
+/* {{{ php_ncurses_table_columns
+   Parses the column specification, returns the number of columns or -1 */
+static int php_ncurses_table_columns(HashTable *spec, php_ncurses_table_column *cols)
+{
+	zval *zcol, *zv;
+	zend_string *align;
+	int n = 0;
+
+	ZEND_HASH_FOREACH_VAL(spec, zcol) {
+		php_ncurses_table_column *col = &cols[n];
+
+		col->index = n++;
+		ZVAL_DEREF(zcol);
+
+		if (Z_TYPE_P(zcol) != IS_ARRAY) {
+			/* just a title */
+			col->title = zval_get_string(zcol);
+			continue;
+		}
+
+		if ((zv = zend_hash_str_find(Z_ARRVAL_P(zcol), "key", sizeof("key") - 1)) != NULL) {
+			if (Z_TYPE_P(zv) == IS_LONG) {
+				col->index = Z_LVAL_P(zv);
+			} else {
+				col->key = zval_get_string(zv);
+			}
+		}
+		if ((zv = zend_hash_str_find(Z_ARRVAL_P(zcol), "title", sizeof("title") - 1)) != NULL) {
+			col->title = zval_get_string(zv);
+		}
+		col->width = (int)PHP_NCURSES_TABLE_OPTION(Z_ARRVAL_P(zcol), "width", 0);
+		if (col->width < 0) {
+			php_error_docref(NULL, E_WARNING, "Column %d has a negative width", n - 1);
+			return -1;
+		}
+		col->fixed = col->width > 0;
+		col->attr = (attr_t)PHP_NCURSES_TABLE_OPTION(Z_ARRVAL_P(zcol), "attr", 0);
+
+		if ((zv = zend_hash_str_find(Z_ARRVAL_P(zcol), "align", sizeof("align") - 1)) != NULL) {
+			align = zval_get_string(zv);
+			if (zend_string_equals_literal(align, "right")) {
+				col->align = PHP_NCURSES_ALIGN_RIGHT;
+			} else if (zend_string_equals_literal(align, "center")) {
+				col->align = PHP_NCURSES_ALIGN_CENTER;
+			} else if (!zend_string_equals_literal(align, "left")) {
+				php_error_docref(NULL, E_WARNING, "Column %d has an unknown alignment '%s'", n - 1, ZSTR_VAL(align));
+				zend_string_release(align);
+				return -1;
+			}
+			zend_string_release(align);
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	return n;
+}
+/* }}} */
+
+/* {{{ php_ncurses_table_free */
+static void php_ncurses_table_free(php_ncurses_table_column *cols, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++) {
+		if (cols[i].key) {
+			zend_string_release(cols[i].key);
+		}
+		if (cols[i].title) {
+			zend_string_release(cols[i].title);
+		}
+	}
+	efree(cols);
+}
+/* }}} */
+
+/* {{{ php_ncurses_table_line
+   Draws one line of the table at the cursor, the titles when row is NULL.
+   Columns and separators that do not fit into width are cut off */
+static void php_ncurses_table_line(WINDOW *win, php_ncurses_table_column *cols, int ncols, zval *row, int width, int separator, attr_t attr)
+{
+	zval *cell;
+	zend_string *str;
+	int i, used = 0, w;
+
+	for (i = 0; i < ncols && used < width; i++) {
+		if (i) {
+			wattrset(win, attr);
+			if (separator) {
+				if (used + 3 > width) {
+					break;
+				}
+				waddch(win, ' ');
+				waddch(win, ACS_VLINE);
+				waddch(win, ' ');
+				used += 3;
+			} else {
+				waddch(win, ' ');
+				used++;
+			}
+		}
+
+		w = MIN(cols[i].width, width - used);
+		if (row == NULL) {
+			str = cols[i].title ? zend_string_copy(cols[i].title) : NULL;
+		} else {
+			wattrset(win, attr | cols[i].attr);
+			str = (cell = php_ncurses_table_cell(row, &cols[i])) != NULL ? zval_get_string(cell) : NULL;
+		}
+		if (str) {
+			php_ncurses_waddfield(win, ZSTR_VAL(str), ZSTR_LEN(str), w, cols[i].align);
+			zend_string_release(str);
+		} else {
+			php_ncurses_table_pad(win, w);
+		}
+		used += w;
+	}
+
+	wattrset(win, attr);
+	php_ncurses_table_pad(win, width - used);
+}
+/* }}} */
+
+/* {{{ proto int ncurses_wdraw_table(resource window, array rows, array columns [, array options])
+   Draws rows as a table with a header and column separators and returns the
+   index of the first row shown. columns is a list of titles or of arrays
+   with the keys key, title, width, align (left, right, center) and attr.
+   options takes y, x, height, width, offset, selected, selected_attr,
+   header, header_attr and separator */
+PHP_FUNCTION(ncurses_wdraw_table)
+{
+	zval *handle, *zrows, *zcolumns, *zoptions = NULL, *row, *cell;
+	HashTable *options;
+	WINDOW *win;
+	php_ncurses_table_column *cols;
+	zend_string *str;
+	int ncols, i, maxy, maxx, top, left, height, width, total, sep, line, header, separator, visible;
+	zend_long offset, selected, index;
+	attr_t saved, header_attr, selected_attr;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), PHP_NCURSES_WIN "aa|a", &handle, &zrows, &zcolumns, &zoptions) == FAILURE) {
+		return;
+	}
+
+	FETCH_WINRES(win, &handle);
+
+	options = zoptions ? Z_ARRVAL_P(zoptions) : NULL;
+	getmaxyx(win, maxy, maxx);
+
+	top = (int)PHP_NCURSES_TABLE_OPTION(options, "y", 0);
+	left = (int)PHP_NCURSES_TABLE_OPTION(options, "x", 0);
+	height = (int)PHP_NCURSES_TABLE_OPTION(options, "height", maxy - top);
+	width = (int)PHP_NCURSES_TABLE_OPTION(options, "width", maxx - left);
+	if (top < 0 || left < 0 || height <= 0 || width <= 0 || top + height > maxy || left + width > maxx) {
+		php_error_docref(NULL, E_WARNING, "The table does not fit into the window");
+		RETURN_FALSE;
+	}
+
+	ncols = zend_hash_num_elements(Z_ARRVAL_P(zcolumns));
+	if (ncols == 0) {
+		php_error_docref(NULL, E_WARNING, "At least one column is required");
+		RETURN_FALSE;
+	}
+	cols = ecalloc(ncols, sizeof(php_ncurses_table_column));
+	if ((ncols = php_ncurses_table_columns(Z_ARRVAL_P(zcolumns), cols)) < 0) {
+		php_ncurses_table_free(cols, zend_hash_num_elements(Z_ARRVAL_P(zcolumns)));
+		RETURN_FALSE;
+	}
+
+	header = 0;
+	for (i = 0; i < ncols; i++) {
+		header |= cols[i].title != NULL && ZSTR_LEN(cols[i].title) > 0;
+	}
+	header = (int)PHP_NCURSES_TABLE_OPTION(options, "header", header);
+	separator = (int)PHP_NCURSES_TABLE_OPTION(options, "separator", 1);
+	header_attr = (attr_t)PHP_NCURSES_TABLE_OPTION(options, "header_attr", A_BOLD);
+	selected_attr = (attr_t)PHP_NCURSES_TABLE_OPTION(options, "selected_attr", A_REVERSE);
+	selected = PHP_NCURSES_TABLE_OPTION(options, "selected", -1);
+	offset = PHP_NCURSES_TABLE_OPTION(options, "offset", 0);
+	sep = separator ? 3 : 1;
+
+	/* size the columns that have no fixed width by their widest cell */
+	for (i = 0; i < ncols; i++) {
+		if (cols[i].fixed) {
+			continue;
+		}
+		if (header && cols[i].title) {
+			cols[i].width = php_ncurses_display_width(ZSTR_VAL(cols[i].title), ZSTR_LEN(cols[i].title), -1, NULL);
+		}
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(zrows), row) {
+			if ((cell = php_ncurses_table_cell(row, &cols[i])) != NULL) {
+				str = zval_get_string(cell);
+				cols[i].width = MAX(cols[i].width, php_ncurses_display_width(ZSTR_VAL(str), ZSTR_LEN(str), -1, NULL));
+				zend_string_release(str);
+			}
+		} ZEND_HASH_FOREACH_END();
+	}
+
+	/* shrink the widest automatic columns until the table fits */
+	total = (ncols - 1) * sep;
+	for (i = 0; i < ncols; i++) {
+		total += cols[i].width;
+	}
+	while (total > width) {
+		int widest = -1;
+
+		for (i = 0; i < ncols; i++) {
+			if (!cols[i].fixed && cols[i].width > 0 && (widest < 0 || cols[i].width > cols[widest].width)) {
+				widest = i;
+			}
+		}
+		if (widest < 0) {
+			break;
+		}
+		cols[widest].width--;
+		total--;
+	}
+
+	visible = height - (header ? (separator ? 2 : 1) : 0);
+	if (visible < 0) {
+		visible = 0;
+	}
+
+	/* keep the selected row in view */
+	if (selected >= 0 && visible > 0) {
+		if (selected < offset) {
+			offset = selected;
+		} else if (selected >= offset + visible) {
+			offset = selected - visible + 1;
+		}
+	}
+	if (offset > (zend_long)zend_hash_num_elements(Z_ARRVAL_P(zrows)) - visible) {
+		offset = (zend_long)zend_hash_num_elements(Z_ARRVAL_P(zrows)) - visible;
+	}
+	if (offset < 0) {
+		offset = 0;
+	}
+
+	saved = getattrs(win);
+	line = top;
+
+	if (header) {
+		wmove(win, line++, left);
+		php_ncurses_table_line(win, cols, ncols, NULL, width, separator, header_attr);
+
+		if (separator && line < top + height) {
+			wattrset(win, A_NORMAL);
+			mvwhline(win, line, left, ACS_HLINE, width);
+			total = left;
+			for (i = 0; i < ncols - 1; i++) {
+				total += cols[i].width + 1;
+				if (total < left + width) {
+					mvwaddch(win, line, total, ACS_PLUS);
+				}
+				total += 2;
+			}
+			line++;
+		}
+	}
+
+	index = 0;
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(zrows), row) {
+		if (index < offset) {
+			index++;
+			continue;
+		}
+		if (line >= top + height) {
+			break;
+		}
+
+		wmove(win, line++, left);
+		php_ncurses_table_line(win, cols, ncols, row, width, separator, index == selected ? selected_attr : A_NORMAL);
+		index++;
+	} ZEND_HASH_FOREACH_END();
+
+	/* blank what is left of the area */
+	wattrset(win, A_NORMAL);
+	while (line < top + height) {
+		wmove(win, line++, left);
+		php_ncurses_table_pad(win, width);
+	}
+
+	wattrset(win, saved);
+	php_ncurses_table_free(cols, ncols);
+
+	RETURN_LONG(offset);
+}
+/* }}} */
+
+#endif
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
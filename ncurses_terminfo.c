@@ -0,0 +1,494 @@
+/*
+   +----------------------------------------------------------------------+
+   | PHP Version 5                                                        |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1997-2006 The PHP Group                                |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_ini.h"
+#include "php_ncurses.h"
+
+/* Terminfo cache and lazy start, see ncurses.terminfo_cache.
+ *
+ * curses looks for the compiled description of $TERM in several
+ * directories, which is slow when they are on a network file system. The
+ * cache directory holds a copy of every description used so far, in the
+ * layout of a terminfo directory, and is put first in the search by setting
+ * $TERMINFO for the length of newterm(). <TERM>.src records which file
+ * a copy was made from and its modification time and size; the copy is
+ * made again once the original changes.
+ *
+ * Next to the descriptions <TERM>.acs keeps the values of the NCURSES_ACS_*
+ * constants, which curses only knows once it is started. With those at hand
+ * ncurses_init(true) registers the constants right away and leaves starting
+ * curses to the first function that needs it. */
+
+#if PHP_MAJOR_VERSION >= 7 && !defined(PHP_WIN32) && !defined(HAVE_PDCURSESLIB)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* compiled descriptions are far below this */
+#define PHP_NCURSES_TERMINFO_MAX_SIZE 65536
+
+#define PHP_NCURSES_ACS_MAGIC "NACS"
+#define PHP_NCURSES_SRC_MAGIC "NSRC"
+
+typedef struct _php_ncurses_acs_file {
+	char      magic[4];
+	uint32_t  count;    /* PHP_NCURSES_ACS_COUNT */
+	uint32_t  width;    /* sizeof(zend_long) */
+	uint32_t  reserved;
+	zend_long values[PHP_NCURSES_ACS_COUNT];
+} php_ncurses_acs_file;
+
+typedef struct _php_ncurses_src_file {
+	char     magic[4];
+	uint32_t reserved;
+	int64_t  mtime;    /* of the original when it was copied */
+	int64_t  size;
+	char     path[MAXPATHLEN];
+} php_ncurses_src_file;
+
+#define PHP_NCURSES_ACS_NAME(x)  "NCURSES_" #x,
+static const char *php_ncurses_acs_names[] = {
+	PHP_NCURSES_ACS_LIST(PHP_NCURSES_ACS_NAME)
+};
+
+/* {{{ php_ncurses_terminfo_usable
+   Returns whether term can be used as a file name */
+static int php_ncurses_terminfo_usable(const char *term)
+{
+	return term && *term && *term != '.' && !strchr(term, '/');
+}
+/* }}} */
+
+/* {{{ php_ncurses_terminfo_find
+   Looks for the compiled description of term in dir, in the letter and in
+   the hex layout. Fills path and sub with the file and its subdirectory */
+static int php_ncurses_terminfo_find(const char *dir, const char *term, char *path, size_t size, char *sub)
+{
+	struct stat st;
+
+	snprintf(sub, 3, "%c", term[0]);
+	snprintf(path, size, "%s/%s/%s", dir, sub, term);
+	if (stat(path, &st) == 0 && S_ISREG(st.st_mode)) {
+		return SUCCESS;
+	}
+
+	snprintf(sub, 3, "%02x", (unsigned char)term[0]);
+	snprintf(path, size, "%s/%s/%s", dir, sub, term);
+	if (stat(path, &st) == 0 && S_ISREG(st.st_mode)) {
+		return SUCCESS;
+	}
+
+	return FAILURE;
+}
+/* }}} */
+
+/* {{{ php_ncurses_terminfo_locate
+   Finds the description curses would load, in the order curses searches */
+static int php_ncurses_terminfo_locate(const char *term, char *path, size_t size, char *sub)
+{
+	static const char *defaults[] = {
+		"/etc/terminfo", "/lib/terminfo", "/usr/share/terminfo", "/usr/lib/terminfo", NULL
+	};
+	char dir[MAXPATHLEN], *env, *dirs, *cur, *next;
+	int i, ret = FAILURE;
+
+	if ((env = getenv("TERMINFO")) && *env &&
+		php_ncurses_terminfo_find(env, term, path, size, sub) == SUCCESS) {
+		return SUCCESS;
+	}
+	if ((env = getenv("HOME")) && *env) {
+		snprintf(dir, sizeof(dir), "%s/.terminfo", env);
+		if (php_ncurses_terminfo_find(dir, term, path, size, sub) == SUCCESS) {
+			return SUCCESS;
+		}
+	}
+	if ((env = getenv("TERMINFO_DIRS")) && *env) {
+		dirs = estrdup(env);
+		for (cur = dirs; cur && ret == FAILURE; cur = next) {
+			if ((next = strchr(cur, ':'))) {
+				*next++ = '\0';
+			}
+			if (*cur) {
+				ret = php_ncurses_terminfo_find(cur, term, path, size, sub);
+			}
+		}
+		efree(dirs);
+		if (ret == SUCCESS) {
+			return SUCCESS;
+		}
+	}
+	for (i = 0; defaults[i]; i++) {
+		if (php_ncurses_terminfo_find(defaults[i], term, path, size, sub) == SUCCESS) {
+			return SUCCESS;
+		}
+	}
+
+	return FAILURE;
+}
+/* }}} */
+
+/* {{{ php_ncurses_terminfo_write
+   Replaces path with len bytes of data, readers never see a partial file */
+static int php_ncurses_terminfo_write(const char *path, const void *data, size_t len)
+{
+	char tmp[MAXPATHLEN];
+	int fd;
+	ssize_t n;
+
+	snprintf(tmp, sizeof(tmp), "%s.%ld.tmp", path, (long)getpid());
+	if ((fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+		return FAILURE;
+	}
+	n = write(fd, data, len);
+	close(fd);
+	if (n != (ssize_t)len || rename(tmp, path) != 0) {
+		unlink(tmp);
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+/* }}} */
+
+/* {{{ php_ncurses_terminfo_fresh
+   Returns whether the original of the cached description of term is still
+   the file it was copied from */
+static int php_ncurses_terminfo_fresh(const char *cache, const char *term)
+{
+	char path[MAXPATHLEN];
+	php_ncurses_src_file src;
+	struct stat st;
+	ssize_t n;
+	int fd;
+
+	snprintf(path, sizeof(path), "%s/%s.src", cache, term);
+	if ((fd = open(path, O_RDONLY)) < 0) {
+		return FAILURE;
+	}
+	n = read(fd, &src, sizeof(src));
+	close(fd);
+
+	if (n != (ssize_t)sizeof(src) || memcmp(src.magic, PHP_NCURSES_SRC_MAGIC, 4)) {
+		return FAILURE;
+	}
+	src.path[sizeof(src.path) - 1] = '\0';
+	if (stat(src.path, &st) != 0 || (int64_t)st.st_mtime != src.mtime || (int64_t)st.st_size != src.size) {
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+/* }}} */
+
+/* {{{ php_ncurses_terminfo_fill
+   Copies the description of term into the cache unless an up to date copy
+   is there */
+static int php_ncurses_terminfo_fill(const char *cache, const char *term)
+{
+	char path[MAXPATHLEN], dest[MAXPATHLEN], sub[3];
+	char *data;
+	php_ncurses_src_file src;
+	struct stat st;
+	ssize_t len;
+	int fd, ret;
+
+	if (php_ncurses_terminfo_find(cache, term, path, sizeof(path), sub) == SUCCESS &&
+		php_ncurses_terminfo_fresh(cache, term) == SUCCESS) {
+		return SUCCESS;
+	}
+	if (php_ncurses_terminfo_locate(term, path, sizeof(path), sub) == FAILURE) {
+		return FAILURE;
+	}
+
+	if ((fd = open(path, O_RDONLY)) < 0) {
+		return FAILURE;
+	}
+	if (fstat(fd, &st) != 0 || st.st_size <= 0 || st.st_size > PHP_NCURSES_TERMINFO_MAX_SIZE) {
+		close(fd);
+		return FAILURE;
+	}
+	data = emalloc(st.st_size);
+	len = read(fd, data, st.st_size);
+	close(fd);
+	if (len != st.st_size) {
+		efree(data);
+		return FAILURE;
+	}
+
+	/* the layout of the directory the description came from is the one
+	   this curses reads */
+	mkdir(cache, 0755);
+	snprintf(dest, sizeof(dest), "%s/%s", cache, sub);
+	mkdir(dest, 0755);
+	snprintf(dest, sizeof(dest), "%s/%s/%s", cache, sub, term);
+	ret = php_ncurses_terminfo_write(dest, data, len);
+	efree(data);
+	if (ret == FAILURE) {
+		return FAILURE;
+	}
+
+	memset(&src, 0, sizeof(src));
+	memcpy(src.magic, PHP_NCURSES_SRC_MAGIC, 4);
+	src.mtime = (int64_t)st.st_mtime;
+	src.size = (int64_t)st.st_size;
+	strlcpy(src.path, path, sizeof(src.path));
+	snprintf(dest, sizeof(dest), "%s/%s.src", cache, term);
+	php_ncurses_terminfo_write(dest, &src, sizeof(src));
+
+	/* the ACS table came from the old description */
+	snprintf(dest, sizeof(dest), "%s/%s.acs", cache, term);
+	unlink(dest);
+
+	return SUCCESS;
+}
+/* }}} */
+
+/* {{{ php_ncurses_terminfo_begin
+   Points curses at the cache for the following newterm(). Returns what
+   php_ncurses_terminfo_end() needs to undo it */
+PHP_NCURSES_API char *php_ncurses_terminfo_begin(const char *term, zend_bool *active)
+{
+	char *cache = NCURSES_G(terminfo_cache), *saved;
+
+	*active = 0;
+	if (!cache || !*cache || !php_ncurses_terminfo_usable(term) ||
+		php_ncurses_terminfo_fill(cache, term) == FAILURE) {
+		return NULL;
+	}
+
+	saved = getenv("TERMINFO");
+	saved = saved ? estrdup(saved) : NULL;
+	setenv("TERMINFO", cache, 1);
+	*active = 1;
+
+	return saved;
+}
+/* }}} */
+
+/* {{{ php_ncurses_terminfo_end */
+PHP_NCURSES_API void php_ncurses_terminfo_end(char *saved, zend_bool active)
+{
+	if (!active) {
+		return;
+	}
+	if (saved) {
+		setenv("TERMINFO", saved, 1);
+		efree(saved);
+	} else {
+		unsetenv("TERMINFO");
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_acs_open
+   Maps the ACS table cached for term, NULL if there is no valid one */
+static php_ncurses_acs_file *php_ncurses_acs_open(const char *term)
+{
+	char *cache = NCURSES_G(terminfo_cache), path[MAXPATHLEN];
+	php_ncurses_acs_file *acs;
+	struct stat st;
+	int fd;
+
+	if (!cache || !*cache || !php_ncurses_terminfo_usable(term)) {
+		return NULL;
+	}
+
+	snprintf(path, sizeof(path), "%s/%s.acs", cache, term);
+	if ((fd = open(path, O_RDONLY)) < 0) {
+		return NULL;
+	}
+	if (fstat(fd, &st) != 0 || st.st_size != sizeof(php_ncurses_acs_file)) {
+		close(fd);
+		return NULL;
+	}
+	acs = mmap(NULL, sizeof(php_ncurses_acs_file), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (acs == MAP_FAILED) {
+		return NULL;
+	}
+
+	if (memcmp(acs->magic, PHP_NCURSES_ACS_MAGIC, 4) || acs->count != PHP_NCURSES_ACS_COUNT ||
+		acs->width != sizeof(zend_long)) {
+		munmap(acs, sizeof(php_ncurses_acs_file));
+		return NULL;
+	}
+
+	return acs;
+}
+/* }}} */
+
+/* {{{ php_ncurses_acs_store
+   Saves the ACS table of the running curses for term, unless the cached
+   one already has these values */
+PHP_NCURSES_API void php_ncurses_acs_store(const char *term)
+{
+#define PHP_NCURSES_ACS_VALUE(x)  (zend_long)(x),
+	zend_long values[PHP_NCURSES_ACS_COUNT] = {
+		PHP_NCURSES_ACS_LIST(PHP_NCURSES_ACS_VALUE)
+	};
+#undef PHP_NCURSES_ACS_VALUE
+	char path[MAXPATHLEN];
+	php_ncurses_acs_file *acs, file;
+
+	if ((acs = php_ncurses_acs_open(term))) {
+		int same = !memcmp(acs->values, values, sizeof(values));
+
+		munmap(acs, sizeof(php_ncurses_acs_file));
+		if (same) {
+			return;
+		}
+	} else if (!NCURSES_G(terminfo_cache) || !*NCURSES_G(terminfo_cache) || !php_ncurses_terminfo_usable(term)) {
+		return;
+	}
+
+	memset(&file, 0, sizeof(file));
+	memcpy(file.magic, PHP_NCURSES_ACS_MAGIC, 4);
+	file.count = PHP_NCURSES_ACS_COUNT;
+	file.width = sizeof(zend_long);
+	memcpy(file.values, values, sizeof(values));
+
+	mkdir(NCURSES_G(terminfo_cache), 0755);
+	snprintf(path, sizeof(path), "%s/%s.acs", NCURSES_G(terminfo_cache), term);
+	php_ncurses_terminfo_write(path, &file, sizeof(file));
+}
+/* }}} */
+
+/* {{{ php_ncurses_lazy_register
+   Registers the constants of an initialized curses from the cached ACS
+   table, STDSCR gets a window that is filled in when curses starts.
+   Fails if nothing is cached for term */
+PHP_NCURSES_API int php_ncurses_lazy_register(const char *term)
+{
+	php_ncurses_acs_file *acs;
+	int i;
+
+	if (NCURSES_G(registered_constants) || !(acs = php_ncurses_acs_open(term))) {
+		return FAILURE;
+	}
+
+	for (i = 0; i < PHP_NCURSES_ACS_COUNT; i++) {
+		zend_register_long_constant(php_ncurses_acs_names[i], strlen(php_ncurses_acs_names[i]),
+			acs->values[i], CONST_CS, ncurses_module_entry.module_number);
+	}
+	munmap(acs, sizeof(php_ncurses_acs_file));
+
+	NCURSES_G(lazy_stdscr) = php_ncurses_register_stdscr(NULL);
+	NCURSES_G(registered_constants) = 1;
+	NCURSES_G(lazy) = 1;
+
+	return SUCCESS;
+}
+/* }}} */
+
+/* {{{ php_ncurses_lazy_start
+   Starts curses deferred by ncurses_init(true) */
+PHP_NCURSES_API int php_ncurses_lazy_start(void)
+{
+	if (php_ncurses_start() == FAILURE) {
+		/* php_ncurses_start() warned; the constants stay registered and
+		   the start is tried again by the next function that needs it */
+		return FAILURE;
+	}
+	NCURSES_G(lazy) = 0;
+	return SUCCESS;
+}
+/* }}} */
+
+/* {{{ php_ncurses_lazy_window
+   Starts curses if handle is the STDSCR of ncurses_init(true) and returns
+   stdscr, NULL otherwise */
+PHP_NCURSES_API WINDOW *php_ncurses_lazy_window(void *handle)
+{
+	if (!NCURSES_G(lazy) || handle != NCURSES_G(lazy_stdscr)) {
+		return NULL;
+	}
+	return php_ncurses_lazy_start() == SUCCESS ? stdscr : NULL;
+}
+/* }}} */
+
+/* {{{ php_ncurses_lazy_resolve
+   Gives the STDSCR of ncurses_init(true) the stdscr of the main screen */
+PHP_NCURSES_API void php_ncurses_lazy_resolve(void)
+{
+	void *handle = NCURSES_G(lazy_stdscr);
+
+	if (!handle) {
+		return;
+	}
+#if PHP_VERSION_ID >= 80000
+	php_ncurses_window_from_obj((zend_object *)handle)->win = stdscr;
+#else
+	((zend_resource *)handle)->ptr = stdscr;
+#endif
+	NCURSES_G(lazy_stdscr) = NULL;
+	NCURSES_G(lazy) = 0;
+}
+/* }}} */
+
+#else
+
+PHP_NCURSES_API char *php_ncurses_terminfo_begin(const char *term, zend_bool *active)
+{
+	*active = 0;
+	return NULL;
+}
+
+PHP_NCURSES_API void php_ncurses_terminfo_end(char *saved, zend_bool active)
+{
+}
+
+PHP_NCURSES_API void php_ncurses_acs_store(const char *term)
+{
+}
+
+PHP_NCURSES_API int php_ncurses_lazy_register(const char *term)
+{
+	return FAILURE;
+}
+
+PHP_NCURSES_API int php_ncurses_lazy_start(void)
+{
+	NCURSES_G(lazy) = 0;
+	return FAILURE;
+}
+
+PHP_NCURSES_API WINDOW *php_ncurses_lazy_window(void *handle)
+{
+	return NULL;
+}
+
+PHP_NCURSES_API void php_ncurses_lazy_resolve(void)
+{
+}
+
+#endif
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
@@ -0,0 +1,810 @@
+/*
+   +----------------------------------------------------------------------+
+   | PHP Version 5                                                        |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1997-2006 The PHP Group                                |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_ini.h"
+#include "php_ncurses.h"
+
+#if PHP_VERSION_ID >= 80000
+#include "ncurses_window_arginfo.h"
+
+PHP_NCURSES_API zend_class_entry *php_ncurses_window_ce;
+static zend_object_handlers php_ncurses_window_handlers;
+
+#define Z_NCURSES_WINDOW_P(zv) php_ncurses_window_from_obj(Z_OBJ_P(zv))
+
+#define PHP_NCURSES_WINDOW_THIS(w) \
+	if (NULL == ((w) = Z_NCURSES_WINDOW_P(ZEND_THIS)->win) && \
+		NULL == ((w) = php_ncurses_lazy_window(Z_OBJ_P(ZEND_THIS)))) { \
+		zend_throw_error(NULL, "NcursesWindow has already been deleted"); \
+		RETURN_THROWS(); \
+	}
+
+#if HAVE_NCURSES_PANEL
+PHP_NCURSES_API zend_class_entry *php_ncurses_panel_ce;
+static zend_object_handlers php_ncurses_panel_handlers;
+
+#define Z_NCURSES_PANEL_P(zv) php_ncurses_panel_from_obj(Z_OBJ_P(zv))
+
+#define PHP_NCURSES_PANEL_THIS(p) \
+	if (NULL == ((p) = Z_NCURSES_PANEL_P(ZEND_THIS))->panel) { \
+		zend_throw_error(NULL, "NcursesPanel has already been deleted"); \
+		RETURN_THROWS(); \
+	}
+#endif
+
+#define PHP_NCURSES_CHECK_INITIALIZED() \
+	if (!NCURSES_G(registered_constants)) { \
+		zend_throw_error(NULL, "You must initialize ncurses via ncurses_init(), before calling any ncurses functions."); \
+		RETURN_THROWS(); \
+	}
+
+/* {{{ php_ncurses_window_attach
+   Ties obj to the current screen, which must outlive the windows made on it */
+static void php_ncurses_window_attach(php_ncurses_window *obj)
+{
+	if (obj->screen) {
+		OBJ_RELEASE(obj->screen);
+	}
+	obj->screen = NCURSES_G(screen);
+	if (obj->screen) {
+		GC_ADDREF(obj->screen);
+	}
+}
+/* }}} */
+
+/* {{{ php_ncurses_window_wrap
+   Initializes zv as a window object for win */
+PHP_NCURSES_API void php_ncurses_window_wrap(zval *zv, WINDOW *win, zend_bool owned)
+{
+	php_ncurses_window *obj;
+
+	object_init_ex(zv, php_ncurses_window_ce);
+	obj = Z_NCURSES_WINDOW_P(zv);
+	obj->win = win;
+	obj->owned = owned;
+	php_ncurses_window_attach(obj);
+}
+/* }}} */
+
+/* {{{ php_ncurses_window_fetch
+   Returns the WINDOW behind zv, throws and returns NULL if there is none */
+PHP_NCURSES_API WINDOW *php_ncurses_window_fetch(zval *zv)
+{
+	php_ncurses_window *obj;
+
+	if (Z_TYPE_P(zv) != IS_OBJECT || Z_OBJCE_P(zv) != php_ncurses_window_ce) {
+		zend_type_error("%s(): Argument must be of type NcursesWindow, %s given", get_active_function_name(), zend_zval_type_name(zv));
+		return NULL;
+	}
+
+	obj = Z_NCURSES_WINDOW_P(zv);
+	if (!obj->win && !php_ncurses_lazy_window(&obj->std)) {
+		zend_throw_error(NULL, "NcursesWindow has already been deleted");
+		return NULL;
+	}
+
+	return obj->win;
+}
+/* }}} */
+
+/* {{{ php_ncurses_window_delete */
+PHP_NCURSES_API void php_ncurses_window_delete(php_ncurses_window *obj)
+{
+#if HAVE_NCURSES_PANEL
+	if (obj->panel) {
+		/* the panel must not outlive the window it shows */
+		php_ncurses_panel_delete(php_ncurses_panel_from_obj(obj->panel));
+	}
+#endif
+	if (obj->win && obj->owned) {
+		delwin(obj->win);
+	}
+	obj->win = NULL;
+}
+/* }}} */
+
+static zend_object *php_ncurses_window_new(zend_class_entry *ce)
+{
+	php_ncurses_window *obj = zend_object_alloc(sizeof(php_ncurses_window), ce);
+
+	obj->win = NULL;
+	obj->owned = 0;
+	obj->panel = NULL;
+	obj->screen = NULL;
+
+	zend_object_std_init(&obj->std, ce);
+	object_properties_init(&obj->std, ce);
+	obj->std.handlers = &php_ncurses_window_handlers;
+
+	return &obj->std;
+}
+
+static void php_ncurses_window_free(zend_object *object)
+{
+	php_ncurses_window *obj = php_ncurses_window_from_obj(object);
+
+	php_ncurses_window_delete(obj);
+	if (obj->screen) {
+		OBJ_RELEASE(obj->screen);
+	}
+
+	zend_object_std_dtor(object);
+}
+
+/* {{{ proto NcursesWindow::__construct(int rows, int cols [, int y [, int x]])
+   Creates a new window */
+ZEND_METHOD(NcursesWindow, __construct)
+{
+	zend_long rows, cols, y = 0, x = 0;
+	php_ncurses_window *obj = Z_NCURSES_WINDOW_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "ll|ll", &rows, &cols, &y, &x) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	PHP_NCURSES_CHECK_INITIALIZED();
+
+	php_ncurses_window_delete(obj);
+
+	obj->win = newwin(rows, cols, y, x);
+	if (!obj->win) {
+		zend_throw_error(NULL, "Unable to create a %d x %d window at %d, %d", (int)rows, (int)cols, (int)y, (int)x);
+		RETURN_THROWS();
+	}
+	obj->owned = 1;
+	php_ncurses_window_attach(obj);
+}
+/* }}} */
+
+/* {{{ proto int NcursesWindow::addch(int ch)
+   Adds a character at the cursor position and advances the cursor */
+ZEND_METHOD(NcursesWindow, addch)
+{
+	zend_long ch;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "l", &ch) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	PHP_NCURSES_WINDOW_THIS(win);
+
+	RETURN_LONG(waddch(win, ch));
+}
+/* }}} */
+
+/* {{{ proto int NcursesWindow::addstr(string text)
+   Outputs text at the cursor position */
+ZEND_METHOD(NcursesWindow, addstr)
+{
+	char *text;
+	size_t text_len;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "s", &text, &text_len) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	PHP_NCURSES_WINDOW_THIS(win);
+
+	RETURN_LONG(php_ncurses_waddnstr(win, text, text_len, -1));
+}
+/* }}} */
+
+/* {{{ proto int NcursesWindow::mvaddstr(int y, int x, string text)
+   Outputs text at the given position */
+ZEND_METHOD(NcursesWindow, mvaddstr)
+{
+	zend_long y, x;
+	char *text;
+	size_t text_len;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "lls", &y, &x, &text, &text_len) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	PHP_NCURSES_WINDOW_THIS(win);
+
+	if (wmove(win, y, x) == ERR) {
+		RETURN_LONG(ERR);
+	}
+	RETURN_LONG(php_ncurses_waddnstr(win, text, text_len, -1));
+}
+/* }}} */
+
+/* {{{ proto int NcursesWindow::move(int y, int x)
+   Moves the cursor */
+ZEND_METHOD(NcursesWindow, move)
+{
+	zend_long y, x;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "ll", &y, &x) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	PHP_NCURSES_WINDOW_THIS(win);
+
+	RETURN_LONG(wmove(win, y, x));
+}
+/* }}} */
+
+/* generates the methods wrapping a curses call that only takes the window */
+#define PHP_NCURSES_WINDOW_METHOD(name, call) \
+	ZEND_METHOD(NcursesWindow, name) \
+	{ \
+		WINDOW *win; \
+		\
+		ZEND_PARSE_PARAMETERS_NONE(); \
+		\
+		PHP_NCURSES_WINDOW_THIS(win); \
+		\
+		RETURN_LONG(call(win)); \
+	}
+
+/* {{{ proto int NcursesWindow::refresh(void)
+   Copies the window to the terminal, or only to the virtual screen inside a frame */
+PHP_NCURSES_WINDOW_METHOD(refresh, php_ncurses_wrefresh)
+/* }}} */
+
+/* {{{ proto int NcursesWindow::noutrefresh(void)
+   Copies the window to the virtual screen, see ncurses_doupdate() */
+PHP_NCURSES_WINDOW_METHOD(noutrefresh, php_ncurses_wnoutrefresh)
+/* }}} */
+
+/* {{{ proto int NcursesWindow::clear(void)
+   Clears the window and repaints it completely on the next refresh */
+PHP_NCURSES_WINDOW_METHOD(clear, wclear)
+/* }}} */
+
+/* {{{ proto int NcursesWindow::erase(void)
+   Blanks the window */
+PHP_NCURSES_WINDOW_METHOD(erase, werase)
+/* }}} */
+
+/* {{{ proto int NcursesWindow::getch(void)
+   Reads a character from the keyboard */
+PHP_NCURSES_WINDOW_METHOD(getch, php_ncurses_wgetch)
+/* }}} */
+
+/* {{{ proto int NcursesWindow::border([int left [, int right [, int top [, int bottom [, int tl_corner [, int tr_corner [, int bl_corner [, int br_corner]]]]]]]])
+   Draws a border around the window, 0 selects the default character */
+ZEND_METHOD(NcursesWindow, border)
+{
+	zend_long ls = 0, rs = 0, ts = 0, bs = 0, tl = 0, tr = 0, bl = 0, br = 0;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "|llllllll", &ls, &rs, &ts, &bs, &tl, &tr, &bl, &br) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	PHP_NCURSES_WINDOW_THIS(win);
+
+	RETURN_LONG(wborder(win, ls, rs, ts, bs, tl, tr, bl, br));
+}
+/* }}} */
+
+/* {{{ proto int NcursesWindow::hline(int ch, int n)
+   Draws a horizontal line of at most n characters starting at the cursor */
+ZEND_METHOD(NcursesWindow, hline)
+{
+	zend_long ch, n;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "ll", &ch, &n) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	PHP_NCURSES_WINDOW_THIS(win);
+
+	RETURN_LONG(whline(win, ch, n));
+}
+/* }}} */
+
+/* {{{ proto int NcursesWindow::vline(int ch, int n)
+   Draws a vertical line of at most n characters starting at the cursor */
+ZEND_METHOD(NcursesWindow, vline)
+{
+	zend_long ch, n;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "ll", &ch, &n) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	PHP_NCURSES_WINDOW_THIS(win);
+
+	RETURN_LONG(wvline(win, ch, n));
+}
+/* }}} */
+
+/* generates the methods wrapping a curses call that takes the window and one integer */
+#define PHP_NCURSES_WINDOW_LONG_METHOD(name, call) \
+	ZEND_METHOD(NcursesWindow, name) \
+	{ \
+		zend_long l; \
+		WINDOW *win; \
+		\
+		if (zend_parse_parameters(ZEND_NUM_ARGS(), "l", &l) == FAILURE) { \
+			RETURN_THROWS(); \
+		} \
+		\
+		PHP_NCURSES_WINDOW_THIS(win); \
+		\
+		RETURN_LONG(call(win, l)); \
+	}
+
+/* {{{ proto int NcursesWindow::attron(int attrs)
+   Turns on the given attributes */
+PHP_NCURSES_WINDOW_LONG_METHOD(attron, wattron)
+/* }}} */
+
+/* {{{ proto int NcursesWindow::attroff(int attrs)
+   Turns off the given attributes */
+PHP_NCURSES_WINDOW_LONG_METHOD(attroff, wattroff)
+/* }}} */
+
+/* {{{ proto int NcursesWindow::attrset(int attrs)
+   Sets the given attributes */
+PHP_NCURSES_WINDOW_LONG_METHOD(attrset, wattrset)
+/* }}} */
+
+/* {{{ proto int NcursesWindow::bkgd(int ch)
+   Sets the background and applies it to every cell of the window */
+PHP_NCURSES_WINDOW_LONG_METHOD(bkgd, wbkgd)
+/* }}} */
+
+/* {{{ proto int NcursesWindow::scrl(int n)
+   Scrolls the window up (n > 0) or down (n < 0) */
+PHP_NCURSES_WINDOW_LONG_METHOD(scrl, wscrl)
+/* }}} */
+
+/* {{{ proto int NcursesWindow::keypad(bool enable)
+   Turns keypad translation on or off */
+ZEND_METHOD(NcursesWindow, keypad)
+{
+	zend_bool enable;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "b", &enable) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	PHP_NCURSES_WINDOW_THIS(win);
+
+	RETURN_LONG(keypad(win, enable));
+}
+/* }}} */
+
+/* {{{ proto int NcursesWindow::scrollok(bool enable)
+   Enables or disables scrolling */
+ZEND_METHOD(NcursesWindow, scrollok)
+{
+	zend_bool enable;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "b", &enable) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	PHP_NCURSES_WINDOW_THIS(win);
+
+	RETURN_LONG(scrollok(win, enable));
+}
+/* }}} */
+
+/* {{{ proto int NcursesWindow::setscrreg(int top, int bottom)
+   Sets the scrolling region */
+ZEND_METHOD(NcursesWindow, setscrreg)
+{
+	zend_long top, bottom;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "ll", &top, &bottom) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	PHP_NCURSES_WINDOW_THIS(win);
+
+	RETURN_LONG(wsetscrreg(win, top, bottom));
+}
+/* }}} */
+
+/* {{{ proto array NcursesWindow::getyx(void)
+   Returns the cursor position as [y, x] */
+ZEND_METHOD(NcursesWindow, getyx)
+{
+	int y, x;
+	WINDOW *win;
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	PHP_NCURSES_WINDOW_THIS(win);
+
+	getyx(win, y, x);
+
+	array_init_size(return_value, 2);
+	add_next_index_long(return_value, y);
+	add_next_index_long(return_value, x);
+}
+/* }}} */
+
+/* {{{ proto array NcursesWindow::getmaxyx(void)
+   Returns the size of the window as [rows, cols] */
+ZEND_METHOD(NcursesWindow, getmaxyx)
+{
+	int y, x;
+	WINDOW *win;
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	PHP_NCURSES_WINDOW_THIS(win);
+
+	getmaxyx(win, y, x);
+
+	array_init_size(return_value, 2);
+	add_next_index_long(return_value, y);
+	add_next_index_long(return_value, x);
+}
+/* }}} */
+
+/* {{{ proto int NcursesWindow::prefresh(int pminrow, int pmincol, int sminrow, int smincol, int smaxrow, int smaxcol)
+   Copies a region of this pad to the terminal */
+ZEND_METHOD(NcursesWindow, prefresh)
+{
+	zend_long pminrow, pmincol, sminrow, smincol, smaxrow, smaxcol;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "llllll", &pminrow, &pmincol, &sminrow, &smincol, &smaxrow, &smaxcol) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	PHP_NCURSES_WINDOW_THIS(win);
+
+	RETURN_LONG(php_ncurses_prefresh(win, pminrow, pmincol, sminrow, smincol, smaxrow, smaxcol));
+}
+/* }}} */
+
+/* {{{ proto int NcursesWindow::pnoutrefresh(int pminrow, int pmincol, int sminrow, int smincol, int smaxrow, int smaxcol)
+   Copies a region of this pad to the virtual screen */
+ZEND_METHOD(NcursesWindow, pnoutrefresh)
+{
+	zend_long pminrow, pmincol, sminrow, smincol, smaxrow, smaxcol;
+	WINDOW *win;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "llllll", &pminrow, &pmincol, &sminrow, &smincol, &smaxrow, &smaxcol) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	PHP_NCURSES_WINDOW_THIS(win);
+
+	php_ncurses_frame_touch();
+	RETURN_LONG(pnoutrefresh(win, pminrow, pmincol, sminrow, smincol, smaxrow, smaxcol));
+}
+/* }}} */
+
+/* {{{ proto void NcursesWindow::delete(void)
+   Deletes the window right away instead of when the object is released */
+ZEND_METHOD(NcursesWindow, delete)
+{
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	php_ncurses_window_delete(Z_NCURSES_WINDOW_P(ZEND_THIS));
+}
+/* }}} */
+
+#if HAVE_NCURSES_PANEL
+/* {{{ php_ncurses_panel_wrap
+   Initializes zv as a panel object for panel, window is the window object it was created with */
+PHP_NCURSES_API void php_ncurses_panel_wrap(zval *zv, PANEL *panel, zval *window)
+{
+	php_ncurses_panel *obj;
+
+	object_init_ex(zv, php_ncurses_panel_ce);
+	obj = Z_NCURSES_PANEL_P(zv);
+	obj->panel = panel;
+	ZVAL_COPY(&obj->window, window);
+	Z_NCURSES_WINDOW_P(window)->panel = &obj->std;
+
+	set_panel_userptr(panel, (void *)&obj->std);
+}
+/* }}} */
+
+/* {{{ php_ncurses_panel_fetch
+   Returns the PANEL behind zv, throws and returns NULL if there is none */
+PHP_NCURSES_API PANEL *php_ncurses_panel_fetch(zval *zv)
+{
+	php_ncurses_panel *obj;
+
+	if (Z_TYPE_P(zv) != IS_OBJECT || Z_OBJCE_P(zv) != php_ncurses_panel_ce) {
+		zend_type_error("%s(): Argument must be of type NcursesPanel, %s given", get_active_function_name(), zend_zval_type_name(zv));
+		return NULL;
+	}
+
+	obj = Z_NCURSES_PANEL_P(zv);
+	if (!obj->panel) {
+		zend_throw_error(NULL, "NcursesPanel has already been deleted");
+		return NULL;
+	}
+
+	return obj->panel;
+}
+/* }}} */
+
+/* {{{ php_ncurses_panel_replace */
+PHP_NCURSES_API int php_ncurses_panel_replace(php_ncurses_panel *obj, zval *window)
+{
+	zval old;
+	int ret = replace_panel(obj->panel, Z_NCURSES_WINDOW_P(window)->win);
+
+	if (ret == OK) {
+		ZVAL_COPY_VALUE(&old, &obj->window);
+		Z_NCURSES_WINDOW_P(&old)->panel = NULL;
+		ZVAL_COPY(&obj->window, window);
+		Z_NCURSES_WINDOW_P(window)->panel = &obj->std;
+		zval_ptr_dtor(&old);
+	}
+
+	return ret;
+}
+/* }}} */
+
+/* {{{ php_ncurses_panel_delete */
+PHP_NCURSES_API void php_ncurses_panel_delete(php_ncurses_panel *obj)
+{
+	zval window;
+
+	if (obj->panel) {
+		del_panel(obj->panel);
+		obj->panel = NULL;
+	}
+	if (Z_TYPE(obj->window) == IS_OBJECT && Z_NCURSES_WINDOW_P(&obj->window)->panel == &obj->std) {
+		Z_NCURSES_WINDOW_P(&obj->window)->panel = NULL;
+	}
+	ZVAL_COPY_VALUE(&window, &obj->window);
+	ZVAL_UNDEF(&obj->window);
+	zval_ptr_dtor(&window);
+}
+/* }}} */
+
+static zend_object *php_ncurses_panel_new(zend_class_entry *ce)
+{
+	php_ncurses_panel *obj = zend_object_alloc(sizeof(php_ncurses_panel), ce);
+
+	obj->panel = NULL;
+	ZVAL_UNDEF(&obj->window);
+
+	zend_object_std_init(&obj->std, ce);
+	object_properties_init(&obj->std, ce);
+	obj->std.handlers = &php_ncurses_panel_handlers;
+
+	return &obj->std;
+}
+
+static void php_ncurses_panel_free(zend_object *object)
+{
+	php_ncurses_panel_delete(php_ncurses_panel_from_obj(object));
+
+	zend_object_std_dtor(object);
+}
+
+/* {{{ proto NcursesPanel::__construct(NcursesWindow window)
+   Creates a panel for window and puts it on top of the stack */
+ZEND_METHOD(NcursesPanel, __construct)
+{
+	zval *zwin;
+	WINDOW *win;
+	php_ncurses_panel *obj = Z_NCURSES_PANEL_P(ZEND_THIS);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "O", &zwin, php_ncurses_window_ce) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	if (NULL == (win = php_ncurses_window_fetch(zwin))) {
+		RETURN_THROWS();
+	}
+
+	php_ncurses_panel_delete(obj);
+
+	obj->panel = new_panel(win);
+	if (!obj->panel) {
+		zend_throw_error(NULL, "Unable to create a panel");
+		RETURN_THROWS();
+	}
+	ZVAL_COPY(&obj->window, zwin);
+	Z_NCURSES_WINDOW_P(zwin)->panel = &obj->std;
+	set_panel_userptr(obj->panel, (void *)&obj->std);
+}
+/* }}} */
+
+/* generates the methods wrapping a panel call that only takes the panel */
+#define PHP_NCURSES_PANEL_METHOD(name, call) \
+	ZEND_METHOD(NcursesPanel, name) \
+	{ \
+		php_ncurses_panel *obj; \
+		\
+		ZEND_PARSE_PARAMETERS_NONE(); \
+		\
+		PHP_NCURSES_PANEL_THIS(obj); \
+		\
+		RETURN_LONG(call(obj->panel)); \
+	}
+
+/* {{{ proto int NcursesPanel::show(void)
+   Puts the panel back on top of the stack */
+PHP_NCURSES_PANEL_METHOD(show, show_panel)
+/* }}} */
+
+/* {{{ proto int NcursesPanel::hide(void)
+   Removes the panel from the stack */
+PHP_NCURSES_PANEL_METHOD(hide, hide_panel)
+/* }}} */
+
+/* {{{ proto int NcursesPanel::top(void)
+   Moves the panel to the top of the stack */
+PHP_NCURSES_PANEL_METHOD(top, top_panel)
+/* }}} */
+
+/* {{{ proto int NcursesPanel::bottom(void)
+   Moves the panel to the bottom of the stack */
+PHP_NCURSES_PANEL_METHOD(bottom, bottom_panel)
+/* }}} */
+
+/* {{{ proto int NcursesPanel::move(int y, int x)
+   Moves the panel so that its upper-left corner is at y, x */
+ZEND_METHOD(NcursesPanel, move)
+{
+	zend_long y, x;
+	php_ncurses_panel *obj;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "ll", &y, &x) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	PHP_NCURSES_PANEL_THIS(obj);
+
+	RETURN_LONG(move_panel(obj->panel, y, x));
+}
+/* }}} */
+
+/* {{{ proto NcursesWindow NcursesPanel::window(void)
+   Returns the window of the panel */
+ZEND_METHOD(NcursesPanel, window)
+{
+	php_ncurses_panel *obj;
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	PHP_NCURSES_PANEL_THIS(obj);
+
+	RETURN_COPY(&obj->window);
+}
+/* }}} */
+
+/* {{{ proto int NcursesPanel::replace(NcursesWindow window)
+   Replaces the window of the panel */
+ZEND_METHOD(NcursesPanel, replace)
+{
+	zval *zwin;
+	php_ncurses_panel *obj;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "O", &zwin, php_ncurses_window_ce) == FAILURE) {
+		RETURN_THROWS();
+	}
+
+	PHP_NCURSES_PANEL_THIS(obj);
+
+	if (NULL == php_ncurses_window_fetch(zwin)) {
+		RETURN_THROWS();
+	}
+
+	RETURN_LONG(php_ncurses_panel_replace(obj, zwin));
+}
+/* }}} */
+
+/* {{{ proto ?NcursesPanel NcursesPanel::above(void)
+   Returns the panel above this one */
+ZEND_METHOD(NcursesPanel, above)
+{
+	php_ncurses_panel *obj;
+	PANEL *above;
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	PHP_NCURSES_PANEL_THIS(obj);
+
+	if (NULL == (above = panel_above(obj->panel))) {
+		RETURN_NULL();
+	}
+
+	GC_ADDREF((zend_object *)panel_userptr(above));
+	RETURN_OBJ((zend_object *)panel_userptr(above));
+}
+/* }}} */
+
+/* {{{ proto ?NcursesPanel NcursesPanel::below(void)
+   Returns the panel below this one */
+ZEND_METHOD(NcursesPanel, below)
+{
+	php_ncurses_panel *obj;
+	PANEL *below;
+
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	PHP_NCURSES_PANEL_THIS(obj);
+
+	if (NULL == (below = panel_below(obj->panel))) {
+		RETURN_NULL();
+	}
+
+	GC_ADDREF((zend_object *)panel_userptr(below));
+	RETURN_OBJ((zend_object *)panel_userptr(below));
+}
+/* }}} */
+
+/* {{{ proto void NcursesPanel::delete(void)
+   Removes the panel from the stack and deletes it, the window is kept */
+ZEND_METHOD(NcursesPanel, delete)
+{
+	ZEND_PARSE_PARAMETERS_NONE();
+
+	php_ncurses_panel_delete(Z_NCURSES_PANEL_P(ZEND_THIS));
+}
+/* }}} */
+#endif
+
+/* {{{ PHP_MINIT_FUNCTION
+ */
+PHP_MINIT_FUNCTION(ncurses_window)
+{
+	php_ncurses_window_ce = register_class_NcursesWindow();
+	php_ncurses_window_ce->create_object = php_ncurses_window_new;
+
+	memcpy(&php_ncurses_window_handlers, &std_object_handlers, sizeof(zend_object_handlers));
+	php_ncurses_window_handlers.offset = XtOffsetOf(php_ncurses_window, std);
+	php_ncurses_window_handlers.free_obj = php_ncurses_window_free;
+	php_ncurses_window_handlers.clone_obj = NULL;
+
+#if HAVE_NCURSES_PANEL
+	php_ncurses_panel_ce = register_class_NcursesPanel();
+	php_ncurses_panel_ce->create_object = php_ncurses_panel_new;
+
+	memcpy(&php_ncurses_panel_handlers, &std_object_handlers, sizeof(zend_object_handlers));
+	php_ncurses_panel_handlers.offset = XtOffsetOf(php_ncurses_panel, std);
+	php_ncurses_panel_handlers.free_obj = php_ncurses_panel_free;
+	php_ncurses_panel_handlers.clone_obj = NULL;
+#endif
+
+	return SUCCESS;
+}
+/* }}} */
+
+#endif /* PHP_VERSION_ID >= 80000 */
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
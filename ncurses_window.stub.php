@@ -0,0 +1,89 @@
+<?php
+
+/** @generate-class-entries */
+
+/** @strict-properties */
+final class NcursesWindow
+{
+	public function __construct(int $rows, int $cols, int $y = 0, int $x = 0) {}
+
+	public function addch(int $ch): int {}
+
+	public function addstr(string $text): int {}
+
+	public function mvaddstr(int $y, int $x, string $text): int {}
+
+	public function move(int $y, int $x): int {}
+
+	public function refresh(): int {}
+
+	public function noutrefresh(): int {}
+
+	public function clear(): int {}
+
+	public function erase(): int {}
+
+	public function border(int $left = 0, int $right = 0, int $top = 0, int $bottom = 0, int $tl_corner = 0, int $tr_corner = 0, int $bl_corner = 0, int $br_corner = 0): int {}
+
+	public function hline(int $ch, int $n): int {}
+
+	public function vline(int $ch, int $n): int {}
+
+	public function attron(int $attrs): int {}
+
+	public function attroff(int $attrs): int {}
+
+	public function attrset(int $attrs): int {}
+
+	public function bkgd(int $ch): int {}
+
+	public function getch(): int {}
+
+	public function keypad(bool $enable): int {}
+
+	public function scrollok(bool $enable): int {}
+
+	public function scrl(int $n): int {}
+
+	public function setscrreg(int $top, int $bottom): int {}
+
+	public function getyx(): array {}
+
+	public function getmaxyx(): array {}
+
+	public function prefresh(int $pminrow, int $pmincol, int $sminrow, int $smincol, int $smaxrow, int $smaxcol): int {}
+
+	public function pnoutrefresh(int $pminrow, int $pmincol, int $sminrow, int $smincol, int $smaxrow, int $smaxcol): int {}
+
+	public function delete(): void {}
+}
+
+#if HAVE_NCURSES_PANEL
+/** @strict-properties */
+final class NcursesPanel
+{
+	public function __construct(NcursesWindow $window) {}
+
+	public function show(): int {}
+
+	public function hide(): int {}
+
+	public function top(): int {}
+
+	public function bottom(): int {}
+
+	public function move(int $y, int $x): int {}
+
+	public function window(): NcursesWindow {}
+
+	public function replace(NcursesWindow $window): int {}
+
+	public function above(): ?NcursesPanel {}
+
+	public function below(): ?NcursesPanel {}
+
+	public function delete(): void {}
+}
+#endif
+
+?>
@@ -0,0 +1,285 @@
+/* This is a generated file, edit the .stub.php file instead.
+ * Stub hash: 1a4c9fa474e8162c55fc2795ee205ac763e40227 */
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_class_NcursesWindow___construct, 0, 0, 2)
+	ZEND_ARG_TYPE_INFO(0, rows, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, cols, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, y, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, x, IS_LONG, 0, "0")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesWindow_addch, 0, 1, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, ch, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesWindow_addstr, 0, 1, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, text, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesWindow_mvaddstr, 0, 3, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, y, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, x, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, text, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesWindow_move, 0, 2, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, y, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, x, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesWindow_refresh, 0, 0, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+#define arginfo_class_NcursesWindow_noutrefresh arginfo_class_NcursesWindow_refresh
+
+#define arginfo_class_NcursesWindow_clear arginfo_class_NcursesWindow_refresh
+
+#define arginfo_class_NcursesWindow_erase arginfo_class_NcursesWindow_refresh
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesWindow_border, 0, 0, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, left, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, right, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, top, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, bottom, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, tl_corner, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, tr_corner, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, bl_corner, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, br_corner, IS_LONG, 0, "0")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesWindow_hline, 0, 2, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, ch, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, n, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+#define arginfo_class_NcursesWindow_vline arginfo_class_NcursesWindow_hline
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesWindow_attron, 0, 1, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, attrs, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+#define arginfo_class_NcursesWindow_attroff arginfo_class_NcursesWindow_attron
+
+#define arginfo_class_NcursesWindow_attrset arginfo_class_NcursesWindow_attron
+
+#define arginfo_class_NcursesWindow_bkgd arginfo_class_NcursesWindow_addch
+
+#define arginfo_class_NcursesWindow_getch arginfo_class_NcursesWindow_refresh
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesWindow_keypad, 0, 1, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, enable, _IS_BOOL, 0)
+ZEND_END_ARG_INFO()
+
+#define arginfo_class_NcursesWindow_scrollok arginfo_class_NcursesWindow_keypad
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesWindow_scrl, 0, 1, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, n, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesWindow_setscrreg, 0, 2, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, top, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, bottom, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesWindow_getyx, 0, 0, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
+#define arginfo_class_NcursesWindow_getmaxyx arginfo_class_NcursesWindow_getyx
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesWindow_prefresh, 0, 6, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, pminrow, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, pmincol, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, sminrow, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, smincol, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, smaxrow, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, smaxcol, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+#define arginfo_class_NcursesWindow_pnoutrefresh arginfo_class_NcursesWindow_prefresh
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesWindow_delete, 0, 0, IS_VOID, 0)
+ZEND_END_ARG_INFO()
+
+#if HAVE_NCURSES_PANEL
+ZEND_BEGIN_ARG_INFO_EX(arginfo_class_NcursesPanel___construct, 0, 0, 1)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
+ZEND_END_ARG_INFO()
+#endif
+
+#if HAVE_NCURSES_PANEL
+#define arginfo_class_NcursesPanel_show arginfo_class_NcursesWindow_refresh
+#endif
+
+#if HAVE_NCURSES_PANEL
+#define arginfo_class_NcursesPanel_hide arginfo_class_NcursesWindow_refresh
+#endif
+
+#if HAVE_NCURSES_PANEL
+#define arginfo_class_NcursesPanel_top arginfo_class_NcursesWindow_refresh
+#endif
+
+#if HAVE_NCURSES_PANEL
+#define arginfo_class_NcursesPanel_bottom arginfo_class_NcursesWindow_refresh
+#endif
+
+#if HAVE_NCURSES_PANEL
+#define arginfo_class_NcursesPanel_move arginfo_class_NcursesWindow_move
+#endif
+
+#if HAVE_NCURSES_PANEL
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_class_NcursesPanel_window, 0, 0, NcursesWindow, 0)
+ZEND_END_ARG_INFO()
+#endif
+
+#if HAVE_NCURSES_PANEL
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_NcursesPanel_replace, 0, 1, IS_LONG, 0)
+	ZEND_ARG_OBJ_INFO(0, window, NcursesWindow, 0)
+ZEND_END_ARG_INFO()
+#endif
+
+#if HAVE_NCURSES_PANEL
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_class_NcursesPanel_above, 0, 0, NcursesPanel, 1)
+ZEND_END_ARG_INFO()
+#endif
+
+#if HAVE_NCURSES_PANEL
+#define arginfo_class_NcursesPanel_below arginfo_class_NcursesPanel_above
+#endif
+
+#if HAVE_NCURSES_PANEL
+#define arginfo_class_NcursesPanel_delete arginfo_class_NcursesWindow_delete
+#endif
+
+
+ZEND_METHOD(NcursesWindow, __construct);
+ZEND_METHOD(NcursesWindow, addch);
+ZEND_METHOD(NcursesWindow, addstr);
+ZEND_METHOD(NcursesWindow, mvaddstr);
+ZEND_METHOD(NcursesWindow, move);
+ZEND_METHOD(NcursesWindow, refresh);
+ZEND_METHOD(NcursesWindow, noutrefresh);
+ZEND_METHOD(NcursesWindow, clear);
+ZEND_METHOD(NcursesWindow, erase);
+ZEND_METHOD(NcursesWindow, border);
+ZEND_METHOD(NcursesWindow, hline);
+ZEND_METHOD(NcursesWindow, vline);
+ZEND_METHOD(NcursesWindow, attron);
+ZEND_METHOD(NcursesWindow, attroff);
+ZEND_METHOD(NcursesWindow, attrset);
+ZEND_METHOD(NcursesWindow, bkgd);
+ZEND_METHOD(NcursesWindow, getch);
+ZEND_METHOD(NcursesWindow, keypad);
+ZEND_METHOD(NcursesWindow, scrollok);
+ZEND_METHOD(NcursesWindow, scrl);
+ZEND_METHOD(NcursesWindow, setscrreg);
+ZEND_METHOD(NcursesWindow, getyx);
+ZEND_METHOD(NcursesWindow, getmaxyx);
+ZEND_METHOD(NcursesWindow, prefresh);
+ZEND_METHOD(NcursesWindow, pnoutrefresh);
+ZEND_METHOD(NcursesWindow, delete);
+#if HAVE_NCURSES_PANEL
+ZEND_METHOD(NcursesPanel, __construct);
+#endif
+#if HAVE_NCURSES_PANEL
+ZEND_METHOD(NcursesPanel, show);
+#endif
+#if HAVE_NCURSES_PANEL
+ZEND_METHOD(NcursesPanel, hide);
+#endif
+#if HAVE_NCURSES_PANEL
+ZEND_METHOD(NcursesPanel, top);
+#endif
+#if HAVE_NCURSES_PANEL
+ZEND_METHOD(NcursesPanel, bottom);
+#endif
+#if HAVE_NCURSES_PANEL
+ZEND_METHOD(NcursesPanel, move);
+#endif
+#if HAVE_NCURSES_PANEL
+ZEND_METHOD(NcursesPanel, window);
+#endif
+#if HAVE_NCURSES_PANEL
+ZEND_METHOD(NcursesPanel, replace);
+#endif
+#if HAVE_NCURSES_PANEL
+ZEND_METHOD(NcursesPanel, above);
+#endif
+#if HAVE_NCURSES_PANEL
+ZEND_METHOD(NcursesPanel, below);
+#endif
+#if HAVE_NCURSES_PANEL
+ZEND_METHOD(NcursesPanel, delete);
+#endif
+
+
+static const zend_function_entry class_NcursesWindow_methods[] = {
+	ZEND_ME(NcursesWindow, __construct, arginfo_class_NcursesWindow___construct, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, addch, arginfo_class_NcursesWindow_addch, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, addstr, arginfo_class_NcursesWindow_addstr, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, mvaddstr, arginfo_class_NcursesWindow_mvaddstr, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, move, arginfo_class_NcursesWindow_move, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, refresh, arginfo_class_NcursesWindow_refresh, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, noutrefresh, arginfo_class_NcursesWindow_noutrefresh, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, clear, arginfo_class_NcursesWindow_clear, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, erase, arginfo_class_NcursesWindow_erase, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, border, arginfo_class_NcursesWindow_border, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, hline, arginfo_class_NcursesWindow_hline, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, vline, arginfo_class_NcursesWindow_vline, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, attron, arginfo_class_NcursesWindow_attron, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, attroff, arginfo_class_NcursesWindow_attroff, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, attrset, arginfo_class_NcursesWindow_attrset, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, bkgd, arginfo_class_NcursesWindow_bkgd, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, getch, arginfo_class_NcursesWindow_getch, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, keypad, arginfo_class_NcursesWindow_keypad, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, scrollok, arginfo_class_NcursesWindow_scrollok, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, scrl, arginfo_class_NcursesWindow_scrl, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, setscrreg, arginfo_class_NcursesWindow_setscrreg, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, getyx, arginfo_class_NcursesWindow_getyx, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, getmaxyx, arginfo_class_NcursesWindow_getmaxyx, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, prefresh, arginfo_class_NcursesWindow_prefresh, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, pnoutrefresh, arginfo_class_NcursesWindow_pnoutrefresh, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesWindow, delete, arginfo_class_NcursesWindow_delete, ZEND_ACC_PUBLIC)
+	ZEND_FE_END
+};
+
+
+#if HAVE_NCURSES_PANEL
+static const zend_function_entry class_NcursesPanel_methods[] = {
+	ZEND_ME(NcursesPanel, __construct, arginfo_class_NcursesPanel___construct, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesPanel, show, arginfo_class_NcursesPanel_show, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesPanel, hide, arginfo_class_NcursesPanel_hide, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesPanel, top, arginfo_class_NcursesPanel_top, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesPanel, bottom, arginfo_class_NcursesPanel_bottom, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesPanel, move, arginfo_class_NcursesPanel_move, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesPanel, window, arginfo_class_NcursesPanel_window, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesPanel, replace, arginfo_class_NcursesPanel_replace, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesPanel, above, arginfo_class_NcursesPanel_above, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesPanel, below, arginfo_class_NcursesPanel_below, ZEND_ACC_PUBLIC)
+	ZEND_ME(NcursesPanel, delete, arginfo_class_NcursesPanel_delete, ZEND_ACC_PUBLIC)
+	ZEND_FE_END
+};
+#endif
+
+static zend_class_entry *register_class_NcursesWindow(void)
+{
+	zend_class_entry ce, *class_entry;
+
+	INIT_CLASS_ENTRY(ce, "NcursesWindow", class_NcursesWindow_methods);
+	class_entry = zend_register_internal_class_ex(&ce, NULL);
+	class_entry->ce_flags |= ZEND_ACC_FINAL|ZEND_ACC_NO_DYNAMIC_PROPERTIES;
+
+	return class_entry;
+}
+
+#if HAVE_NCURSES_PANEL
+static zend_class_entry *register_class_NcursesPanel(void)
+{
+	zend_class_entry ce, *class_entry;
+
+	INIT_CLASS_ENTRY(ce, "NcursesPanel", class_NcursesPanel_methods);
+	class_entry = zend_register_internal_class_ex(&ce, NULL);
+	class_entry->ce_flags |= ZEND_ACC_FINAL|ZEND_ACC_NO_DYNAMIC_PROPERTIES;
+
+	return class_entry;
+}
+#endif
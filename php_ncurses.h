@@ -21,6 +21,13 @@
 
 #define PHP_NCURSES_VERSION "1.0.2"
 
+#ifdef HAVE_NCURSESW
+# ifndef NCURSES_WIDECHAR
+#  define NCURSES_WIDECHAR 1
+# endif
+# include <wchar.h>
+#endif
+
 #ifdef HAVE_NCURSES_H
 # include <ncurses.h>
 #else
@@ -53,11 +60,78 @@ extern zend_function_entry ncurses_functions[];
 
 PHP_MINIT_FUNCTION(ncurses);
 PHP_MSHUTDOWN_FUNCTION(ncurses);
+PHP_RSHUTDOWN_FUNCTION(ncurses);
 PHP_MINFO_FUNCTION(ncurses);
 
+/* alignment of php_ncurses_waddfield() */
+enum {
+	PHP_NCURSES_ALIGN_LEFT,
+	PHP_NCURSES_ALIGN_RIGHT,
+	PHP_NCURSES_ALIGN_CENTER
+};
+
+/* {{{ php_ncurses_term
+ * The per screen state that lives in the globals while its screen is
+ * current and is parked here while ncurses_set_term() made another one
+ * current. */
+typedef struct _php_ncurses_term {
+	SCREEN *screen;
+	int     input_fd;
+	int     output_fd;
+	struct _php_ncurses_pairs   *pairs;
+	struct _php_ncurses_palette *palette;
+} php_ncurses_term;
+/* }}} */
+
+/* constants that only have a value once curses is initialized, in the
+   order of the ACS table in the terminfo cache */
+#define PHP_NCURSES_ACS_LIST(X) \
+	X(ACS_ULCORNER) X(ACS_LLCORNER) X(ACS_URCORNER) X(ACS_LRCORNER) \
+	X(ACS_LTEE) X(ACS_RTEE) X(ACS_BTEE) X(ACS_TTEE) \
+	X(ACS_HLINE) X(ACS_VLINE) X(ACS_PLUS) X(ACS_S1) X(ACS_S9) \
+	X(ACS_DIAMOND) X(ACS_CKBOARD) X(ACS_DEGREE) X(ACS_PLMINUS) X(ACS_BULLET) \
+	X(ACS_LARROW) X(ACS_RARROW) X(ACS_DARROW) X(ACS_UARROW) \
+	X(ACS_BOARD) X(ACS_LANTERN) X(ACS_BLOCK)
+#define PHP_NCURSES_ACS_COUNT 25
+
+/* longest SGR mouse report, ESC [ < b ; x ; y M */
+#define PHP_NCURSES_UNREAD_MAX 32
+
 ZEND_BEGIN_MODULE_GLOBALS(ncurses)
 	int	  registered_constants;
 	int   module_number;
+	int   frame_depth;      /* nesting level of ncurses_frame_begin() */
+	int   frame_dirty;      /* virtual screen changed since the last doupdate() */
+	long  max_fps;          /* 0 means unlimited */
+	double last_update;     /* time of the last doupdate() sent by ncurses_frame_end() */
+	zend_bool stats;        /* ncurses.stats */
+	int   stats_io_fd;      /* /proc/self/io, -1 if the written bytes can not be counted */
+	long  stats_bytes;
+	long  stats_excluded;   /* written by the recorder besides the terminal output */
+	long  stats_updates;
+	double stats_update_time;
+	HashTable *stats_calls; /* calls and bytes per function, PHP 7+ */
+	int   input_fd;         /* descriptor curses reads keys from */
+	int   output_fd;        /* descriptor curses writes to */
+	struct _php_ncurses_vt *headless; /* terminal emulator of ncurses_headless_init() */
+	struct _php_ncurses_pairs *pairs; /* allocator of ncurses_color_pair_for() */
+	struct _php_ncurses_palette *palette; /* quantizer of ncurses_rgb_to_color() */
+	HashTable *window_panels; /* WINDOW * -> panel resource, PHP 7 */
+	php_ncurses_term main_term; /* screen of ncurses_init() or ncurses_headless_init() */
+	struct _zend_object *screen; /* current NcursesScreen, NULL for main_term, PHP 8 */
+#if PHP_MAJOR_VERSION >= 7
+	zval  input_waiter;     /* callable of ncurses_set_input_waiter() */
+#endif
+	struct _php_ncurses_recorder *recorder; /* ncurses_record_start() */
+	struct _php_ncurses_inject *inject; /* events of ncurses_inject() */
+	zend_bool mouse_sgr;    /* ncurses_mouse_sgr(), SGR reports are decoded */
+	zend_bool mouse_pending; /* mouse_event was decoded and not fetched yet */
+	MEVENT mouse_event;
+	int   unread[PHP_NCURSES_UNREAD_MAX]; /* keys the SGR decoder read too many, last first */
+	int   unread_len;
+	char *terminfo_cache;   /* ncurses.terminfo_cache */
+	zend_bool lazy;         /* ncurses_init(true) has not started curses yet */
+	void *lazy_stdscr;      /* STDSCR object or resource waiting for stdscr */
 ZEND_END_MODULE_GLOBALS(ncurses)
 
 /* In every function that needs to use variables in php_ncurses_globals,
@@ -78,10 +152,371 @@ ZEND_END_MODULE_GLOBALS(ncurses)
 ZEND_EXTERN_MODULE_GLOBALS(ncurses)
 
 #if PHP_VERSION_ID >= 80000
+#define TSRMLS_D
+#define TSRMLS_C
 #define TSRMLS_DC
 #define TSRMLS_CC
 #endif
 
+/* zpp spec of a window/panel argument, an object on PHP 8 and a resource before */
+#if PHP_VERSION_ID >= 80000
+# define PHP_NCURSES_WIN   "o"
+# define PHP_NCURSES_PANEL "o"
+#else
+# define PHP_NCURSES_WIN   "r"
+# define PHP_NCURSES_PANEL "r"
+#endif
+
+#if PHP_VERSION_ID >= 80000
+#define FETCH_WINRES(r, z) \
+	if (NULL == ((r) = php_ncurses_window_fetch(*(z)))) { \
+		RETURN_THROWS(); \
+	}
+#if HAVE_NCURSES_PANEL
+# define FETCH_PANEL(r, z) \
+	if (NULL == ((r) = php_ncurses_panel_fetch(*(z)))) { \
+		RETURN_THROWS(); \
+	}
+#endif
+#elif PHP_MAJOR_VERSION >= 7
+#define FETCH_WINRES(r, z) \
+	if (NULL == ((r) = (WINDOW *)zend_fetch_resource(Z_RES_P(*(z)), "ncurses_window", le_ncurses_windows)) && \
+		NULL == ((r) = php_ncurses_lazy_window(Z_RES_P(*(z))))) { \
+		RETURN_FALSE; \
+	}
+#if HAVE_NCURSES_PANEL
+# define FETCH_PANEL(r, z) \
+	if (NULL == ((r) = (PANEL *)zend_fetch_resource(Z_RES_P(*(z)), "ncurses_panel", le_ncurses_panels))) { \
+		RETURN_FALSE; \
+	}
+#endif
+#else
+#define FETCH_WINRES(r, z)  ZEND_FETCH_RESOURCE(r, WINDOW *, z, -1, "ncurses_window", le_ncurses_windows)
+#if HAVE_NCURSES_PANEL
+# define FETCH_PANEL(r, z)  ZEND_FETCH_RESOURCE(r, PANEL *, z, -1, "ncurses_panel", le_ncurses_panels)
+#endif
+#define Z_RES_P  Z_LVAL_P
+typedef long zend_long;
+#endif
+
+PHP_NCURSES_API double php_ncurses_now(void);
+PHP_NCURSES_API int php_ncurses_start(TSRMLS_D);
+#if PHP_MAJOR_VERSION >= 7
+PHP_NCURSES_API void *php_ncurses_register_stdscr(WINDOW *win);
+#endif
+PHP_NCURSES_API void php_ncurses_setup_screen(TSRMLS_D);
+PHP_NCURSES_API int php_ncurses_input_fd(void);
+PHP_NCURSES_API void php_ncurses_setup_locale(int force_utf8);
+PHP_NCURSES_API size_t php_ncurses_utf8_decode(const unsigned char *s, size_t len, uint32_t *cp);
+PHP_NCURSES_API int php_ncurses_waddnstr(WINDOW *win, const char *str, size_t len, zend_long n);
+PHP_NCURSES_API int php_ncurses_winsnstr(WINDOW *win, const char *str, size_t len);
+PHP_NCURSES_API int php_ncurses_display_width(const char *str, size_t len, int max, size_t *bytes);
+PHP_NCURSES_API void php_ncurses_waddfield(WINDOW *win, const char *str, size_t len, int width, int align);
+PHP_NCURSES_API void php_ncurses_frame_touch(void);
+PHP_NCURSES_API int php_ncurses_wrefresh(WINDOW *win);
+PHP_NCURSES_API int php_ncurses_wnoutrefresh(WINDOW *win);
+PHP_NCURSES_API int php_ncurses_prefresh(WINDOW *pad, int pminrow, int pmincol, int sminrow, int smincol, int smaxrow, int smaxcol);
+PHP_NCURSES_API int php_ncurses_doupdate(void);
+
+PHP_MINIT_FUNCTION(ncurses_stats);
+PHP_MSHUTDOWN_FUNCTION(ncurses_stats);
+PHP_NCURSES_API void php_ncurses_stats_open(void);
+PHP_NCURSES_API void php_ncurses_stats_update(double start);
+PHP_NCURSES_API void php_ncurses_stats_info(void);
+
+PHP_NCURSES_API void php_ncurses_headless_pump(void);
+PHP_NCURSES_API void php_ncurses_headless_shutdown(void);
+PHP_NCURSES_API void php_ncurses_headless_feed(const char *buf, size_t len);
+
+PHP_NCURSES_API int php_ncurses_record_begin(void);
+PHP_NCURSES_API void php_ncurses_record_end(int saved_fd);
+PHP_NCURSES_API void php_ncurses_record_shutdown(void);
+
+PHP_NCURSES_API int php_ncurses_wgetch(WINDOW *win);
+PHP_NCURSES_API void php_ncurses_inject_pump(WINDOW *win);
+PHP_NCURSES_API void php_ncurses_inject_reset(void);
+#if PHP_MAJOR_VERSION >= 7
+PHP_NCURSES_API int php_ncurses_mevent_field(MEVENT *mevent, zend_string *name, zval *val);
+#endif
+PHP_NCURSES_API int php_ncurses_mouse_read_sgr(WINDOW *win);
+PHP_NCURSES_API int php_ncurses_getmouse(MEVENT *mevent);
+
+PHP_NCURSES_API char *php_ncurses_terminfo_begin(const char *term, zend_bool *active);
+PHP_NCURSES_API void php_ncurses_terminfo_end(char *saved, zend_bool active);
+PHP_NCURSES_API void php_ncurses_acs_store(const char *term);
+PHP_NCURSES_API int php_ncurses_lazy_register(const char *term);
+PHP_NCURSES_API int php_ncurses_lazy_start(void);
+PHP_NCURSES_API WINDOW *php_ncurses_lazy_window(void *handle);
+PHP_NCURSES_API void php_ncurses_lazy_resolve(void);
+
+PHP_NCURSES_API int php_ncurses_pair_for(int fg, int bg);
+PHP_NCURSES_API void php_ncurses_pairs_forget(int pair);
+PHP_NCURSES_API void php_ncurses_pairs_reset(void);
+PHP_NCURSES_API void php_ncurses_palette_set(int color, int r, int g, int b);
+PHP_NCURSES_API void php_ncurses_palette_reset(void);
+
+#define IS_NCURSES_INITIALIZED() \
+		if (!NCURSES_G(registered_constants)) { \
+			php_error_docref(NULL TSRMLS_CC, E_WARNING, "You must initialize ncurses via ncurses_init(), before calling any ncurses functions."); \
+			RETURN_FALSE; \
+		} \
+		if (NCURSES_G(lazy) && php_ncurses_lazy_start() == FAILURE) { \
+			RETURN_FALSE; \
+		}
+
+#if HAVE_NCURSES_PANEL && PHP_MAJOR_VERSION == 7
+/* {{{ panel resources
+ *
+ * The user pointer of a PANEL holds the resource of the panel and the
+ * window resource it shows. The panel keeps that window alive, so delwin()
+ * only runs once the panel is gone; window_panels maps the window back. */
+typedef struct _php_ncurses_panel_res {
+	zend_resource *panel;
+	zval           window;
+} php_ncurses_panel_res;
+
+PHP_NCURSES_API void php_ncurses_window_panel_set(WINDOW *win, zend_resource *panel);
+PHP_NCURSES_API void php_ncurses_window_panel_del(WINDOW *win, zend_resource *panel);
+/* }}} */
+#endif
+
+#if PHP_VERSION_ID >= 80000
+#include "zend_smart_str.h"
+
+/* {{{ NcursesWindow, NcursesPanel
+ *
+ * The objects own the curses structure directly. win/panel is NULL once
+ * delete() was called; stdscr is wrapped with owned = 0 so that it is never
+ * passed to delwin(). A panel keeps a reference to its window object, which
+ * therefore always outlives it; the window points back to the panel without
+ * holding a reference. A window created while an NcursesScreen is current
+ * holds a reference to that screen, as delscreen() frees its windows. */
+typedef struct _php_ncurses_window {
+	WINDOW      *win;
+	zend_bool    owned;
+	zend_object *panel;
+	zend_object *screen;
+	zend_object  std;
+} php_ncurses_window;
+
+extern PHP_NCURSES_API zend_class_entry *php_ncurses_window_ce;
+
+static inline php_ncurses_window *php_ncurses_window_from_obj(zend_object *obj)
+{
+	return (php_ncurses_window *)((char *)obj - XtOffsetOf(php_ncurses_window, std));
+}
+
+PHP_NCURSES_API void php_ncurses_window_wrap(zval *zv, WINDOW *win, zend_bool owned);
+PHP_NCURSES_API WINDOW *php_ncurses_window_fetch(zval *zv);
+PHP_NCURSES_API void php_ncurses_window_delete(php_ncurses_window *obj);
+
+#if HAVE_NCURSES_PANEL
+typedef struct _php_ncurses_panel {
+	PANEL       *panel;
+	zval         window;
+	zend_object  std;
+} php_ncurses_panel;
+
+extern PHP_NCURSES_API zend_class_entry *php_ncurses_panel_ce;
+
+static inline php_ncurses_panel *php_ncurses_panel_from_obj(zend_object *obj)
+{
+	return (php_ncurses_panel *)((char *)obj - XtOffsetOf(php_ncurses_panel, std));
+}
+
+PHP_NCURSES_API void php_ncurses_panel_wrap(zval *zv, PANEL *panel, zval *window);
+PHP_NCURSES_API PANEL *php_ncurses_panel_fetch(zval *zv);
+PHP_NCURSES_API int php_ncurses_panel_replace(php_ncurses_panel *obj, zval *window);
+PHP_NCURSES_API void php_ncurses_panel_delete(php_ncurses_panel *obj);
+#endif
+
+PHP_MINIT_FUNCTION(ncurses_window);
+/* }}} */
+
+/* {{{ NcursesCellBuffer
+ *
+ * Cells are stored row-major, one per screen column, packed into 8 bytes
+ * in native byte order:
+ *
+ *   uint32_t ch    character code point (byte value on narrow builds)
+ *   uint16_t attr  A_* attribute bits, shifted down by PHP_NCURSES_CELL_ATTR_SHIFT
+ *   uint16_t pair  color pair number
+ *
+ * NcursesCellBuffer::export() and NcursesCellBuffer::import() use exactly
+ * this layout, so a buffer can be built outside of PHP and blitted as is. */
+#define PHP_NCURSES_CELL_ATTR_SHIFT 16
+
+typedef struct _php_ncurses_cell {
+	uint32_t ch;
+	uint16_t attr;
+	uint16_t pair;
+} php_ncurses_cell;
+
+/* {{{ php_ncurses_cell_set
+   Packs a code point, attributes and color pair into a cell */
+static zend_always_inline void php_ncurses_cell_set(php_ncurses_cell *cell, uint32_t cp, zend_long attr, zend_long pair)
+{
+	if (!pair) {
+		pair = PAIR_NUMBER(attr);
+	}
+
+	cell->ch = cp;
+	cell->attr = (uint16_t)(((attr_t)attr & A_ATTRIBUTES & ~A_COLOR) >> PHP_NCURSES_CELL_ATTR_SHIFT);
+	cell->pair = (uint16_t)pair;
+}
+/* }}} */
+
+/* {{{ php_ncurses_cell_set_chtype
+   Packs a chtype such as ord('a') | NCURSES_A_UNDERLINE or NCURSES_ACS_HLINE
+   into a cell, its attributes and pair add to the ones given */
+static zend_always_inline void php_ncurses_cell_set_chtype(php_ncurses_cell *cell, chtype ch, zend_long attr, zend_long pair)
+{
+	php_ncurses_cell_set(cell, (uint32_t)(ch & A_CHARTEXT), attr | (zend_long)(ch & A_ATTRIBUTES), pair);
+}
+/* }}} */
+
+/* cells written per mvwaddchnstr() call by php_ncurses_cells_put() */
+#define PHP_NCURSES_CELLS_CHUNK 256
+
+PHP_NCURSES_API void php_ncurses_cell_set_zval(php_ncurses_cell *cell, zval *zch, zend_long attr, zend_long pair);
+PHP_NCURSES_API void php_ncurses_cells_put(WINDOW *win, int y, int x, const php_ncurses_cell *cell, int n);
+
+typedef struct _php_ncurses_cellbuffer {
+	int               rows;
+	int               cols;
+	php_ncurses_cell *cells;
+	zend_object       std;
+} php_ncurses_cellbuffer;
+
+extern PHP_NCURSES_API zend_class_entry *php_ncurses_cellbuffer_ce;
+
+static inline php_ncurses_cellbuffer *php_ncurses_cellbuffer_from_obj(zend_object *obj)
+{
+	return (php_ncurses_cellbuffer *)((char *)obj - XtOffsetOf(php_ncurses_cellbuffer, std));
+}
+
+PHP_MINIT_FUNCTION(ncurses_cellbuffer);
+/* }}} */
+
+/* {{{ NcursesListView
+ *
+ * rows caches what the provider returned for rows_offset, rows_count rows
+ * and is dropped as soon as the view scrolls. An array provider is read
+ * directly and never copied. */
+typedef struct _php_ncurses_listview {
+	zval         window;
+	zval         provider;
+	zval         rows;
+	zend_long    count;
+	zend_long    selected;
+	zend_long    offset;
+	zend_long    rows_offset;
+	int          rows_count;
+	attr_t       selected_attr;
+	zend_object  std;
+} php_ncurses_listview;
+
+extern PHP_NCURSES_API zend_class_entry *php_ncurses_listview_ce;
+
+static inline php_ncurses_listview *php_ncurses_listview_from_obj(zend_object *obj)
+{
+	return (php_ncurses_listview *)((char *)obj - XtOffsetOf(php_ncurses_listview, std));
+}
+
+PHP_MINIT_FUNCTION(ncurses_listview);
+/* }}} */
+
+/* {{{ NcursesLogTail
+ *
+ * lines is a ring of capacity entries starting at head, oldest first.
+ * partial collects a line until its newline arrives. */
+typedef struct _php_ncurses_logtail {
+	zval          window;
+	zval          stream;
+	zend_string **lines;
+	zend_long     capacity;
+	zend_long     head;
+	zend_long     count;
+	zend_string  *filter;
+	smart_str     partial;
+	int           dirty;
+	zend_object   std;
+} php_ncurses_logtail;
+
+extern PHP_NCURSES_API zend_class_entry *php_ncurses_logtail_ce;
+
+static inline php_ncurses_logtail *php_ncurses_logtail_from_obj(zend_object *obj)
+{
+	return (php_ncurses_logtail *)((char *)obj - XtOffsetOf(php_ncurses_logtail, std));
+}
+
+PHP_MINIT_FUNCTION(ncurses_logtail);
+/* }}} */
+
+/* {{{ NcursesScene
+ *
+ * front holds the cells of the last frame as they were written to the
+ * window, back the frame being drawn; the two are swapped after every
+ * render(). valid is cleared when the window has to be written in full. */
+typedef struct _php_ncurses_scene {
+	zval              window;
+	int               rows;
+	int               cols;
+	php_ncurses_cell *front;
+	php_ncurses_cell *back;
+	int               valid;
+	zend_object       std;
+} php_ncurses_scene;
+
+extern PHP_NCURSES_API zend_class_entry *php_ncurses_scene_ce;
+
+static inline php_ncurses_scene *php_ncurses_scene_from_obj(zend_object *obj)
+{
+	return (php_ncurses_scene *)((char *)obj - XtOffsetOf(php_ncurses_scene, std));
+}
+
+PHP_MINIT_FUNCTION(ncurses_scene);
+/* }}} */
+
+/* {{{ NcursesScreen
+ *
+ * A terminal started by ncurses_newterm(). out and in are stdio streams on
+ * duplicates of the descriptors it was given, so closing the PHP streams
+ * does not pull them away from curses. term is only valid while another
+ * screen is current. */
+typedef struct _php_ncurses_screen {
+	php_ncurses_term term;
+	FILE            *out;
+	FILE            *in;
+	zend_object      std;
+} php_ncurses_screen;
+
+extern PHP_NCURSES_API zend_class_entry *php_ncurses_screen_ce;
+
+static inline php_ncurses_screen *php_ncurses_screen_from_obj(zend_object *obj)
+{
+	return (php_ncurses_screen *)((char *)obj - XtOffsetOf(php_ncurses_screen, std));
+}
+
+PHP_NCURSES_API void php_ncurses_screen_main(void);
+
+PHP_MINIT_FUNCTION(ncurses_screen);
+/* }}} */
+
+/* {{{ NcursesMouseEvent
+ *
+ * A plain object with the int properties id, x, y, z and mmask, in this
+ * order of the property table. */
+#define PHP_NCURSES_MOUSE_EVENT_PROPS 5
+
+extern PHP_NCURSES_API zend_class_entry *php_ncurses_mouse_event_ce;
+
+PHP_NCURSES_API void php_ncurses_mouse_event_fill(zend_object *obj, MEVENT *mevent);
+
+PHP_MINIT_FUNCTION(ncurses_mouse);
+/* }}} */
+#endif
+
 #endif  /* PHP_NCURSES_H */
 
 
@@ -190,6 +190,68 @@ PHP_FUNCTION(ncurses_del_panel);
 PHP_FUNCTION(ncurses_new_panel);
 #endif
 
+PHP_FUNCTION(ncurses_frame_begin);
+PHP_FUNCTION(ncurses_frame_end);
+PHP_FUNCTION(ncurses_set_max_fps);
+
+PHP_FUNCTION(ncurses_input_stream);
+PHP_FUNCTION(ncurses_drain_keys);
+PHP_FUNCTION(ncurses_wgetch_batch);
+
+PHP_FUNCTION(ncurses_stats);
+
+PHP_FUNCTION(ncurses_headless_init);
+PHP_FUNCTION(ncurses_headless_screen);
+PHP_FUNCTION(ncurses_headless_output);
+
+#ifndef HAVE_PDCURSESLIB
+PHP_FUNCTION(ncurses_scr_dump_string);
+PHP_FUNCTION(ncurses_scr_restore_string);
+PHP_FUNCTION(ncurses_scr_init_string);
+PHP_FUNCTION(ncurses_scr_set_string);
+#endif
+PHP_FUNCTION(ncurses_putwin);
+PHP_FUNCTION(ncurses_getwin);
+PHP_FUNCTION(ncurses_wrestore);
+
+PHP_FUNCTION(ncurses_wdraw_table);
+
+PHP_FUNCTION(ncurses_color_pair_for);
+#if PHP_MAJOR_VERSION >= 7
+PHP_FUNCTION(ncurses_rgb_to_color);
+#endif
+
+PHP_FUNCTION(ncurses_touchwin);
+PHP_FUNCTION(ncurses_untouchwin);
+PHP_FUNCTION(ncurses_wtouchln);
+PHP_FUNCTION(ncurses_is_linetouched);
+PHP_FUNCTION(ncurses_is_wintouched);
+PHP_FUNCTION(ncurses_wredrawln);
+PHP_FUNCTION(ncurses_wdirty_lines);
+
+#if HAVE_NCURSES_PANEL && PHP_MAJOR_VERSION >= 7
+PHP_FUNCTION(ncurses_panels_apply);
+PHP_FUNCTION(ncurses_window_panel);
+PHP_FUNCTION(ncurses_panel_stack);
+#endif
+
+#if PHP_VERSION_ID >= 80000
+PHP_FUNCTION(ncurses_newterm);
+PHP_FUNCTION(ncurses_set_term);
+#endif
+
+#if PHP_MAJOR_VERSION >= 7
+PHP_FUNCTION(ncurses_set_input_waiter);
+PHP_FUNCTION(ncurses_getch_async);
+
+PHP_FUNCTION(ncurses_record_start);
+PHP_FUNCTION(ncurses_record_stop);
+PHP_FUNCTION(ncurses_replay);
+PHP_FUNCTION(ncurses_inject);
+#endif
+
+PHP_FUNCTION(ncurses_mouse_sgr);
+
 
 #endif
 
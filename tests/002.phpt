@@ -0,0 +1,42 @@
+--TEST--
+NcursesCellBuffer set, fill, write and packed export
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !class_exists("NcursesCellBuffer")) print "skip"; ?>
+--FILE--
+<?php
+$buf = new NcursesCellBuffer(2, 4);
+var_dump($buf->getRows(), $buf->getCols());
+
+var_dump($buf->set(0, 0, "A", NCURSES_A_BOLD, 3));
+var_dump($buf->set(5, 0, "A"));
+var_dump($buf->get(0, 0) == array("ch" => 65, "attr" => NCURSES_A_BOLD, "pair" => 3));
+
+var_dump($buf->fill(1, 1, -1, "-"));
+var_dump($buf->write(0, 2, "\xc3\xa9tude"));
+var_dump($buf->get(0, 2)["ch"] == 0xe9);
+
+var_dump(strlen($buf->export()));
+var_dump($buf->import("short"));
+
+$copy = clone $buf;
+$copy->clear();
+var_dump($copy->get(1, 1)["ch"], $buf->get(1, 1)["ch"]);
+var_dump($copy->import($buf->export()), $copy->get(1, 1)["ch"]);
+?>
+--EXPECTF--
+int(2)
+int(4)
+bool(true)
+bool(false)
+bool(true)
+int(3)
+int(2)
+bool(true)
+int(64)
+
+Warning: NcursesCellBuffer::import(): Expected 64 bytes of cell data, 5 given in %s on line %d
+bool(false)
+int(32)
+int(45)
+bool(true)
+int(45)
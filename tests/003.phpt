@@ -0,0 +1,18 @@
+--TEST--
+NcursesWindow is final and refuses to work before ncurses_init()
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !class_exists("NcursesWindow")) print "skip"; ?>
+--FILE--
+<?php
+$rc = new ReflectionClass("NcursesWindow");
+var_dump($rc->isFinal());
+
+try {
+	new NcursesWindow(10, 10);
+} catch (Error $e) {
+	echo $e->getMessage(), "\n";
+}
+?>
+--EXPECT--
+bool(true)
+You must initialize ncurses via ncurses_init(), before calling any ncurses functions.
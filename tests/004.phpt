@@ -0,0 +1,30 @@
+--TEST--
+ncurses_stats() counts calls per function when ncurses.stats is enabled
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || PHP_MAJOR_VERSION < 7) print "skip"; ?>
+--INI--
+ncurses.stats=1
+--FILE--
+<?php
+$stats = ncurses_stats();
+var_dump($stats["enabled"], $stats["bytes_written"], $stats["updates"], $stats["functions"]);
+
+$stats = ncurses_stats(true);
+var_dump($stats["functions"]["ncurses_stats"]);
+
+$stats = ncurses_stats();
+var_dump($stats["functions"]["ncurses_stats"]["calls"]);
+?>
+--EXPECT--
+bool(true)
+NULL
+int(0)
+array(0) {
+}
+array(2) {
+  ["calls"]=>
+  int(1)
+  ["bytes"]=>
+  int(0)
+}
+int(1)
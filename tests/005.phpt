@@ -0,0 +1,39 @@
+--TEST--
+ncurses_headless_init() renders into an emulated terminal
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+var_dump(ncurses_headless_init(5, 20));
+
+ncurses_border(0, 0, 0, 0, 0, 0, 0, 0);
+ncurses_mvaddstr(1, 2, "Hello");
+ncurses_attron(NCURSES_A_BOLD);
+ncurses_mvaddstr(2, 2, "bold");
+ncurses_attroff(NCURSES_A_BOLD);
+ncurses_refresh(0);
+
+foreach (ncurses_headless_screen() as $row) {
+	echo rtrim($row), "\n";
+}
+
+$cells = ncurses_headless_screen(true);
+var_dump($cells[2][2]["ch"], $cells[2][2]["attr"] == NCURSES_A_BOLD, $cells[1][2]["attr"]);
+
+var_dump(strlen(ncurses_headless_output()) > 0);
+var_dump(ncurses_headless_output());
+
+ncurses_end();
+?>
+--EXPECT--
+bool(true)
+┌──────────────────┐
+│ Hello            │
+│ bold             │
+│                  │
+└──────────────────┘
+string(1) "b"
+bool(true)
+int(0)
+bool(true)
+string(0) ""
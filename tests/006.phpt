@@ -0,0 +1,47 @@
+--TEST--
+ncurses_scr_dump_string() and ncurses_putwin() snapshots restore without files
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_headless_init") || !function_exists("ncurses_scr_dump_string")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(3, 12);
+
+ncurses_mvaddstr(1, 1, "background");
+ncurses_refresh(0);
+$dump = ncurses_scr_dump_string();
+var_dump(is_string($dump) && strlen($dump) > 0);
+
+ncurses_erase();
+ncurses_mvaddstr(0, 0, "modal");
+ncurses_refresh(0);
+$screen = ncurses_headless_screen();
+echo rtrim($screen[0]), "|", rtrim($screen[1]), "\n";
+
+var_dump(ncurses_scr_restore_string($dump));
+ncurses_doupdate();
+$screen = ncurses_headless_screen();
+echo rtrim($screen[0]), "|", rtrim($screen[1]), "\n";
+
+$win = ncurses_newwin(2, 6, 0, 0);
+ncurses_mvwaddstr($win, 1, 1, "saved");
+$saved = ncurses_putwin($win);
+ncurses_werase($win);
+var_dump(ncurses_wrestore($win, $saved));
+
+$copy = ncurses_getwin($saved);
+var_dump($copy !== false);
+
+var_dump(ncurses_scr_restore_string("garbage"));
+var_dump(ncurses_getwin(""));
+
+ncurses_end();
+?>
+--EXPECT--
+bool(true)
+modal|
+int(0)
+| background
+int(0)
+bool(true)
+int(-1)
+bool(false)
@@ -0,0 +1,33 @@
+--TEST--
+add*str functions use the string length and write UTF-8 as wide characters
+--SKIPIF--
+<?php
+if (!extension_loaded("ncurses") || !function_exists("ncurses_headless_init")) print "skip";
+ob_start();
+(new ReflectionExtension("ncurses"))->info();
+if (!preg_match('/wide character support => yes/', ob_get_clean())) print "skip no wide character support";
+?>
+--FILE--
+<?php
+ncurses_headless_init(4, 20);
+
+ncurses_mvaddstr(0, 0, "ab\0cd");
+ncurses_mvaddstr(1, 0, "héllo 中文!");
+ncurses_mvaddnstr(2, 0, "ééé xyz", 4);
+$win = ncurses_newwin(1, 20, 3, 0);
+ncurses_mvwaddstr($win, 0, 0, "Ærøskøbing");
+ncurses_wnoutrefresh($win);
+ncurses_refresh(0);
+ncurses_wrefresh($win);
+
+foreach (ncurses_headless_screen() as $row) {
+	echo rtrim($row), "\n";
+}
+
+ncurses_end();
+?>
+--EXPECT--
+ab^@cd
+héllo 中文!
+ééé
+Ærøskøbing
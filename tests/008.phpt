@@ -0,0 +1,50 @@
+--TEST--
+ncurses_wdraw_table() sizes, truncates and aligns columns
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_headless_init") || !function_exists("ncurses_wdraw_table")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(6, 20);
+$win = ncurses_newwin(6, 20, 0, 0);
+
+$rows = array(
+	array("host" => "alpha", "ms" => 12),
+	array("host" => "beta", "ms" => 3),
+	array("host" => "gamma-long-name", "ms" => 250),
+);
+$columns = array(
+	array("key" => "host", "title" => "Host"),
+	array("key" => "ms", "title" => "ms", "align" => "right"),
+);
+
+var_dump(ncurses_wdraw_table($win, $rows, $columns, array("selected" => 1)));
+ncurses_wrefresh($win);
+
+$screen = ncurses_headless_screen();
+foreach ($screen as $row) {
+	echo rtrim($row), "\n";
+}
+$cells = ncurses_headless_screen(true);
+var_dump($cells[3][0]["attr"] == NCURSES_A_REVERSE, $cells[2][0]["attr"] == NCURSES_A_NORMAL);
+
+/* the selected row is scrolled into a three line table */
+var_dump(ncurses_wdraw_table($win, $rows, $columns, array("height" => 3, "selected" => 2)));
+
+var_dump(ncurses_wdraw_table($win, $rows, array(array("align" => "middle"))));
+
+ncurses_end();
+?>
+--EXPECTF--
+int(0)
+Host           │  ms
+───────────────┼────
+alpha          │  12
+beta           │   3
+gamma-long-nam │ 250
+
+bool(true)
+bool(true)
+int(2)
+
+Warning: ncurses_wdraw_table(): Column 0 has an unknown alignment 'middle' in %s on line %d
+bool(false)
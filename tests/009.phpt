@@ -0,0 +1,63 @@
+--TEST--
+NcursesListView asks the provider only for the rows in view
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !class_exists("NcursesListView") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(3, 12);
+$win = new NcursesWindow(3, 12, 0, 0);
+
+$calls = array();
+$list = new NcursesListView($win, 1000000, function ($offset, $length) use (&$calls) {
+	$calls[] = "$offset+$length";
+	$rows = array();
+	for ($i = 0; $i < $length; $i++) {
+		$rows[] = "row " . ($offset + $i);
+	}
+	return $rows;
+});
+
+var_dump($list->render());
+$list->render();
+var_dump($list->handleKey(NCURSES_KEY_DOWN), $list->handleKey(NCURSES_KEY_DOWN), $list->handleKey(NCURSES_KEY_DOWN));
+var_dump($list->getSelected(), $list->getOffset());
+$list->render();
+var_dump($list->handleKey(NCURSES_KEY_END), $list->getSelected(), $list->getOffset());
+$list->render();
+$win->refresh();
+var_dump($list->handleKey(ord("q")));
+echo implode(",", $calls), "\n";
+
+foreach (ncurses_headless_screen() as $row) {
+	echo rtrim($row), "\n";
+}
+
+$array = new NcursesListView($win, 2, array("first", "second"));
+var_dump($array->render());
+
+try {
+	$bad = new NcursesListView($win, 5, fn() => "nope");
+	$bad->render();
+} catch (TypeError $e) {
+	echo $e->getMessage(), "\n";
+}
+
+ncurses_end();
+?>
+--EXPECT--
+int(3)
+bool(true)
+bool(true)
+bool(true)
+int(3)
+int(1)
+bool(true)
+int(999999)
+int(999997)
+bool(false)
+0+3,1+3,999997+3
+row 999997
+row 999998
+row 999999
+int(2)
+NcursesListView row provider must return an array, string returned
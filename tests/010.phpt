@@ -0,0 +1,56 @@
+--TEST--
+NcursesLogTail keeps the newest lines of a stream and draws the last screenful
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !class_exists("NcursesLogTail") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(3, 12);
+$win = new NcursesWindow(3, 12, 0, 0);
+
+$fp = fopen("php://temp", "w+");
+$tail = new NcursesLogTail($win, $fp, 4);
+
+fwrite($fp, "one\ntwo\r\nthr");
+rewind($fp);
+var_dump($tail->pump());
+fwrite($fp, "ee\nfour\nfive\nsix\n");
+fseek($fp, 13);
+var_dump($tail->pump(), $tail->getCount());
+echo implode(",", $tail->getLines()), "\n";
+
+var_dump($tail->render(), $tail->render());
+$win->refresh();
+foreach (ncurses_headless_screen() as $row) {
+	echo rtrim($row), "\n";
+}
+
+$tail->setFilter("error");
+var_dump($tail->append("ok\nerror: disk\nfine\nanother error\n"));
+echo implode(",", $tail->getLines()), "\n";
+
+$tail->clear();
+var_dump($tail->getCount(), $tail->render());
+
+try {
+	(new NcursesLogTail($win))->pump();
+} catch (Error $e) {
+	echo $e->getMessage(), "\n";
+}
+
+ncurses_end();
+?>
+--EXPECT--
+int(2)
+int(4)
+int(4)
+three,four,five,six
+bool(true)
+bool(false)
+four
+five
+six
+int(2)
+five,six,error: disk,another error
+int(0)
+bool(true)
+NcursesLogTail has no stream, use append() instead
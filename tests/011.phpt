@@ -0,0 +1,31 @@
+--TEST--
+ncurses_color_pair_for() hands out one pair per color combination
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(4, 20, "xterm");
+ncurses_start_color();
+
+$red = ncurses_color_pair_for(NCURSES_COLOR_RED, NCURSES_COLOR_BLACK);
+$blue = ncurses_color_pair_for(NCURSES_COLOR_BLUE, NCURSES_COLOR_BLACK);
+var_dump($red > 0, $blue > 0, $red != $blue);
+var_dump(ncurses_color_pair_for(NCURSES_COLOR_RED, NCURSES_COLOR_BLACK) === $red);
+
+/* a pair redefined by hand is no longer handed out for the old colors */
+ncurses_init_pair($red, NCURSES_COLOR_GREEN, NCURSES_COLOR_BLACK);
+var_dump(ncurses_color_pair_for(NCURSES_COLOR_RED, NCURSES_COLOR_BLACK) != $red);
+
+var_dump(ncurses_color_pair_for(1000, 0));
+
+ncurses_end();
+?>
+--EXPECTF--
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+
+Warning: ncurses_color_pair_for(): Colors must be between -1 and %d in %s on line %d
+bool(false)
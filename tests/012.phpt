@@ -0,0 +1,26 @@
+--TEST--
+ncurses_rgb_to_color() maps RGB values to the nearest of 256 colors
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(4, 20, "xterm-256color");
+ncurses_start_color();
+
+var_dump(ncurses_rgb_to_color(0xff0000));
+var_dump(ncurses_rgb_to_color(array("black" => 0x000000, "white" => 0xffffff, 7 => 0x0000ff, 0x123456)));
+
+ncurses_end();
+?>
+--EXPECT--
+int(196)
+array(4) {
+  ["black"]=>
+  int(16)
+  ["white"]=>
+  int(231)
+  [7]=>
+  int(21)
+  [8]=>
+  int(236)
+}
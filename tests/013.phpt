@@ -0,0 +1,41 @@
+--TEST--
+ncurses_wdirty_lines() reports the lines changed since the last refresh
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(6, 20);
+$win = ncurses_newwin(5, 10, 0, 0);
+ncurses_wrefresh($win);
+var_dump(ncurses_is_wintouched($win), ncurses_wdirty_lines($win));
+
+ncurses_mvwaddstr($win, 1, 0, "one");
+ncurses_mvwaddstr($win, 3, 0, "three");
+ncurses_mvwaddstr($win, 4, 0, "four");
+var_dump(ncurses_is_wintouched($win), ncurses_is_linetouched($win, 0), ncurses_is_linetouched($win, 1));
+echo json_encode(ncurses_wdirty_lines($win)), "\n";
+
+ncurses_wtouchln($win, 3, 2, 0);
+echo json_encode(ncurses_wdirty_lines($win)), "\n";
+
+ncurses_untouchwin($win);
+ncurses_touchwin($win);
+echo json_encode(ncurses_wdirty_lines($win)), "\n";
+
+var_dump(ncurses_is_linetouched($win, 5));
+
+ncurses_end();
+?>
+--EXPECTF--
+bool(false)
+array(0) {
+}
+bool(true)
+bool(false)
+bool(true)
+[[1,1],[3,4]]
+[[1,1]]
+[[0,4]]
+
+Warning: ncurses_is_linetouched(): Line 5 is outside of the window in %s on line %d
+bool(false)
@@ -0,0 +1,50 @@
+--TEST--
+NcursesScene writes only the cells that changed since the previous frame
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !class_exists("NcursesScene") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(5, 20);
+$win = new NcursesWindow(5, 20, 0, 0);
+$scene = new NcursesScene($win);
+
+function frame($cpu) {
+	return array(
+		array("type" => "box", "height" => 4, "width" => 20, "title" => "load", "children" => array(
+			array("y" => 0, "x" => 0, "text" => "cpu $cpu%"),
+			array("y" => 1, "x" => 10, "text" => "clipped at the border"),
+		)),
+		array("type" => "fill", "y" => 4, "height" => 1, "ch" => "="),
+	);
+}
+
+var_dump($scene->render(frame(10)));
+var_dump($scene->render(frame(10)));
+var_dump($scene->render(frame(11)));
+$win->refresh();
+foreach (ncurses_headless_screen() as $row) {
+	echo rtrim($row), "\n";
+}
+
+$scene->invalidate();
+var_dump($scene->render(frame(11)));
+
+try {
+	$scene->render(array(array("type" => "circle")));
+} catch (ValueError $e) {
+	echo $e->getMessage(), "\n";
+}
+
+ncurses_end();
+?>
+--EXPECT--
+int(100)
+int(0)
+int(1)
+┌─load─────────────┐
+│cpu 11%           │
+│          clipped │
+└──────────────────┘
+====================
+int(100)
+Unknown frame node type "circle"
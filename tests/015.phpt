@@ -0,0 +1,43 @@
+--TEST--
+ncurses_panels_apply() reorders and moves panels in one call
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_panels_apply") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(5, 10);
+$w1 = ncurses_newwin(2, 6, 0, 0);
+ncurses_mvwaddstr($w1, 0, 0, "AAAAA");
+ncurses_mvwaddstr($w1, 1, 0, "AAAAA");
+$w2 = ncurses_newwin(2, 6, 1, 2);
+ncurses_mvwaddstr($w2, 0, 0, "BBBBB");
+ncurses_mvwaddstr($w2, 1, 0, "BBBBB");
+$p1 = ncurses_new_panel($w1);
+$p2 = ncurses_new_panel($w2);
+
+var_dump(ncurses_panels_apply(array(
+	array("top", $p1),
+	array("move", $p2, 3, 0),
+	array("show", $p2),
+), true));
+foreach (ncurses_headless_screen() as $row) {
+	echo rtrim($row), "\n";
+}
+
+var_dump(ncurses_panels_apply(array(array("hide", $p1), array("spin", $p2))));
+var_dump(ncurses_panels_apply(array(array("move", $p2, 0))));
+
+ncurses_end();
+?>
+--EXPECTF--
+int(3)
+AAAAA
+AAAAA
+
+BBBBB
+BBBBB
+
+Warning: ncurses_panels_apply(): Operation 1 has an unknown name 'spin' in %s on line %d
+bool(false)
+
+Warning: ncurses_panels_apply(): Operation 0 needs a line and a column to move to in %s on line %d
+bool(false)
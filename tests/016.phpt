@@ -0,0 +1,54 @@
+--TEST--
+Panels and windows map to each other and ncurses_panel_stack() lists the z-order
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_panel_stack") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(5, 10);
+$w1 = ncurses_newwin(2, 4, 0, 0);
+$w2 = ncurses_newwin(2, 4, 1, 1);
+$w3 = ncurses_newwin(2, 4, 2, 2);
+$p1 = ncurses_new_panel($w1);
+$p2 = ncurses_new_panel($w2);
+
+var_dump(ncurses_window_panel($w1) === $p1, ncurses_panel_window($p1) === $w1);
+var_dump(ncurses_panel_window($p2) === ncurses_panel_window($p2));
+var_dump(ncurses_window_panel($w3));
+
+ncurses_hide_panel($p1);
+var_dump(ncurses_panel_stack() === array($p2));
+ncurses_show_panel($p1);
+var_dump(ncurses_panel_stack() === array($p2, $p1));
+
+ncurses_replace_panel($p2, $w3);
+var_dump(ncurses_window_panel($w2), ncurses_window_panel($w3) === $p2);
+
+/* deleting the window takes its panel off the stack first */
+ncurses_delwin($w3);
+var_dump(ncurses_panel_stack() === array($p1));
+
+/* a replace through ncurses_panels_apply() moves the mapping as well, and
+   the panel keeps the new window alive */
+$w4 = ncurses_newwin(2, 4, 3, 3);
+var_dump(ncurses_panels_apply(array(array("replace", $p1, $w4))));
+var_dump(ncurses_window_panel($w1), ncurses_window_panel($w4) === $p1);
+unset($w4);
+var_dump(ncurses_panel_window($p1) !== false, ncurses_update_panels());
+
+ncurses_end();
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
+bool(false)
+bool(true)
+bool(true)
+bool(false)
+bool(true)
+bool(true)
+int(1)
+bool(false)
+bool(true)
+bool(true)
+NULL
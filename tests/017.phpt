@@ -0,0 +1,54 @@
+--TEST--
+ncurses_newterm() drives a second terminal next to the main screen
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_newterm") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(3, 20);
+
+$out = tmpfile();
+$in = tmpfile();
+$screen = ncurses_newterm("xterm", $out, $in);
+var_dump($screen instanceof NcursesScreen);
+
+ncurses_mvaddstr(0, 0, "second terminal");
+ncurses_refresh();
+
+var_dump(ncurses_set_term(null));
+ncurses_mvaddstr(0, 0, "main terminal");
+ncurses_refresh();
+$rows = ncurses_headless_screen();
+var_dump(rtrim($rows[0]));
+
+fseek($out, 0);
+var_dump(strpos(stream_get_contents($out), "second terminal") !== false);
+
+/* windows are made on the current screen */
+var_dump(ncurses_set_term($screen));
+$win = ncurses_newwin(1, 10, 1, 0);
+ncurses_waddstr($win, "on second");
+ncurses_wrefresh($win);
+fseek($out, 0);
+var_dump(strpos(stream_get_contents($out), "on second") !== false);
+var_dump($screen->window() instanceof NcursesWindow);
+
+/* the screen lives on as long as its windows do */
+unset($screen);
+var_dump(ncurses_set_term(null));
+ncurses_delwin($win);
+unset($win);
+$rows = ncurses_headless_screen();
+var_dump(rtrim($rows[0]));
+
+ncurses_end();
+?>
+--EXPECT--
+bool(true)
+bool(true)
+string(13) "main terminal"
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+string(13) "main terminal"
@@ -0,0 +1,51 @@
+--TEST--
+ncurses_getch_async() waits through the input waiter or by suspending the Fiber
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_getch_async") || !function_exists("ncurses_headless_init") || !class_exists("Fiber")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(5, 20);
+
+/* pending input is returned right away */
+ncurses_ungetch(ord("a"));
+var_dump(ncurses_getch_async() === ord("a"));
+
+/* without a waiter the Fiber is suspended with the input stream */
+$fiber = new Fiber(function () {
+	return ncurses_getch_async();
+});
+$stream = $fiber->start();
+var_dump(is_resource($stream), $fiber->isSuspended());
+ncurses_ungetch(ord("b"));
+$fiber->resume();
+var_dump($fiber->getReturn() === ord("b"));
+
+/* a waiter is called until a key arrives */
+$calls = 0;
+ncurses_set_input_waiter(function ($input) use (&$calls) {
+	if (++$calls == 2) {
+		ncurses_ungetch(ord("c"));
+	}
+});
+var_dump(ncurses_getch_async() === ord("c"), $calls);
+
+ncurses_set_input_waiter(function ($input) {
+	throw new RuntimeException("cancelled");
+});
+try {
+	ncurses_getch_async();
+} catch (RuntimeException $e) {
+	echo $e->getMessage(), "\n";
+}
+
+ncurses_set_input_waiter(null);
+ncurses_end();
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+int(2)
+cancelled
@@ -0,0 +1,53 @@
+--TEST--
+ncurses_record_start() writes an asciicast that ncurses_replay() plays back
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_record_start") || !function_exists("ncurses_headless_init") || !function_exists("json_decode")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(3, 20);
+
+$cast = fopen("php://memory", "w+");
+var_dump(ncurses_record_start($cast, "demo"));
+ncurses_mvaddstr(1, 2, "recorded \"text\"");
+ncurses_refresh();
+var_dump(ncurses_record_stop());
+
+/* the terminal still gets everything */
+$rows = ncurses_headless_screen();
+var_dump(rtrim($rows[1]));
+
+rewind($cast);
+$lines = explode("\n", trim(stream_get_contents($cast)));
+$header = json_decode($lines[0], true);
+var_dump($header["version"], $header["width"], $header["height"], $header["title"]);
+$event = json_decode($lines[1], true);
+var_dump(count($lines), $event[1], strpos($event[2], "recorded \"text\"") !== false);
+
+ncurses_clear();
+ncurses_refresh();
+$rows = ncurses_headless_screen();
+var_dump(trim($rows[1]));
+
+rewind($cast);
+$stats = ncurses_replay($cast);
+var_dump($stats["events"], $stats["bytes"] == strlen($event[2]));
+$rows = ncurses_headless_screen();
+var_dump(rtrim($rows[1]));
+
+ncurses_end();
+?>
+--EXPECT--
+bool(true)
+bool(true)
+string(17) "  recorded "text""
+int(2)
+int(20)
+int(3)
+string(4) "demo"
+int(2)
+string(1) "o"
+bool(true)
+string(0) ""
+int(1)
+bool(true)
+string(17) "  recorded "text""
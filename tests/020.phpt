@@ -0,0 +1,39 @@
+--TEST--
+ncurses_inject() queues scripted keys for the following reads
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_inject") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(5, 20);
+
+/* keys come back in script order, strings as their bytes */
+var_dump(ncurses_inject(array(ord("a"), "bc", array("key" => NCURSES_KEY_F1))));
+var_dump(ncurses_drain_keys() === array(ord("a"), ord("b"), ord("c"), NCURSES_KEY_F1));
+var_dump(ncurses_inject(array()));
+
+/* paced events are only read once they are due */
+ncurses_inject(array(ord("x"), ord("y")), 50);
+var_dump(ncurses_drain_keys());
+$start = microtime(true);
+var_dump(ncurses_getch() === ord("x"), ncurses_getch() === ord("y"));
+var_dump(microtime(true) - $start >= 0.09);
+
+/* a broken script is rejected as a whole */
+var_dump(ncurses_inject(array(ord("z"), 1.5)));
+var_dump(ncurses_inject(array()));
+
+ncurses_end();
+?>
+--EXPECTF--
+int(4)
+bool(true)
+int(0)
+array(0) {
+}
+bool(true)
+bool(true)
+bool(true)
+
+Warning: ncurses_inject(): Events must be key codes, strings or arrays, float given in %s on line %d
+bool(false)
+int(0)
@@ -0,0 +1,41 @@
+--TEST--
+ncurses_getmouse() fills an NcursesMouseEvent and decodes SGR reports
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !class_exists("NcursesMouseEvent") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(5, 20);
+var_dump(ncurses_mouse_sgr());
+
+/* a press beyond column 223 and its release */
+ncurses_inject(array("\033[<0;300;5M", "\033[<0;300;5m"));
+$event = new NcursesMouseEvent();
+
+var_dump(ncurses_getch() === NCURSES_KEY_MOUSE);
+var_dump(ncurses_getmouse($event));
+var_dump($event->x, $event->y, $event->mmask === NCURSES_BUTTON1_PRESSED);
+
+$same = $event;
+var_dump(ncurses_getch() === NCURSES_KEY_MOUSE, ncurses_getmouse($event));
+var_dump($same === $event, $event->mmask === NCURSES_BUTTON1_RELEASED);
+
+/* anything else after ESC is passed on */
+ncurses_inject(array("\033[x"));
+var_dump(ncurses_drain_keys() === array(27, ord("["), ord("x")));
+
+var_dump(ncurses_mouse_sgr(false));
+ncurses_end();
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
+int(299)
+int(4)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
@@ -0,0 +1,36 @@
+--TEST--
+ncurses.terminfo_cache keeps the terminal description and the ACS table
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_headless_init") || PHP_OS_FAMILY == "Windows") print "skip"; ?>
+--INI--
+ncurses.terminfo_cache={PWD}/022.cache
+--FILE--
+<?php
+$cache = __DIR__ . "/022.cache";
+
+var_dump(ncurses_headless_init(5, 20, "xterm"));
+var_dump(is_file("$cache/x/xterm") || is_file("$cache/78/xterm"));
+var_dump(filesize("$cache/xterm.acs") > 0);
+ncurses_end();
+
+/* the second start reads the copy */
+var_dump(ncurses_headless_init(5, 20, "xterm"));
+var_dump(ncurses_border(0, 0, 0, 0, 0, 0, 0, 0));
+ncurses_end();
+?>
+--CLEAN--
+<?php
+$cache = __DIR__ . "/022.cache";
+foreach (array("x", "78") as $sub) {
+	@unlink("$cache/$sub/xterm");
+	@rmdir("$cache/$sub");
+}
+@unlink("$cache/xterm.acs");
+@rmdir($cache);
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+int(0)
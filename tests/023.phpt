@@ -0,0 +1,39 @@
+--TEST--
+ncurses_headless_init() again deletes the windows of the previous terminal
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+var_dump(ncurses_headless_init(5, 20));
+$w = ncurses_newwin(2, 5, 1, 1);
+ncurses_end();
+
+var_dump(ncurses_headless_init(3, 1));
+try {
+	$r = @ncurses_wrefresh($w);
+} catch (Error $e) {
+	$r = false;
+}
+var_dump($r);
+unset($w);
+
+/* a wide character does not fit into one column */
+ncurses_mvaddstr(0, 0, "漢");
+ncurses_refresh(0);
+var_dump(count(ncurses_headless_screen()));
+ncurses_end();
+
+var_dump(ncurses_headless_init(2, 10));
+ncurses_waddstr(STDSCR, "again");
+ncurses_wrefresh(STDSCR);
+$rows = ncurses_headless_screen();
+echo rtrim($rows[0]), "\n";
+ncurses_end();
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(false)
+int(3)
+bool(true)
+again
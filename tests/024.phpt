@@ -0,0 +1,34 @@
+--TEST--
+ncurses_color_pair_for() keeps to pairs a chtype can hold on 256 color terminals
+--SKIPIF--
+<?php
+if (!extension_loaded("ncurses") || !function_exists("ncurses_headless_init")) print "skip";
+else if (!@ncurses_headless_init(4, 20, "xterm-256color")) print "skip xterm-256color is not available";
+?>
+--FILE--
+<?php
+ncurses_headless_init(4, 20, "xterm-256color");
+ncurses_start_color();
+
+/* pairs defined by hand, before and after the allocator handed them out */
+ncurses_init_pair(254, NCURSES_COLOR_RED, NCURSES_COLOR_BLUE);
+$mine = ncurses_color_pair_for(7, 0);
+ncurses_init_pair($mine, NCURSES_COLOR_GREEN, NCURSES_COLOR_BLACK);
+
+$seen = array();
+for ($fg = 0; $fg < 20; $fg++) {
+	for ($bg = 0; $bg < 20; $bg++) {
+		$seen[ncurses_color_pair_for($fg, $bg)] = true;
+	}
+}
+var_dump(max(array_keys($seen)) <= 255, min(array_keys($seen)) >= 1);
+var_dump(isset($seen[254]), isset($seen[$mine]), count($seen));
+
+ncurses_end();
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(false)
+bool(false)
+int(253)
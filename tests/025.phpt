@@ -0,0 +1,66 @@
+--TEST--
+ncurses_frame_end() sends the frame once, paced by ncurses_set_max_fps()
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+function row0() {
+	$rows = ncurses_headless_screen();
+	return rtrim($rows[0]);
+}
+
+ncurses_headless_init(3, 20);
+
+ncurses_frame_begin();
+var_dump(ncurses_frame_end());
+
+ncurses_frame_begin();
+ncurses_addstr("frame");
+ncurses_wnoutrefresh(STDSCR);
+var_dump(row0());
+var_dump(ncurses_frame_end());
+var_dump(row0());
+
+/* ten frames a second: a frame that comes too early is kept with false */
+var_dump(ncurses_set_max_fps(10));
+ncurses_frame_begin();
+ncurses_addstr("-1");
+ncurses_refresh(0);
+var_dump(ncurses_frame_end());
+
+ncurses_frame_begin();
+ncurses_addstr("-2");
+ncurses_refresh(0);
+var_dump(ncurses_frame_end(false), row0());
+
+/* and sent with the next frame once its slot has come */
+usleep(120000);
+ncurses_frame_begin();
+var_dump(ncurses_frame_end(false), row0());
+
+/* without false the frame waits for its slot */
+ncurses_frame_begin();
+ncurses_addstr("-3");
+ncurses_refresh(0);
+$start = microtime(true);
+var_dump(ncurses_frame_end(), row0());
+var_dump(microtime(true) - $start >= 0.08);
+
+var_dump(ncurses_set_max_fps(0));
+ncurses_end();
+?>
+--EXPECT--
+bool(false)
+string(0) ""
+bool(true)
+string(5) "frame"
+int(0)
+bool(true)
+bool(false)
+string(7) "frame-1"
+bool(true)
+string(9) "frame-1-2"
+bool(true)
+string(11) "frame-1-2-3"
+bool(true)
+int(10)
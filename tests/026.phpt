@@ -0,0 +1,77 @@
+--TEST--
+ncurses_init(true) registers the constants from the terminfo cache and starts curses on first use
+--SKIPIF--
+<?php
+if (!extension_loaded("ncurses") || !function_exists("ncurses_headless_init")) print "skip";
+else if (!getenv("TEST_PHP_EXECUTABLE")) print "skip TEST_PHP_EXECUTABLE is not set";
+?>
+--FILE--
+<?php
+$dir = sys_get_temp_dir() . "/ncurses-026";
+ini_set("ncurses.terminfo_cache", $dir);
+
+/* a headless start fills the cache without touching the terminal */
+ncurses_headless_init(5, 20, "xterm");
+$hline = NCURSES_ACS_HLINE;
+ncurses_end();
+var_dump(is_file("$dir/xterm.acs"), is_file("$dir/xterm.src"));
+
+/* an ACS table for a terminal curses cannot open */
+copy("$dir/xterm.acs", "$dir/nosuchterm.acs");
+
+function run_child($term, $code) {
+	global $dir;
+
+	putenv("TERM=$term");
+	$cmd = escapeshellarg(getenv("TEST_PHP_EXECUTABLE")) . " " . getenv("TEST_PHP_EXTRA_ARGS")
+		. " -d display_errors=1 -d error_reporting=-1 -d html_errors=0"
+		. " -d ncurses.terminfo_cache=" . escapeshellarg($dir)
+		. " -r " . escapeshellarg($code) . " 2>&1 </dev/null";
+	echo shell_exec($cmd);
+}
+
+echo "xterm\n";
+run_child("xterm", '
+ncurses_init(true);
+var_dump(NCURSES_ACS_HLINE === ' . $hline . ', defined("STDSCR"));
+var_dump(ncurses_end());
+');
+
+echo "nosuchterm\n";
+run_child("nosuchterm", '
+ncurses_init(true);
+var_dump(defined("NCURSES_ACS_HLINE"));
+var_dump(ncurses_getch());
+var_dump(ncurses_getch());
+var_dump(ncurses_init());
+');
+?>
+--CLEAN--
+<?php
+$dir = sys_get_temp_dir() . "/ncurses-026";
+foreach (glob("$dir/*/*") ?: array() as $file) {
+	unlink($file);
+}
+foreach (glob("$dir/*") ?: array() as $file) {
+	is_dir($file) ? rmdir($file) : unlink($file);
+}
+@rmdir($dir);
+?>
+--EXPECTF--
+bool(true)
+bool(true)
+xterm
+bool(true)
+bool(true)
+int(0)
+nosuchterm
+bool(true)
+
+Warning: ncurses_getch(): Error opening terminal: nosuchterm in %s on line %d
+bool(false)
+
+Warning: ncurses_getch(): Error opening terminal: nosuchterm in %s on line %d
+bool(false)
+
+Warning: ncurses_init(): Error opening terminal: nosuchterm in %s on line %d
+bool(false)
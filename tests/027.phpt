@@ -0,0 +1,29 @@
+--TEST--
+NcursesCellBuffer takes ints as chtypes and strings as characters
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !class_exists("NcursesCellBuffer")) print "skip"; ?>
+--FILE--
+<?php
+$buf = new NcursesCellBuffer(1, 4);
+
+/* the attributes and the pair of a chtype are kept apart from the character */
+$buf->set(0, 0, ord("a") | NCURSES_A_UNDERLINE);
+var_dump($buf->get(0, 0) == array("ch" => ord("a"), "attr" => NCURSES_A_UNDERLINE, "pair" => 0));
+
+$buf->set(0, 1, ord("b") | NCURSES_A_REVERSE, NCURSES_A_BOLD);
+var_dump($buf->get(0, 1) == array("ch" => ord("b"), "attr" => NCURSES_A_REVERSE | NCURSES_A_BOLD, "pair" => 0));
+
+/* COLOR_PAIR(1) */
+var_dump($buf->fill(0, 2, 1, ord("c") | (1 << 8)));
+var_dump($buf->get(0, 2) == array("ch" => ord("c"), "attr" => 0, "pair" => 1));
+
+/* a code point only comes from a string */
+$buf->set(0, 3, "\xe2\x94\x80");
+var_dump($buf->get(0, 3)["ch"] == 0x2500);
+?>
+--EXPECT--
+bool(true)
+bool(true)
+int(1)
+bool(true)
+bool(true)
@@ -0,0 +1,43 @@
+--TEST--
+ncurses_wgetch_batch() waits for the first key and returns what is pending with it
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_inject") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(5, 20);
+ncurses_mouse_sgr();
+
+var_dump(ncurses_wgetch_batch(STDSCR, 0, 30));
+
+/* keys as ints, the mouse event as the array of ncurses_getmouse() */
+ncurses_inject(array("ab", "\033[<0;3;2M", ord("c")));
+$keys = ncurses_wgetch_batch(STDSCR, 0, 100);
+var_dump(count($keys), $keys[0] === ord("a"), $keys[1] === ord("b"), $keys[3] === ord("c"));
+var_dump($keys[2]["x"], $keys[2]["y"], $keys[2]["mmask"] === NCURSES_BUTTON1_PRESSED);
+
+/* max stops early, the rest stays pending */
+ncurses_inject(array("wxyz"));
+var_dump(ncurses_wgetch_batch(STDSCR, 2) === array(ord("w"), ord("x")));
+var_dump(ncurses_drain_keys() === array(ord("y"), ord("z")));
+
+/* only the first key is waited for, the batch ends with what is due then */
+ncurses_inject(array(ord("p"), ord("q")), 40);
+var_dump(ncurses_wgetch_batch(STDSCR, 0, 1000) === array(ord("p")));
+var_dump(ncurses_wgetch_batch(STDSCR, 0, -1) === array(ord("q")));
+
+ncurses_end();
+?>
+--EXPECT--
+array(0) {
+}
+int(4)
+bool(true)
+bool(true)
+bool(true)
+int(2)
+int(1)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
@@ -0,0 +1,35 @@
+--TEST--
+ncurses_input_stream() can be selected and closed without harm to the terminal
+--SKIPIF--
+<?php if (!extension_loaded("ncurses") || !function_exists("ncurses_inject") || !function_exists("ncurses_headless_init")) print "skip"; ?>
+--FILE--
+<?php
+ncurses_headless_init(5, 20);
+
+$in = ncurses_input_stream();
+var_dump(is_resource($in));
+
+$read = array($in);
+$write = $except = null;
+var_dump(stream_select($read, $write, $except, 0, 100000));
+var_dump($read === array($in));
+
+/* the stream has a descriptor of its own */
+fclose($in);
+ncurses_inject(array("ok"));
+var_dump(ncurses_getch() === ord("o"));
+var_dump(ncurses_drain_keys() === array(ord("k")));
+
+$in = ncurses_input_stream();
+var_dump(is_resource($in));
+fclose($in);
+
+ncurses_end();
+?>
+--EXPECT--
+bool(true)
+int(1)
+bool(true)
+bool(true)
+bool(true)
+bool(true)